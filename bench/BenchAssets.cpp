@@ -0,0 +1,125 @@
+#include "BenchHarness.h"
+
+#include "ecs/Scene.h"
+#include "resource/ResourceManager.h"
+#include "scene/CityGenerator.h"
+#include "scene/SceneLoader.h"
+
+#include <bgfx/bgfx.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr const char* kBenchMesh = "models/demo.obj";
+    constexpr const char* kPropMesh = "models/plane.obj";
+
+    void RunObjLoad(Bench::Harness& harness, resource::ResourceManager& resources, const char* mesh)
+    {
+        const std::string name = std::string("asset/obj_load/") + std::filesystem::path(mesh).stem().string();
+        if (!harness.ShouldRun(name))
+        {
+            return;
+        }
+
+        // Reload() vuelve a parsear + cocinar el OBJ (incluidos los buffers de
+        // bgfx) y lo cambia en su slot. bgfx::frame() libera los handles
+        // destruidos para que no se acumulen entre iteraciones.
+        Bench::Result* result = harness.Run(name,
+                                            {{"path", mesh}},
+                                            10,
+                                            []() { bgfx::frame(); },
+                                            [&]() { resources.Reload(mesh); });
+        if (result)
+        {
+            if (const resource::MeshEntry* entry = resources.GetMeshEntry(resources.LoadMesh(mesh)); entry && entry->mesh)
+            {
+                result->counters["vertices"] = entry->mesh->vertexCount;
+                result->counters["indices"] = entry->mesh->indexCount;
+                result->counters["approxBytes"] = entry->approxBytes;
+            }
+        }
+        bgfx::frame();
+    }
+
+    void RunSceneLoad(Bench::Harness& harness, resource::ResourceManager& resources, int entityCount, uint32_t seed)
+    {
+        const std::string name = "scene/load_json/" + std::to_string(entityCount);
+        if (!harness.ShouldRun(name))
+        {
+            return;
+        }
+
+        std::error_code ec;
+        const std::filesystem::path path = std::filesystem::temp_directory_path(ec) /
+                                           ("sandboxcity_bench_" + std::to_string(entityCount) + ".json");
+        CityGeneratorSettings settings;
+        settings.targetEntities = static_cast<size_t>(entityCount);
+        settings.seed = seed;
+        CityGeneratorStats city;
+        std::string genErr;
+        if (!GenerateCityScene(path.string(), settings, &city, &genErr))
+        {
+            std::printf("[Bench] GenerateCityScene: %s\n", genErr.c_str());
+            return;
+        }
+
+        // Las mallas compartidas quedan en caché tras el calentamiento, así que
+        // se mide parseo del JSON + creación de entidades/componentes.
+        std::unique_ptr<Scene> scene;
+        size_t loaded = 0;
+        Bench::Result* result = harness.Run(name,
+                                            {{"entities", city.entities}, {"blocks", city.blocks}, {"fileBytes", city.fileBytes}},
+                                            entityCount >= 100000 ? 3 : 10,
+                                            [&]() { scene = std::make_unique<Scene>(); },
+                                            [&]()
+                                            {
+                                                std::string err;
+                                                if (!LoadSceneFromJson(path.string(), *scene, resources, &err))
+                                                {
+                                                    std::printf("[Bench] LoadSceneFromJson: %s\n", err.c_str());
+                                                }
+                                                loaded = scene->GetEntityCount();
+                                            });
+        if (result)
+        {
+            result->counters["loadedEntities"] = loaded;
+        }
+        scene.reset();
+        std::filesystem::remove(path, ec);
+    }
+}
+
+namespace Bench
+{
+    void RunAssetBenchmarks(Harness& harness)
+    {
+        const bool quick = harness.GetOptions().quick;
+        const uint32_t seed = harness.GetOptions().seed;
+
+        resource::ResourceManager resources;
+        if (!resources.Initialize())
+        {
+            std::printf("[Bench] ResourceManager::Initialize falló, se omiten los benchmarks de assets\n");
+            return;
+        }
+
+        RunObjLoad(harness, resources, kPropMesh);
+        RunObjLoad(harness, resources, kBenchMesh);
+
+        const std::vector<int> sceneCounts = quick ? std::vector<int>{1000, 10000}
+                                                   : std::vector<int>{1000, 10000, 100000};
+        for (int count : sceneCounts)
+        {
+            RunSceneLoad(harness, resources, count, seed);
+        }
+
+        resources.Shutdown();
+        bgfx::frame();
+    }
+}
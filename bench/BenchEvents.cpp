@@ -0,0 +1,178 @@
+#include "BenchHarness.h"
+
+#include "core/EventBus.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    // Copia del EventBus anterior (std::function + type_index en un mapa) como
+    // referencia para comparar.
+    class LegacyEventBus
+    {
+    public:
+        template<typename Event>
+        void Subscribe(std::function<void(const Event&)> callback)
+        {
+            auto& list = GetOrCreateList<Event>();
+            list.callbacks.push_back(std::move(callback));
+        }
+
+        template<typename Event>
+        void Publish(const Event& event)
+        {
+            auto it = m_subscribers.find(std::type_index(typeid(Event)));
+            if (it == m_subscribers.end())
+            {
+                return;
+            }
+            auto* basePtr = static_cast<HandlerList<Event>*>(it->second.get());
+            for (auto& cb : basePtr->callbacks)
+            {
+                cb(event);
+            }
+        }
+
+    private:
+        struct HandlerListBase
+        {
+            virtual ~HandlerListBase() = default;
+        };
+
+        template<typename Event>
+        struct HandlerList : HandlerListBase
+        {
+            std::vector<std::function<void(const Event&)>> callbacks;
+        };
+
+        template<typename Event>
+        HandlerList<Event>& GetOrCreateList()
+        {
+            const std::type_index typeIdx(typeid(Event));
+            auto it = m_subscribers.find(typeIdx);
+            if (it == m_subscribers.end())
+            {
+                auto list = std::make_unique<HandlerList<Event>>();
+                auto* ptr = list.get();
+                m_subscribers.emplace(typeIdx, std::move(list));
+                return *ptr;
+            }
+            return *static_cast<HandlerList<Event>*>(it->second.get());
+        }
+
+        std::unordered_map<std::type_index, std::unique_ptr<HandlerListBase>> m_subscribers;
+    };
+
+    // Tamaño parecido a un evento de contacto de físicas
+    struct BenchEvent
+    {
+        uint32_t a = 0;
+        uint32_t b = 0;
+        float    point[3]{};
+        float    impulse = 0.0f;
+    };
+
+    // Tipos de relleno para que el mapa del bus antiguo no tenga una sola entrada
+    template<int N>
+    struct OtherEvent
+    {
+        int value = N;
+    };
+
+    template<typename Bus>
+    void SubscribeFillers(Bus& bus, uint64_t& sink)
+    {
+        bus.template Subscribe<OtherEvent<0>>([&sink](const OtherEvent<0>& e) { sink += e.value; });
+        bus.template Subscribe<OtherEvent<1>>([&sink](const OtherEvent<1>& e) { sink += e.value; });
+        bus.template Subscribe<OtherEvent<2>>([&sink](const OtherEvent<2>& e) { sink += e.value; });
+        bus.template Subscribe<OtherEvent<3>>([&sink](const OtherEvent<3>& e) { sink += e.value; });
+    }
+
+    enum class BusMode
+    {
+        Legacy,
+        Publish,
+        Queued,
+    };
+
+    const char* ModeName(BusMode mode)
+    {
+        switch (mode)
+        {
+        case BusMode::Legacy:  return "legacy";
+        case BusMode::Publish: return "publish";
+        case BusMode::Queued:  return "queued";
+        }
+        return "?";
+    }
+
+    void RunThroughput(Bench::Harness& harness, BusMode mode, int subscribers, int events)
+    {
+        const std::string name = std::string("events/") + ModeName(mode) + "/" + std::to_string(subscribers) + "x" + std::to_string(events);
+        if (!harness.ShouldRun(name))
+        {
+            return;
+        }
+
+        uint64_t sink = 0;
+        LegacyEventBus legacy;
+        EventBus bus;
+        SubscribeFillers(legacy, sink);
+        SubscribeFillers(bus, sink);
+        for (int i = 0; i < subscribers; ++i)
+        {
+            auto handler = [&sink](const BenchEvent& e) { sink += e.a ^ e.b; };
+            legacy.Subscribe<BenchEvent>(handler);
+            bus.Subscribe<BenchEvent>(handler);
+        }
+
+        Bench::Result* result = harness.Run(name, {{"mode", ModeName(mode)}, {"subscribers", subscribers}, {"events", events}}, 20, nullptr, [&]()
+        {
+            BenchEvent evt;
+            for (int i = 0; i < events; ++i)
+            {
+                evt.a = static_cast<uint32_t>(i);
+                evt.b = static_cast<uint32_t>(i * 7);
+                switch (mode)
+                {
+                case BusMode::Legacy:  legacy.Publish(evt); break;
+                case BusMode::Publish: bus.Publish(evt); break;
+                case BusMode::Queued:  bus.Enqueue(evt); break;
+                }
+            }
+            if (mode == BusMode::Queued)
+            {
+                bus.DispatchQueued();
+            }
+        });
+
+        if (result)
+        {
+            const double eventsPerMs = result->stats.meanMs > 0.0 ? events / result->stats.meanMs : 0.0;
+            result->counters["eventsPerSecond"] = eventsPerMs * 1000.0;
+            result->counters["nsPerEvent"] = eventsPerMs > 0.0 ? 1.0e6 / eventsPerMs : 0.0;
+            result->counters["sink"] = sink;
+        }
+    }
+}
+
+namespace Bench
+{
+    void RunEventBenchmarks(Harness& harness)
+    {
+        const int events = harness.GetOptions().quick ? 100000 : 1000000;
+        for (int subscribers : {1, 8})
+        {
+            for (BusMode mode : {BusMode::Legacy, BusMode::Publish, BusMode::Queued})
+            {
+                RunThroughput(harness, mode, subscribers, events);
+            }
+        }
+    }
+}
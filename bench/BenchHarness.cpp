@@ -0,0 +1,200 @@
+#include "BenchHarness.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <thread>
+
+namespace
+{
+    double Percentile(const std::vector<double>& sorted, double p)
+    {
+        if (sorted.empty())
+        {
+            return 0.0;
+        }
+        const size_t index = std::min(sorted.size() - 1,
+                                      static_cast<size_t>(std::ceil(p * static_cast<double>(sorted.size()))) - 1);
+        return sorted[index];
+    }
+
+    const char* BuildConfigName()
+    {
+#if defined(NDEBUG)
+        return "release";
+#else
+        return "debug";
+#endif
+    }
+
+    const char* CompilerName()
+    {
+#if defined(_MSC_VER)
+        return "msvc";
+#elif defined(__clang__)
+        return "clang";
+#elif defined(__GNUC__)
+        return "gcc";
+#else
+        return "unknown";
+#endif
+    }
+}
+
+namespace Bench
+{
+    Harness::Harness(Options options)
+        : m_options(std::move(options))
+    {
+    }
+
+    bool Harness::ShouldRun(const std::string& name) const
+    {
+        return m_options.filter.empty() || name.find(m_options.filter) != std::string::npos;
+    }
+
+    int Harness::Iterations(int requested) const
+    {
+        return std::max(1, m_options.iterations > 0 ? m_options.iterations : requested);
+    }
+
+    Result* Harness::Run(const std::string& name,
+                         nlohmann::json params,
+                         int iterations,
+                         const std::function<void()>& setup,
+                         const std::function<void()>& body)
+    {
+        if (!ShouldRun(name))
+        {
+            return nullptr;
+        }
+
+        const int count = Iterations(iterations);
+        std::printf("[Bench] %s %s x%d\n", name.c_str(), params.dump().c_str(), count);
+
+        std::vector<double> samples;
+        samples.reserve(static_cast<size_t>(count));
+        for (int i = -1; i < count; ++i)
+        {
+            if (setup)
+            {
+                setup();
+            }
+            const auto start = std::chrono::steady_clock::now();
+            body();
+            const auto end = std::chrono::steady_clock::now();
+            if (i >= 0)
+            {
+                samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+            }
+        }
+        return Record(name, std::move(params), std::move(samples));
+    }
+
+    Result* Harness::Record(const std::string& name, nlohmann::json params, std::vector<double> samplesMs)
+    {
+        if (!ShouldRun(name))
+        {
+            return nullptr;
+        }
+
+        Result result;
+        result.name = name;
+        result.params = std::move(params);
+        result.stats = ComputeStats(samplesMs);
+        result.samplesMs = std::move(samplesMs);
+        m_results.push_back(std::move(result));
+        return &m_results.back();
+    }
+
+    Stats Harness::ComputeStats(std::vector<double> samplesMs)
+    {
+        Stats stats;
+        if (samplesMs.empty())
+        {
+            return stats;
+        }
+
+        std::sort(samplesMs.begin(), samplesMs.end());
+        double sum = 0.0;
+        for (double v : samplesMs)
+        {
+            sum += v;
+        }
+        stats.meanMs = sum / static_cast<double>(samplesMs.size());
+        stats.minMs = samplesMs.front();
+        stats.maxMs = samplesMs.back();
+        stats.p50Ms = Percentile(samplesMs, 0.50);
+        stats.p95Ms = Percentile(samplesMs, 0.95);
+
+        double variance = 0.0;
+        for (double v : samplesMs)
+        {
+            variance += (v - stats.meanMs) * (v - stats.meanMs);
+        }
+        stats.stddevMs = std::sqrt(variance / static_cast<double>(samplesMs.size()));
+        return stats;
+    }
+
+    bool Harness::WriteJson(const std::string& path) const
+    {
+        nlohmann::json root;
+        root["schema"] = 1;
+        root["timestamp"] = static_cast<int64_t>(std::time(nullptr));
+        root["build"] = BuildConfigName();
+        root["compiler"] = CompilerName();
+        root["hardwareThreads"] = std::thread::hardware_concurrency();
+        root["quick"] = m_options.quick;
+        root["seed"] = m_options.seed;
+
+        nlohmann::json results = nlohmann::json::array();
+        for (const Result& result : m_results)
+        {
+            nlohmann::json entry;
+            entry["name"] = result.name;
+            entry["params"] = result.params;
+            entry["iterations"] = result.samplesMs.size();
+            entry["meanMs"] = result.stats.meanMs;
+            entry["minMs"] = result.stats.minMs;
+            entry["maxMs"] = result.stats.maxMs;
+            entry["p50Ms"] = result.stats.p50Ms;
+            entry["p95Ms"] = result.stats.p95Ms;
+            entry["stddevMs"] = result.stats.stddevMs;
+            if (!result.counters.empty())
+            {
+                entry["counters"] = result.counters;
+            }
+            results.push_back(std::move(entry));
+        }
+        root["results"] = std::move(results);
+
+        std::ofstream file(path);
+        if (!file)
+        {
+            std::printf("[Bench] No se pudo escribir %s\n", path.c_str());
+            return false;
+        }
+        file << root.dump(2) << '\n';
+        std::printf("[Bench] Resultados en %s (%zu casos)\n", path.c_str(), m_results.size());
+        return true;
+    }
+
+    void Harness::PrintSummary() const
+    {
+        std::printf("[Bench] ===== Resumen =====\n");
+        for (const Result& result : m_results)
+        {
+            std::printf("[Bench] %-40s mean=%9.4fms p50=%9.4fms p95=%9.4fms min=%9.4fms max=%9.4fms n=%zu\n",
+                        result.name.c_str(),
+                        result.stats.meanMs,
+                        result.stats.p50Ms,
+                        result.stats.p95Ms,
+                        result.stats.minMs,
+                        result.stats.maxMs,
+                        result.samplesMs.size());
+        }
+    }
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Arnés mínimo de SandboxCityBench: ejecuta casos con calentamiento, guarda
+// las muestras por iteración y vuelca todo a un JSON comparable entre builds.
+namespace Bench
+{
+    struct Options
+    {
+        std::string outPath = "bench_results.json";
+        std::string filter;         // subcadena del nombre "suite/caso"
+        bool        quick = false;  // tamaños reducidos para CI
+        int         iterations = 0; // 0 = lo que pida cada caso
+        uint32_t    seed = 1337u;
+    };
+
+    struct Stats
+    {
+        double meanMs = 0.0;
+        double minMs = 0.0;
+        double maxMs = 0.0;
+        double p50Ms = 0.0;
+        double p95Ms = 0.0;
+        double stddevMs = 0.0;
+    };
+
+    struct Result
+    {
+        std::string    name;     // "suite/caso"
+        nlohmann::json params = nlohmann::json::object();
+        nlohmann::json counters = nlohmann::json::object();
+        std::vector<double> samplesMs;
+        Stats stats;
+    };
+
+    class Harness
+    {
+    public:
+        explicit Harness(Options options);
+
+        const Options& GetOptions() const { return m_options; }
+        bool ShouldRun(const std::string& name) const;
+        int  Iterations(int requested) const;
+
+        // 'setup' corre antes de cada iteración fuera de la medición; 'body'
+        // es lo que se cronometra. Hay una iteración de calentamiento.
+        Result* Run(const std::string& name,
+                    nlohmann::json params,
+                    int iterations,
+                    const std::function<void()>& setup,
+                    const std::function<void()>& body);
+
+        // Para casos que miden por su cuenta (p. ej. duración de cada paso de física).
+        Result* Record(const std::string& name, nlohmann::json params, std::vector<double> samplesMs);
+
+        bool WriteJson(const std::string& path) const;
+        void PrintSummary() const;
+
+        static Stats ComputeStats(std::vector<double> samplesMs);
+
+    private:
+        Options             m_options;
+        std::vector<Result> m_results;
+    };
+
+    // Registro de suites. Cada una decide sus tamaños según Options::quick.
+    void RunSceneBenchmarks(Harness& harness);
+    void RunAssetBenchmarks(Harness& harness);
+    // Inicializa su propio bgfx (Renderer headless, Noop).
+    void RunRenderBenchmarks(Harness& harness);
+    void RunPhysicsBenchmarks(Harness& harness);
+    void RunEventBenchmarks(Harness& harness);
+}
@@ -0,0 +1,120 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+#ifdef _WIN32
+  #include <windows.h>
+#endif
+
+#include <bgfx/bgfx.h>
+#include <bgfx/platform.h>
+
+#include "BenchHarness.h"
+
+// SandboxCityBench: benchmarks sin ventana de los subsistemas del motor.
+//
+//   SandboxCityBench [--out fichero.json] [--filter subcadena] [--quick]
+//                    [--iterations N] [--seed N]
+//
+// Los assets se leen con la misma detección de raíz que el juego, así que el
+// ejecutable debe lanzarse desde bin/<Config> o junto a una carpeta assets/.
+
+namespace
+{
+    void PrintUsage()
+    {
+        std::printf("Uso: SandboxCityBench [--out fichero.json] [--filter subcadena] [--quick] [--iterations N] [--seed N]\n");
+    }
+
+    bool ParseArgs(int argc, char** argv, Bench::Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const char* arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (std::strcmp(arg, "--out") == 0 && hasValue)
+            {
+                options.outPath = argv[++i];
+            }
+            else if (std::strcmp(arg, "--filter") == 0 && hasValue)
+            {
+                options.filter = argv[++i];
+            }
+            else if (std::strcmp(arg, "--iterations") == 0 && hasValue)
+            {
+                options.iterations = std::atoi(argv[++i]);
+            }
+            else if (std::strcmp(arg, "--seed") == 0 && hasValue)
+            {
+                options.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (std::strcmp(arg, "--quick") == 0)
+            {
+                options.quick = true;
+            }
+            else
+            {
+                PrintUsage();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // bgfx con el backend Noop y sin ventana: basta para crear buffers y
+    // texturas de ResourceManager sin GPU.
+    bool InitNoopRenderer()
+    {
+        bgfx::renderFrame();
+
+        bgfx::Init init{};
+        init.type = bgfx::RendererType::Noop;
+        init.vendorId = BGFX_PCI_ID_NONE;
+        init.resolution.width = 1;
+        init.resolution.height = 1;
+        init.resolution.reset = BGFX_RESET_NONE;
+        return bgfx::init(init);
+    }
+}
+
+int main(int argc, char** argv)
+{
+#ifdef _WIN32
+    SetConsoleOutputCP(CP_UTF8);
+#endif
+
+    Bench::Options options;
+    if (!ParseArgs(argc, argv, options))
+    {
+        return EXIT_FAILURE;
+    }
+
+    try {
+        Bench::Harness harness(options);
+
+        Bench::RunSceneBenchmarks(harness);
+
+        if (InitNoopRenderer())
+        {
+            Bench::RunAssetBenchmarks(harness);
+            bgfx::shutdown();
+        }
+        else
+        {
+            std::printf("[Bench] bgfx::init(Noop) falló, se omiten los benchmarks de assets\n");
+        }
+
+        Bench::RunRenderBenchmarks(harness);
+
+        Bench::RunPhysicsBenchmarks(harness);
+        Bench::RunEventBenchmarks(harness);
+
+        harness.PrintSummary();
+        return harness.WriteJson(options.outPath) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    catch (const std::exception& e) {
+        std::fprintf(stderr, "[FATAL] Excepción: %s\n", e.what());
+        return EXIT_FAILURE;
+    }
+}
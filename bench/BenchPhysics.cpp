@@ -0,0 +1,200 @@
+#include "BenchHarness.h"
+
+#include "camera/Camera.h"
+#include "ecs/Scene.h"
+#include "input/InputSystem.h"
+#include "physics/PhysicsAPI.h"
+#include "physics/PhysicsSystem.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr double kStepDt = 1.0 / 120.0;
+
+    int GridSide(int count)
+    {
+        return std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(count)))));
+    }
+
+    // Cajas dinámicas en columnas de 10 sobre el suelo, como el stress de
+    // PhysicsBenchmark; cada muestra es la duración de un stepSimulation.
+    void RunDynamicStep(Bench::Harness& harness, int bodyCount, int steps, bool multithreaded)
+    {
+        const std::string name = std::string("physics/step_") + (multithreaded ? "mt" : "st") + "/" + std::to_string(bodyCount);
+        if (!harness.ShouldRun(name))
+        {
+            return;
+        }
+
+        constexpr int   kColumnHeight = 10;
+        constexpr float kHalfExtent = 0.5f;
+        constexpr float kSpacing = 1.5f;
+
+        Scene scene;
+        Camera camera;
+        InputSystem input;
+
+        const int side = GridSide(std::max(1, bodyCount / kColumnHeight));
+        for (int i = 0; i < bodyCount; ++i)
+        {
+            const int column = i / kColumnHeight;
+            const int level = i % kColumnHeight;
+
+            const EntityId id = scene.CreateEntity();
+            Transform* transform = scene.AddTransform(id);
+            transform->position = float3{
+                static_cast<float>(column % side) * kSpacing,
+                kHalfExtent + static_cast<float>(level) * (kHalfExtent * 2.0f + 0.05f),
+                static_cast<float>(column / side) * kSpacing};
+
+            Collider* collider = scene.AddCollider(id);
+            collider->size = float3{kHalfExtent, kHalfExtent, kHalfExtent};
+
+            RigidBody* body = scene.AddRigidBody(id);
+            body->type = RigidBodyType::Dynamic;
+            body->mass = 1.0f;
+        }
+
+        PhysicsSystem physics;
+        physics.SetThreading(multithreaded, 0);
+        physics.Initialize();
+
+        // El primer Update crea los cuerpos; no cuenta.
+        physics.Update(scene, camera, input, kStepDt);
+        physics.FlushEvents();
+
+        std::vector<double> samples;
+        samples.reserve(static_cast<size_t>(steps));
+        for (int step = 0; step < steps; ++step)
+        {
+            physics.Update(scene, camera, input, kStepDt);
+            physics.FlushEvents();
+            samples.push_back(physics.GetLastStepDurationMs());
+        }
+
+        harness.Record(name,
+                       {{"bodies", bodyCount}, {"steps", steps}, {"dt", kStepDt}, {"multithreaded", physics.IsMultithreaded()}},
+                       std::move(samples));
+    }
+
+    // Rejilla de cajas estáticas y lotes de rayos verticales/oblicuos con
+    // origen aleatorio (semilla fija). Se mide el lote completo.
+    void RunRaycastBatch(Bench::Harness& harness, int staticCount, int rayCount, bool all, uint32_t seed)
+    {
+        const std::string name = std::string("physics/") + (all ? "raycast_all/" : "raycast/") +
+                                 std::to_string(staticCount) + "x" + std::to_string(rayCount);
+        if (!harness.ShouldRun(name))
+        {
+            return;
+        }
+
+        constexpr float kSpacing = 4.0f;
+        constexpr float kMaxDistance = 200.0f;
+
+        Scene scene;
+        Camera camera;
+        InputSystem input;
+
+        const int side = GridSide(staticCount);
+        const float extent = static_cast<float>(side) * kSpacing;
+        for (int i = 0; i < staticCount; ++i)
+        {
+            const EntityId id = scene.CreateEntity();
+            Transform* transform = scene.AddTransform(id);
+            transform->position = float3{
+                static_cast<float>(i % side) * kSpacing,
+                1.0f + static_cast<float>(i % 5),
+                static_cast<float>(i / side) * kSpacing};
+
+            Collider* collider = scene.AddCollider(id);
+            collider->size = float3{1.0f, 1.0f, 1.0f};
+            scene.AddRigidBody(id);
+        }
+
+        PhysicsSystem physics;
+        physics.Initialize();
+        physics.Update(scene, camera, input, kStepDt);
+        physics.FlushEvents();
+
+        struct Ray
+        {
+            float3 origin;
+            float3 direction;
+        };
+
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> position(0.0f, extent);
+        std::uniform_real_distribution<float> tilt(-0.5f, 0.5f);
+        std::vector<Ray> rays(static_cast<size_t>(rayCount));
+        for (Ray& ray : rays)
+        {
+            ray.origin = float3{position(rng), 50.0f, position(rng)};
+            const float dx = tilt(rng);
+            const float dz = tilt(rng);
+            const float len = std::sqrt(dx * dx + 1.0f + dz * dz);
+            ray.direction = float3{dx / len, -1.0f / len, dz / len};
+        }
+
+        size_t hits = 0;
+        Bench::Result* result = harness.Run(name,
+                                            {{"statics", staticCount}, {"rays", rayCount}, {"maxDistance", kMaxDistance}},
+                                            20,
+                                            [&]() { hits = 0; },
+                                            [&]()
+                                            {
+                                                PhysicsRaycastHit hit;
+                                                for (const Ray& ray : rays)
+                                                {
+                                                    if (all)
+                                                    {
+                                                        hits += physics.RaycastAll(ray.origin, ray.direction, kMaxDistance, 0xffffffffu).size();
+                                                    }
+                                                    else if (physics.Raycast(ray.origin, ray.direction, kMaxDistance, 0xffffffffu, hit))
+                                                    {
+                                                        ++hits;
+                                                    }
+                                                }
+                                            });
+        if (result)
+        {
+            result->counters["hits"] = hits;
+        }
+    }
+}
+
+namespace Bench
+{
+    void RunPhysicsBenchmarks(Harness& harness)
+    {
+        const bool quick = harness.GetOptions().quick;
+        const uint32_t seed = harness.GetOptions().seed;
+
+        // Los PhysicsSystem del benchmark se registran como sistema activo.
+        PhysicsSystem* previousActive = Physics::GetActiveSystem();
+
+        const int steps = harness.Iterations(quick ? 60 : 240);
+        const std::vector<int> bodyCounts = quick ? std::vector<int>{500, 2000}
+                                                  : std::vector<int>{500, 2000, 5000, 10000};
+        for (int bodies : bodyCounts)
+        {
+            RunDynamicStep(harness, bodies, steps, false);
+            RunDynamicStep(harness, bodies, steps, true);
+        }
+
+        const std::vector<int> staticCounts = quick ? std::vector<int>{1000}
+                                                    : std::vector<int>{1000, 10000};
+        const int rays = quick ? 1000 : 10000;
+        for (int statics : staticCounts)
+        {
+            RunRaycastBatch(harness, statics, rays, false, seed);
+            RunRaycastBatch(harness, statics, rays, true, seed);
+        }
+
+        Physics::SetActiveSystem(previousActive);
+    }
+}
@@ -0,0 +1,157 @@
+#include "BenchHarness.h"
+
+#include "math/SimdMath.h"
+#include "render/RenderPacket.h"
+#include "render/Renderer.h"
+
+#include <bgfx/bgfx.h>
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <exception>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr uint32_t kMaterialCount = 16;
+
+    struct BenchGeometry
+    {
+        bgfx::VertexBufferHandle vbh = BGFX_INVALID_HANDLE;
+        bgfx::IndexBufferHandle  ibh = BGFX_INVALID_HANDLE;
+        uint32_t indexCount = 0;
+
+        void Destroy()
+        {
+            if (bgfx::isValid(vbh)) bgfx::destroy(vbh);
+            if (bgfx::isValid(ibh)) bgfx::destroy(ibh);
+            vbh = BGFX_INVALID_HANDLE;
+            ibh = BGFX_INVALID_HANDLE;
+        }
+    };
+
+    BenchGeometry CreateCube()
+    {
+        const float vertices[] =
+        {
+            -1.0f,  1.0f,  1.0f,   1.0f,  1.0f,  1.0f,  -1.0f, -1.0f,  1.0f,   1.0f, -1.0f,  1.0f,
+            -1.0f,  1.0f, -1.0f,   1.0f,  1.0f, -1.0f,  -1.0f, -1.0f, -1.0f,   1.0f, -1.0f, -1.0f,
+        };
+        const uint16_t indices[] =
+        {
+            0,1,2, 1,3,2,  4,6,5, 5,6,7,  0,2,4, 4,2,6,
+            1,5,3, 5,7,3,  0,4,1, 1,4,5,  2,3,6, 3,7,6,
+        };
+
+        bgfx::VertexLayout layout;
+        layout.begin()
+            .add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float)
+        .end();
+
+        BenchGeometry cube;
+        cube.vbh = bgfx::createVertexBuffer(bgfx::copy(vertices, sizeof(vertices)), layout);
+        cube.ibh = bgfx::createIndexBuffer(bgfx::copy(indices, sizeof(indices)));
+        cube.indexCount = static_cast<uint32_t>(sizeof(indices) / sizeof(indices[0]));
+        return cube;
+    }
+
+    // Ciudad sintética: una rejilla de cubos con rotación y escala variadas y
+    // materiales repartidos, como saldría de Renderer::BuildPacket.
+    void BuildPacket(RenderPacket& packet, const BenchGeometry& cube, int drawCount, uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> angle(-3.14159f, 3.14159f);
+        std::uniform_real_distribution<float> scale(0.5f, 4.0f);
+
+        packet.Clear();
+        packet.materials.resize(kMaterialCount);
+        for (uint32_t i = 0; i < kMaterialCount; ++i)
+        {
+            packet.materials[i].baseTint[0] = static_cast<float>(i) / kMaterialCount;
+        }
+
+        const int side = std::max(1, static_cast<int>(std::sqrt(static_cast<float>(drawCount))));
+        packet.draws.resize(static_cast<size_t>(drawCount));
+        for (int i = 0; i < drawCount; ++i)
+        {
+            RenderDrawItem& item = packet.draws[static_cast<size_t>(i)];
+            item.vbh = cube.vbh;
+            item.ibh = cube.ibh;
+            item.startIndex = 0;
+            item.indexCount = cube.indexCount;
+            item.material = static_cast<uint32_t>(rng() % kMaterialCount);
+
+            const float3 position{static_cast<float>(i % side) * 4.0f, 0.0f, static_cast<float>(i / side) * 4.0f};
+            const float3 size{scale(rng), scale(rng), scale(rng)};
+            math::MtxFromTRS(item.world, position, math::QuatFromEuler(float3{0.0f, angle(rng), 0.0f}), size);
+        }
+    }
+
+    void RunSubmit(Bench::Harness& harness, Renderer& renderer, const RenderPacket& packet, unsigned encoders)
+    {
+        const std::string name = "render/submit/encoders_" + std::to_string(encoders) + "/" + std::to_string(packet.draws.size());
+        if (!harness.ShouldRun(name))
+        {
+            return;
+        }
+
+        renderer.SetSubmitThreadCount(encoders);
+        // bgfx::frame fuera de la medición: con Noop sólo vacía la lista de
+        // draws, que no admite dos paquetes de 50k en el mismo frame
+        Bench::Result* result = harness.Run(name,
+                                            {{"draws", packet.draws.size()}, {"encoders", renderer.GetSubmitThreadCount()}},
+                                            30,
+                                            []() { bgfx::frame(); },
+                                            [&]() { renderer.SubmitPacket(packet); });
+        if (result)
+        {
+            result->counters["materials"] = packet.materials.size();
+            result->counters["droppedDraws"] = renderer.GetLastDroppedDraws();
+        }
+        bgfx::frame();
+    }
+}
+
+namespace Bench
+{
+    void RunRenderBenchmarks(Harness& harness)
+    {
+        Renderer renderer;
+        try {
+            renderer.InitHeadless(1280, 720);
+        }
+        catch (const std::exception& e) {
+            std::printf("[Bench] Renderer headless no disponible (%s), se omiten los benchmarks de render\n", e.what());
+            return;
+        }
+
+        BenchGeometry cube = CreateCube();
+        RenderPacket packet;
+        BuildPacket(packet, cube, harness.GetOptions().quick ? 10000 : 50000, harness.GetOptions().seed);
+
+        // 1 contra N encoders; N se limita a lo que admite bgfx
+        renderer.SetSubmitThreadCount(UINT_MAX);
+        const unsigned maxEncoders = renderer.GetSubmitThreadCount();
+        std::vector<unsigned> counts{1};
+        for (unsigned n = 2; n < maxEncoders; n *= 2)
+        {
+            counts.push_back(n);
+        }
+        if (maxEncoders > 1)
+        {
+            counts.push_back(maxEncoders);
+        }
+
+        for (unsigned encoders : counts)
+        {
+            RunSubmit(harness, renderer, packet, encoders);
+        }
+
+        cube.Destroy();
+        renderer.Shutdown();
+    }
+}
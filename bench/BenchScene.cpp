@@ -0,0 +1,337 @@
+#include "BenchHarness.h"
+
+#include "ecs/ArchetypeStorage.h"
+#include "ecs/Scene.h"
+#include "ecs/TransformSystem.h"
+
+#include <algorithm>
+#include <initializer_list>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    enum class HierarchyShape
+    {
+        Flat,     // todo raíces
+        Chain,    // cadenas de profundidad fija
+        Wide,     // una raíz con todos los demás como hijos directos
+        Tree,     // árbol equilibrado de factor 4
+    };
+
+    const char* ShapeName(HierarchyShape shape)
+    {
+        switch (shape)
+        {
+        case HierarchyShape::Flat:  return "flat";
+        case HierarchyShape::Chain: return "chain";
+        case HierarchyShape::Wide:  return "wide";
+        case HierarchyShape::Tree:  return "tree";
+        }
+        return "?";
+    }
+
+    constexpr int kChainDepth = 256;
+    constexpr int kTreeBranching = 4;
+
+    // Devuelve las raíces creadas, que son las que se marcan sucias en cada iteración.
+    std::vector<EntityId> BuildHierarchy(Scene& scene, HierarchyShape shape, int count, std::mt19937& rng)
+    {
+        std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+        std::vector<EntityId> entities;
+        std::vector<EntityId> roots;
+        entities.reserve(static_cast<size_t>(count));
+
+        for (int i = 0; i < count; ++i)
+        {
+            const EntityId id = scene.CreateEntity();
+            Transform* transform = scene.AddTransform(id);
+            transform->position = float3{offset(rng), offset(rng), offset(rng)};
+            transform->rotation = math::QuatFromEuler(float3{0.0f, offset(rng), 0.0f});
+
+            EntityId parent = kInvalidEntity;
+            switch (shape)
+            {
+            case HierarchyShape::Flat:
+                break;
+            case HierarchyShape::Chain:
+                if (i % kChainDepth != 0)
+                {
+                    parent = entities.back();
+                }
+                break;
+            case HierarchyShape::Wide:
+                if (i != 0)
+                {
+                    parent = entities.front();
+                }
+                break;
+            case HierarchyShape::Tree:
+                if (i != 0)
+                {
+                    parent = entities[static_cast<size_t>((i - 1) / kTreeBranching)];
+                }
+                break;
+            }
+
+            if (parent != kInvalidEntity)
+            {
+                scene.SetParent(id, parent);
+            }
+            else
+            {
+                roots.push_back(id);
+            }
+            entities.push_back(id);
+        }
+        return roots;
+    }
+
+    void RunChurn(Bench::Harness& harness, int count)
+    {
+        const std::string name = "scene/churn/" + std::to_string(count);
+        if (!harness.ShouldRun(name))
+        {
+            return;
+        }
+
+        // Crear N entidades con Transform + MeshRenderer y destruirlas todas:
+        // mide el coste de los mapas por componente y de la lista de libres.
+        Scene scene;
+        std::vector<EntityId> ids;
+        ids.reserve(static_cast<size_t>(count));
+        harness.Run(name, {{"entities", count}}, 10, nullptr, [&]()
+        {
+            ids.clear();
+            for (int i = 0; i < count; ++i)
+            {
+                const EntityId id = scene.CreateEntity();
+                scene.AddTransform(id);
+                scene.AddMeshRenderer(id);
+                ids.push_back(id);
+            }
+            for (EntityId id : ids)
+            {
+                scene.DestroyEntity(id);
+            }
+        });
+    }
+
+    void RunInterleavedChurn(Bench::Harness& harness, int live, uint32_t seed)
+    {
+        const std::string name = "scene/churn_interleaved/" + std::to_string(live);
+        if (!harness.ShouldRun(name))
+        {
+            return;
+        }
+
+        // Población estable de 'live' entidades donde cada iteración destruye y
+        // recrea un 10% al azar, como spawns/despawns de gameplay.
+        Scene scene;
+        std::vector<EntityId> ids;
+        ids.reserve(static_cast<size_t>(live));
+        for (int i = 0; i < live; ++i)
+        {
+            const EntityId id = scene.CreateEntity();
+            scene.AddTransform(id);
+            ids.push_back(id);
+        }
+
+        std::mt19937 rng(seed);
+        const int perIteration = std::max(1, live / 10);
+        harness.Run(name, {{"entities", live}, {"replacedPerIteration", perIteration}}, 20, nullptr, [&]()
+        {
+            for (int i = 0; i < perIteration; ++i)
+            {
+                const size_t slot = rng() % ids.size();
+                scene.DestroyEntity(ids[slot]);
+                const EntityId id = scene.CreateEntity();
+                scene.AddTransform(id);
+                ids[slot] = id;
+            }
+        });
+    }
+
+    void RunTransformUpdate(Bench::Harness& harness, HierarchyShape shape, int count, uint32_t seed)
+    {
+        const std::string name = std::string("transform/") + ShapeName(shape) + "/" + std::to_string(count);
+        if (!harness.ShouldRun(name + "/all_dirty") && !harness.ShouldRun(name + "/clean"))
+        {
+            return;
+        }
+
+        Scene scene;
+        std::mt19937 rng(seed);
+        const std::vector<EntityId> roots = BuildHierarchy(scene, shape, count, rng);
+        TransformSystem::Update(scene);
+
+        // Todo sucio: cada iteración recalcula todas las matrices locales y mundo.
+        harness.Run(name + "/all_dirty",
+                    {{"entities", count}, {"shape", ShapeName(shape)}, {"roots", roots.size()}},
+                    20,
+                    [&]()
+                    {
+                        for (EntityId root : roots)
+                        {
+                            scene.MarkHierarchyDirty(root);
+                        }
+                    },
+                    [&]() { TransformSystem::Update(scene); });
+
+        // Nada sucio: coste fijo del recorrido de la jerarquía.
+        harness.Run(name + "/clean",
+                    {{"entities", count}, {"shape", ShapeName(shape)}, {"roots", roots.size()}},
+                    20,
+                    nullptr,
+                    [&]() { TransformSystem::Update(scene); });
+    }
+
+    ArchetypeStorage::Mask MaskOf(std::initializer_list<ComponentType> types)
+    {
+        ArchetypeStorage::Mask mask;
+        for (ComponentType type : types)
+        {
+            mask.set(static_cast<size_t>(type));
+        }
+        return mask;
+    }
+
+    // Mapas por componente (Scene) frente a arquetipos (ArchetypeStorage):
+    // añadir/quitar un componente es insertar/borrar en un mapa en uno y mover
+    // la fila de arquetipo en el otro.
+    void RunComponentChurn(Bench::Harness& harness, int count)
+    {
+        const std::string sparseName = "ecs/component_churn/sparse/" + std::to_string(count);
+        const std::string archetypeName = "ecs/component_churn/archetype/" + std::to_string(count);
+
+        if (harness.ShouldRun(sparseName))
+        {
+            Scene scene;
+            std::vector<EntityId> ids;
+            ids.reserve(static_cast<size_t>(count));
+            for (int i = 0; i < count; ++i)
+            {
+                ids.push_back(scene.CreateEntity());
+                scene.AddTransform(ids.back());
+            }
+            harness.Run(sparseName, {{"entities", count}}, 10, nullptr, [&]()
+            {
+                for (EntityId id : ids)
+                {
+                    scene.AddMeshRenderer(id);
+                }
+                for (EntityId id : ids)
+                {
+                    scene.RemoveMeshRenderer(id);
+                }
+            });
+        }
+
+        if (harness.ShouldRun(archetypeName))
+        {
+            const ArchetypeStorage::Mask base = MaskOf({ComponentType::Transform});
+            const ArchetypeStorage::Mask withRenderer = MaskOf({ComponentType::Transform, ComponentType::MeshRenderer});
+            ArchetypeStorage storage;
+            std::vector<EntityId> ids;
+            ids.reserve(static_cast<size_t>(count));
+            for (int i = 0; i < count; ++i)
+            {
+                ids.push_back(MakeEntityId(static_cast<uint32_t>(i + 1), 0));
+                storage.Add(ids.back(), base);
+            }
+            harness.Run(archetypeName, {{"entities", count}, {"rowsPerChunk", storage.GetRowsPerChunk(base)}}, 10, nullptr, [&]()
+            {
+                for (EntityId id : ids)
+                {
+                    storage.SetMask(id, withRenderer);
+                }
+                for (EntityId id : ids)
+                {
+                    storage.SetMask(id, base);
+                }
+            });
+        }
+    }
+
+    // Matrices mundo de N raíces, todas sucias: nodos de unordered_map con
+    // Transform AoS frente a columnas SoA por chunk.
+    void RunStorageIteration(Bench::Harness& harness, int count, uint32_t seed)
+    {
+        const std::string sparseName = "ecs/iterate_transforms/sparse/" + std::to_string(count);
+        const std::string archetypeName = "ecs/iterate_transforms/archetype/" + std::to_string(count);
+        std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+
+        if (harness.ShouldRun(sparseName))
+        {
+            Scene scene;
+            std::mt19937 rng(seed);
+            const std::vector<EntityId> roots = BuildHierarchy(scene, HierarchyShape::Flat, count, rng);
+            harness.Run(sparseName,
+                        {{"entities", count}},
+                        20,
+                        [&]()
+                        {
+                            for (EntityId root : roots)
+                            {
+                                scene.GetTransform(root)->MarkDirty();
+                            }
+                        },
+                        [&]() { TransformSystem::Update(scene); });
+        }
+
+        if (harness.ShouldRun(archetypeName))
+        {
+            const ArchetypeStorage::Mask mask = MaskOf({ComponentType::Transform, ComponentType::MeshRenderer});
+            ArchetypeStorage storage;
+            std::mt19937 rng(seed);
+            for (int i = 0; i < count; ++i)
+            {
+                const EntityId id = MakeEntityId(static_cast<uint32_t>(i + 1), 0);
+                storage.Add(id, mask);
+                storage.SetTransform(id,
+                                     float3{offset(rng), offset(rng), offset(rng)},
+                                     math::QuatFromEuler(float3{0.0f, offset(rng), 0.0f}),
+                                     float3{1.0f, 1.0f, 1.0f});
+            }
+            harness.Run(archetypeName,
+                        {{"entities", count}, {"chunks", storage.GetChunkCount()}},
+                        20,
+                        nullptr,
+                        [&]() { TransformSystem::UpdateArchetypes(storage); });
+        }
+    }
+}
+
+namespace Bench
+{
+    void RunSceneBenchmarks(Harness& harness)
+    {
+        const bool quick = harness.GetOptions().quick;
+        const uint32_t seed = harness.GetOptions().seed;
+
+        const std::vector<int> churnCounts = quick ? std::vector<int>{1000, 10000}
+                                                   : std::vector<int>{1000, 10000, 100000};
+        for (int count : churnCounts)
+        {
+            RunChurn(harness, count);
+            RunInterleavedChurn(harness, count, seed);
+        }
+
+        const std::vector<int> transformCounts = quick ? std::vector<int>{1000, 10000}
+                                                       : std::vector<int>{1000, 10000, 100000};
+        for (HierarchyShape shape : {HierarchyShape::Flat, HierarchyShape::Chain, HierarchyShape::Wide, HierarchyShape::Tree})
+        {
+            for (int count : transformCounts)
+            {
+                RunTransformUpdate(harness, shape, count, seed);
+            }
+        }
+
+        for (int count : transformCounts)
+        {
+            RunComponentChurn(harness, count);
+            RunStorageIteration(harness, count, seed);
+        }
+    }
+}
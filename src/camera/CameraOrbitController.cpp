@@ -26,7 +26,7 @@ namespace
 CameraOrbitController::CameraOrbitController(Camera& camera,
                                              Scene& scene,
                                              InputSystem& input,
-                                             Window& window,
+                                             Window* window,
                                              Renderer& renderer)
     : m_camera(camera)
     , m_scene(scene)
@@ -48,6 +48,13 @@ CameraOrbitController::CameraOrbitController(Camera& camera,
     m_config.smoothing = true;
     m_config.smoothFactor = 8.0f;
 
+    m_orbitLookId = m_input.RegisterAction("OrbitLook");
+    m_orbitResetId = m_input.RegisterAction("OrbitReset");
+    m_orbitCancelId = m_input.RegisterAction("OrbitCancel");
+    m_lookXId = m_input.RegisterAxis("LookX");
+    m_lookYId = m_input.RegisterAxis("LookY");
+    m_zoomId = m_input.RegisterAxis("Zoom");
+
     ResetToDefaults();
 }
 
@@ -222,8 +229,6 @@ void CameraOrbitController::ResolveTargetEntity()
 
 void CameraOrbitController::Update(double dt)
 {
-    ReloadConfigIfNeeded();
-
     if (m_targetEntity != kInvalidEntity && !m_scene.IsAlive(m_targetEntity))
     {
         m_targetEntity = kInvalidEntity;
@@ -234,23 +239,23 @@ void CameraOrbitController::Update(double dt)
         ResolveTargetEntity();
     }
 
-    auto orbitLook = m_input.GetAction("OrbitLook");
-    auto orbitReset = m_input.GetAction("OrbitReset");
-    auto orbitCancel = m_input.GetAction("OrbitCancel");
+    auto orbitLook = m_input.GetAction(m_orbitLookId);
+    auto orbitReset = m_input.GetAction(m_orbitResetId);
+    auto orbitCancel = m_input.GetAction(m_orbitCancelId);
 
     if (orbitLook.pressed)
     {
-        if (!m_window.IsCursorLocked())
+        if (m_window && !m_window->IsCursorLocked())
         {
-            m_window.SetCursorLocked(true);
+            m_window->SetCursorLocked(true);
         }
         m_cursorLocked = true;
     }
     if ((!orbitLook.held && m_cursorLocked) || orbitCancel.pressed)
     {
-        if (m_window.IsCursorLocked())
+        if (m_window && m_window->IsCursorLocked())
         {
-            m_window.SetCursorLocked(false);
+            m_window->SetCursorLocked(false);
         }
         m_cursorLocked = false;
     }
@@ -263,8 +268,8 @@ void CameraOrbitController::Update(double dt)
 
     if (m_cursorLocked)
     {
-        const float lookX = m_input.GetAxis("LookX");
-        const float lookY = m_input.GetAxis("LookY");
+        const float lookX = m_input.GetAxis(m_lookXId);
+        const float lookY = m_input.GetAxis(m_lookYId);
         const float invert = m_config.invertY ? 1.0f : -1.0f;
 
         m_targetYaw += lookX * m_config.sensLook;
@@ -272,11 +277,7 @@ void CameraOrbitController::Update(double dt)
         m_targetPitch = Clamp(m_targetPitch, m_minPitchRad, m_maxPitchRad);
     }
 
-    float zoomAxis = 0.0f;
-    if (m_input.HasAxis("Zoom"))
-    {
-        zoomAxis = m_input.GetAxis("Zoom");
-    }
+    const float zoomAxis = m_input.GetAxis(m_zoomId);
     if (std::fabs(zoomAxis) > 1e-4f)
     {
         m_targetDistance = Clamp(m_targetDistance + zoomAxis * m_config.sensZoom, m_minDistance, m_maxDistance);
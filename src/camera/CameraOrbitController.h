@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../ecs/Entity.h"
+#include "../input/InputId.h"
 
 #include <filesystem>
 #include <string>
@@ -17,11 +18,12 @@ public:
     CameraOrbitController(Camera& camera,
                           Scene& scene,
                           InputSystem& input,
-                          Window& window,
+                          Window* window, // nullptr en modo headless
                           Renderer& renderer);
 
     void SetConfigPath(std::filesystem::path path);
     void ReloadConfigIfNeeded();
+    const std::filesystem::path& GetConfigPath() const { return m_configPath; }
     void OnSceneReloaded();
     void Update(double dt);
 
@@ -50,7 +52,13 @@ private:
     Camera&      m_camera;
     Scene&       m_scene;
     InputSystem& m_input;
-    Window&      m_window;
+    InputId      m_orbitLookId;
+    InputId      m_orbitResetId;
+    InputId      m_orbitCancelId;
+    InputId      m_lookXId;
+    InputId      m_lookYId;
+    InputId      m_zoomId;
+    Window*      m_window = nullptr;
     Renderer&    m_renderer;
 
     std::filesystem::path          m_configPath;
@@ -1,5 +1,8 @@
 #include "Application.h"
 #include "Time.h"
+#include "Profiler.h"
+#include "FrameStats.h"
+#include "FileWatcher.h"
 #include "../window/Window.h"
 #include "../render/Renderer.h"
 #include "../resource/ResourceManager.h"
@@ -8,35 +11,106 @@
 #include "../ecs/TransformSystem.h"
 #include "../ecs/Scene.h"
 #include "../scene/SceneLoader.h"
+#include "../scene/SceneDiff.h"
+#include "../input/InputScript.h"
+#include "../input/InputRecording.h"
 #include "../physics/PhysicsAPI.h"
+#include "../physics/PhysicsBenchmark.h"
 
 #include <cstdio>
 
+#include <chrono>
+#include <nlohmann/json.hpp>
+#include <fstream>
 #include <stdexcept>
 #include <iostream>
 #include <string>
+#include <vector>
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
 #include <GLFW/glfw3.h> // para códigos de tecla
 #include <bx/math.h>
 
-Application::Application() {
-    m_window = std::make_unique<Window>("SandboxCity - Initializing...", 1280, 720);
+Application::Application(const ApplicationOptions& options)
+    : m_options(options)
+{
     m_renderer = std::make_unique<Renderer>();
-    m_renderer->Init(m_window->GetNativeWindowHandle(), m_window->GetWidth(), m_window->GetHeight());
+    if (m_options.headless)
+    {
+        m_renderer->InitHeadless(m_options.width, m_options.height);
+    }
+    else
+    {
+        m_window = std::make_unique<Window>("SandboxCity - Initializing...", (int)m_options.width, (int)m_options.height);
+        m_renderer->Init(m_window->GetNativeWindowHandle(), m_window->GetWidth(), m_window->GetHeight());
+    }
 
     m_input.SetWindow(m_window.get());
     m_input.LoadBindings("../../../assets/input/bindings.json");
+    m_hudInputIds.moveForward = m_input.RegisterAxis("MoveForward");
+    m_hudInputIds.moveRight = m_input.RegisterAxis("MoveRight");
+    m_hudInputIds.lookX = m_input.RegisterAxis("LookX");
+    m_hudInputIds.lookY = m_input.RegisterAxis("LookY");
+    m_hudInputIds.jump = m_input.RegisterAction("Jump");
+    m_hudInputIds.sprint = m_input.RegisterAction("Sprint");
+
+    if (!m_options.inputScriptPath.empty())
+    {
+        m_inputScript = std::make_unique<InputScript>();
+        std::string error;
+        if (!m_inputScript->Load(m_options.inputScriptPath, &error))
+        {
+            std::printf("[App] Error al cargar guion de entrada '%s': %s\n", m_options.inputScriptPath.c_str(), error.c_str());
+            m_inputScript.reset();
+        }
+    }
+    if (m_options.headless)
+    {
+        // Sin guion la entrada queda neutra, nunca se lee GLFW.
+        m_input.SetScriptedInput(true);
+    }
 
     m_physics.SetConfigPath("../../../assets/config/physics.json");
     m_physics.Initialize();
 
+    if (!m_options.replayInputPath.empty())
+    {
+        m_inputReplay = std::make_unique<InputReplay>();
+        std::string error;
+        if (!m_inputReplay->Load(m_options.replayInputPath, &error))
+        {
+            std::printf("[App] Error al cargar grabación de entrada '%s': %s\n", m_options.replayInputPath.c_str(), error.c_str());
+            m_inputReplay.reset();
+        }
+        else
+        {
+            const InputRecordingInfo& info = m_inputReplay->GetInfo();
+            if (info.scenePath != m_options.scenePath)
+            {
+                std::printf("[InputReplay] AVISO: grabada con la escena '%s' y se reproduce con '%s'\n",
+                            info.scenePath.c_str(), m_options.scenePath.c_str());
+            }
+            if (info.fixedStep != m_physics.GetFixedStep())
+            {
+                std::printf("[InputReplay] AVISO: fixedStep grabado %.6f, actual %.6f\n",
+                            info.fixedStep, m_physics.GetFixedStep());
+            }
+        }
+    }
+    if ((m_inputReplay || !m_options.recordInputPath.empty()) && m_physics.IsMultithreaded())
+    {
+        std::printf("[InputReplay] AVISO: el mundo multihilo de Bullet no garantiza una trayectoria idéntica bit a bit; usa multithreaded=false en physics.json\n");
+    }
+
     if (EventBus* bus = Physics::GetEventBus())
     {
-        bus->Subscribe<PhysicsSystem::TriggerEvent>([this](const PhysicsSystem::TriggerEvent& evt)
+        bus->Subscribe<PhysicsSystem::TriggerEventBatch>([this](const PhysicsSystem::TriggerEventBatch& batch)
         {
-            OnTriggerEvent(evt);
+            for (size_t i = 0; i < batch.count; ++i)
+            {
+                OnTriggerEvent(batch.events[i]);
+            }
         });
     }
 
@@ -44,27 +118,57 @@ Application::Application() {
     m_resourceManager->Initialize();
     m_renderer->SetResourceManager(m_resourceManager.get());
 
-    m_scenePath = "assets/scenes/demo.json";
+    m_scenePath = m_options.scenePath;
     ReloadScene("inicial");
     
     m_camera = std::make_unique<Camera>();
-    m_window->SetCursorLocked(false);
+    if (m_window)
+    {
+        m_window->SetCursorLocked(false);
+    }
 
-    m_cameraOrbit = std::make_unique<CameraOrbitController>(*m_camera, m_scene, m_input, *m_window, *m_renderer);
+    m_cameraOrbit = std::make_unique<CameraOrbitController>(*m_camera, m_scene, m_input, m_window.get(), *m_renderer);
     m_cameraOrbit->SetConfigPath("../../../assets/config/camera.json");
     m_cameraOrbit->OnSceneReloaded();
 
+    // En headless no hay recarga en caliente: la ejecución debe ser reproducible.
+    if (!m_options.headless)
+    {
+        WatchFiles();
+    }
+
     // Proyección inicial
-    const float aspect = (float)m_window->GetWidth() / (float)m_window->GetHeight();
-    m_renderer->SetProjection(m_camera->GetFovYDeg(), aspect, m_camera->GetNear(), m_camera->GetFar());
+    m_renderer->SetProjection(m_camera->GetFovYDeg(), GetViewportAspect(), m_camera->GetNear(), m_camera->GetFar());
+
+    if (!m_options.recordInputPath.empty())
+    {
+        InputRecordingInfo info;
+        info.scenePath = m_scenePath;
+        info.fixedStep = m_physics.GetFixedStep();
+        info.physicsMultithreaded = m_physics.IsMultithreaded();
+
+        m_inputRecorder = std::make_unique<InputRecorder>();
+        std::string error;
+        if (!m_inputRecorder->Open(m_options.recordInputPath, m_input, info, &error))
+        {
+            std::printf("[App] Error al abrir grabación de entrada: %s\n", error.c_str());
+            m_inputRecorder.reset();
+        }
+    }
 
     const char* backend = m_renderer->GetBackendName();
-    std::string title = std::string("SandboxCity - Renderer: ") + (backend ? backend : "Unknown");
-    m_window->SetTitle(title);
+    if (m_window)
+    {
+        std::string title = std::string("SandboxCity - Renderer: ") + (backend ? backend : "Unknown");
+        m_window->SetTitle(title);
+    }
     std::cout << "[INFO] Renderer: " << (backend ? backend : "Unknown") << std::endl;
 }
 
 Application::~Application() {
+    m_fileWatcher.reset();
+    // El hilo de render puede estar grabando draws con recursos del gestor
+    if (m_renderer) m_renderer->WaitForSubmission();
     if (m_resourceManager) m_resourceManager->Shutdown();
     m_resourceManager.reset();
     if (m_renderer) m_renderer->Shutdown(); // <- extra seguro
@@ -74,62 +178,125 @@ Application::~Application() {
 
 void Application::Run() {
     Time::Init();
+    Profiler::SetThreadName("Main");
+    bool firstFrame = true;
 
-    while (m_running && !m_window->ShouldClose()) {
-        Time::Tick();
+    const bool headless = m_options.headless;
+    // En headless una reproducción termina la ejecución al acabarse.
+    const uint64_t frameLimit = m_inputReplay ? std::min(m_options.frames, m_inputReplay->GetFrameCount()) : m_options.frames;
+    if (headless)
+    {
+        std::printf("[App] Headless: %llu frames, dt=%.4fs\n",
+                    static_cast<unsigned long long>(frameLimit), m_options.timestep);
+        m_headlessFrameMs.reserve(static_cast<size_t>(frameLimit));
+    }
+    const auto runStart = std::chrono::steady_clock::now();
+    auto frameStart = runStart;
 
-        m_input.ReloadIfChanged();
-        m_input.Update(Time::DeltaTime());
+    while (m_running && (headless ? m_frameIndex < frameLimit : !m_window->ShouldClose())) {
+        Profiler::BeginFrame();
+        PROFILE_SCOPE("Frame");
 
-        if (m_physics.ReloadConfigIfNeeded(m_scene))
+        // La reproducción fija la entrada y el dt grabados del frame.
+        double replayDt = 0.0;
+        const bool replaying = m_inputReplay && m_inputReplay->ApplyFrame(m_input, m_frameIndex, replayDt);
+        if (m_inputReplay && !replaying)
         {
-            m_fixedDt = m_physics.GetFixedStep();
+            FinishInputReplay();
+        }
+
+        if (replaying)
+        {
+            Time::Advance(replayDt);
+        }
+        else if (headless)
+        {
+            // dt fijo: la simulación es idéntica en cualquier máquina y lo que
+            // se mide es el tiempo real de cada frame.
+            Time::Advance(m_options.timestep);
+        }
+        else
+        {
+            Time::Tick();
+        }
+
+        // El delta de este Tick es la duración completa del frame anterior
+        if (!firstFrame && !headless)
+        {
+            FrameStats::EndFrame(Time::DeltaTime() * 1000.0);
+        }
+        firstFrame = false;
+
+        // Punto de sincronización de la recarga en caliente: los callbacks
+        // corren aquí, en el hilo principal y entre frames.
+        if (m_fileWatcher)
+        {
+            m_fileWatcher->DispatchChanges();
+        }
+
+        {
+            FrameStats::ScopedStage stage(FrameStage::Input);
+            PROFILE_SCOPE("Input");
+            if (m_inputScript && !replaying)
+            {
+                m_inputScript->Apply(m_input, m_frameIndex);
+            }
+            m_input.Update(Time::DeltaTime());
+            if (m_inputRecorder)
+            {
+                m_inputRecorder->RecordFrame(m_input, Time::DeltaTime());
+            }
         }
 
         // Resize & proyección
-        int w = m_window->GetWidth();
-        int h = m_window->GetHeight();
-        m_renderer->OnResize((uint32_t)w, (uint32_t)h);
-        const float aspect = (h > 0) ? (float)w / (float)h : 16.0f/9.0f;
-        m_renderer->SetProjection(m_camera->GetFovYDeg(), aspect, m_camera->GetNear(), m_camera->GetFar());
-
-        // Fixed update 60 Hz
-        m_accum += Time::DeltaTime();
-        while (m_accum >= m_fixedDt) {
-            Update(m_fixedDt);
-            m_accum -= m_fixedDt;
+        if (m_window)
+        {
+            m_renderer->OnResize((uint32_t)m_window->GetWidth(), (uint32_t)m_window->GetHeight());
         }
+        m_renderer->SetProjection(m_camera->GetFovYDeg(), GetViewportAspect(), m_camera->GetNear(), m_camera->GetFar());
+
+        // Paso fijo (physics.json fixedStep); único bucle de paso fijo del motor
+        {
+            FrameStats::ScopedStage stage(FrameStage::Update);
+            m_accum += Time::DeltaTime();
+            while (m_accum >= m_fixedDt) {
+                PROFILE_SCOPE("FixedUpdate");
+                Update(m_fixedDt);
+                m_accum -= m_fixedDt;
+            }
+
+            // Entrega en bloque de los eventos de físicas acumulados en los pasos fijos
+            m_physics.FlushEvents();
 
-        // HUD de consola/título cada 0.5s
+            // Punto de sincronización: altas/bajas grabadas en los pasos fijos
+            // y en los handlers de eventos
+            m_sceneCommands.Playback(m_scene);
+
+            // Render entre el penúltimo y el último paso fijo
+            m_physics.ApplyRenderInterpolation(m_scene, static_cast<float>(m_accum / m_fixedDt));
+        }
+
+        // Título cada 0.5s con los FPS medios de la ventana de FrameStats
         m_statusAccum += Time::DeltaTime();
-        if (m_statusAccum >= 0.5) {
+        if (m_window && m_statusAccum >= 0.5) {
             const char* backend = m_renderer->GetBackendName();
-            const double fps = Time::FPS();
+            const double fps = FrameStats::GetAverageFps();
             std::string title = "SandboxCity - Renderer: ";
             title += (backend ? backend : "Unknown");
             title += "  |  FPS: ";
             title += std::to_string(static_cast<int>(fps + 0.5));
             m_window->SetTitle(title);
-            std::cout << "[INFO] Renderer: " << (backend ? backend : "Unknown")
-                      << " | FPS: " << fps << std::endl;
-            std::cout << "[ECS] Entities: " << m_lastEntityCount
-                      << " | Transforms: " << m_lastTransformCount
-                      << " | MeshRenderers: " << m_lastMeshRendererCount
-                      << " | Dirty (pre/post): " << m_lastDirtyBefore
-                      << " -> " << m_lastDirtyAfter
-                      << (m_lastDirtyAfter == 0 ? " [OK]" : " [WARN]")
-                      << std::endl;
             m_statusAccum = 0.0;
         }
 
         if (m_renderer)
         {
-            const float moveForward = m_input.GetAxis("MoveForward");
-            const float moveRight   = m_input.GetAxis("MoveRight");
-            const float lookX       = m_input.GetAxis("LookX");
-            const float lookY       = m_input.GetAxis("LookY");
-            const auto  jump        = m_input.GetAction("Jump");
-            const auto  sprint      = m_input.GetAction("Sprint");
+            const float moveForward = m_input.GetAxis(m_hudInputIds.moveForward);
+            const float moveRight   = m_input.GetAxis(m_hudInputIds.moveRight);
+            const float lookX       = m_input.GetAxis(m_hudInputIds.lookX);
+            const float lookY       = m_input.GetAxis(m_hudInputIds.lookY);
+            const auto  jump        = m_input.GetAction(m_hudInputIds.jump);
+            const auto  sprint      = m_input.GetAction(m_hudInputIds.sprint);
 
             char buffer[160];
             std::snprintf(buffer, sizeof(buffer),
@@ -144,28 +311,215 @@ void Application::Run() {
         }
 
         Render();
-        m_window->PollEvents();
+        if (m_window)
+        {
+            m_window->PollEvents();
+        }
+
+        if (headless)
+        {
+            const auto now = std::chrono::steady_clock::now();
+            const double frameMs = std::chrono::duration<double, std::milli>(now - frameStart).count();
+            frameStart = now;
+            FrameStats::EndFrame(frameMs);
+            m_headlessFrameMs.push_back(static_cast<float>(frameMs));
+        }
+        ++m_frameIndex;
+    }
+
+    if (m_inputReplay)
+    {
+        FinishInputReplay();
+    }
+    if (m_inputRecorder)
+    {
+        m_inputRecorder->Close();
+        std::printf("[InputRecord] Checksum de simulación: %016llx\n",
+                    static_cast<unsigned long long>(ComputeSimulationChecksum()));
+        m_inputRecorder.reset();
+    }
+
+    if (headless)
+    {
+        const double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart).count();
+        WriteHeadlessReport(wallSeconds);
     }
 
     // NO llamar a m_renderer->Shutdown() aquí; el destructor se encarga.
 }
 
+void Application::FinishInputReplay()
+{
+    std::printf("[InputReplay] Fin tras %llu frames. Checksum de simulación: %016llx\n",
+                static_cast<unsigned long long>(m_frameIndex),
+                static_cast<unsigned long long>(ComputeSimulationChecksum()));
+    m_inputReplay.reset();
+    if (!m_options.headless && !m_inputScript)
+    {
+        // De vuelta a teclado y ratón
+        m_input.SetScriptedInput(false);
+    }
+}
+
+uint64_t Application::ComputeSimulationChecksum() const
+{
+    std::vector<EntityId> ids;
+    ids.reserve(m_scene.GetRigidBodies().size() + m_scene.GetPhysicsCharacters().size());
+    for (const auto& [id, body] : m_scene.GetRigidBodies())
+    {
+        ids.push_back(id);
+    }
+    for (const auto& [id, character] : m_scene.GetPhysicsCharacters())
+    {
+        ids.push_back(id);
+    }
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+    // FNV-1a sobre los bits exactos de la pose
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void* data, size_t size)
+    {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+    };
+    for (EntityId id : ids)
+    {
+        if (const Transform* transform = m_scene.GetTransform(id))
+        {
+            mix(&id, sizeof(id));
+            mix(&transform->position, sizeof(transform->position));
+            mix(&transform->rotation, sizeof(transform->rotation));
+        }
+    }
+    return hash;
+}
+
+bool Application::IsKeyDown(int glfwKey) const
+{
+    return m_window && m_window->IsKeyDown(glfwKey);
+}
+
+float Application::GetViewportAspect() const
+{
+    const int w = m_window ? m_window->GetWidth() : (int)m_options.width;
+    const int h = m_window ? m_window->GetHeight() : (int)m_options.height;
+    return (h > 0) ? (float)w / (float)h : 16.0f/9.0f;
+}
+
+void Application::WriteHeadlessReport(double wallSeconds) const
+{
+    auto summarize = [](const FrameTimeSummary& summary)
+    {
+        return nlohmann::json{
+            {"avg", summary.avgMs},
+            {"p50", summary.p50Ms},
+            {"p95", summary.p95Ms},
+            {"p99", summary.p99Ms},
+            {"max", summary.maxMs},
+        };
+    };
+
+    // Percentiles sobre todos los frames; FrameStats sólo guarda los últimos kWindow.
+    std::vector<float> sorted = m_headlessFrameMs;
+    std::sort(sorted.begin(), sorted.end());
+    FrameTimeSummary frames;
+    if (!sorted.empty())
+    {
+        double sum = 0.0;
+        for (float ms : sorted)
+        {
+            sum += ms;
+        }
+        auto percentile = [&sorted](double p)
+        {
+            const size_t index = std::min(sorted.size() - 1,
+                                          static_cast<size_t>(std::ceil(p * static_cast<double>(sorted.size()))) - 1);
+            return static_cast<double>(sorted[index]);
+        };
+        frames.avgMs = sum / static_cast<double>(sorted.size());
+        frames.p50Ms = percentile(0.50);
+        frames.p95Ms = percentile(0.95);
+        frames.p99Ms = percentile(0.99);
+        frames.maxMs = sorted.back();
+    }
+
+    nlohmann::json stages = nlohmann::json::object();
+    for (size_t i = 0; i < FrameStats::kStageCount; ++i)
+    {
+        const FrameStage stage = static_cast<FrameStage>(i);
+        stages[FrameStats::GetStageName(stage)] = summarize(FrameStats::GetStageSummary(stage));
+    }
+
+    char checksum[17];
+    std::snprintf(checksum, sizeof(checksum), "%016llx", static_cast<unsigned long long>(ComputeSimulationChecksum()));
+
+    const char* backend = m_renderer ? m_renderer->GetBackendName() : nullptr;
+    nlohmann::json report = {
+        {"frames", m_headlessFrameMs.size()},
+        {"timestep", m_options.timestep},
+        {"simulatedSeconds", static_cast<double>(m_headlessFrameMs.size()) * m_options.timestep},
+        {"wallSeconds", wallSeconds},
+        {"avgFps", wallSeconds > 0.0 ? static_cast<double>(m_headlessFrameMs.size()) / wallSeconds : 0.0},
+        {"scene", m_scenePath},
+        {"inputScript", m_options.inputScriptPath},
+        {"inputReplay", m_options.replayInputPath},
+        {"simulationChecksum", checksum},
+        {"renderer", backend ? backend : "Unknown"},
+        {"entities", m_scene.GetEntityCount()},
+        {"meshRenderers", m_scene.GetMeshRendererCount()},
+        {"frameMs", summarize(frames)},
+        {"stageWindow", FrameStats::GetSampleCount()},
+        {"stageMs", stages},
+        {"hitches", FrameStats::GetTotalHitchCount()},
+    };
+
+    std::printf("[App] Headless: %zu frames en %.2fs | frame avg=%.3fms p50=%.3fms p95=%.3fms p99=%.3fms max=%.3fms\n",
+                m_headlessFrameMs.size(),
+                wallSeconds,
+                frames.avgMs,
+                frames.p50Ms,
+                frames.p95Ms,
+                frames.p99Ms,
+                frames.maxMs);
+    FrameStats::Log();
+    m_physics.LogStats();
+
+    if (m_options.reportPath.empty())
+    {
+        return;
+    }
+
+    std::ofstream file(m_options.reportPath);
+    if (!file)
+    {
+        std::printf("[App] No se pudo escribir el informe headless en %s\n", m_options.reportPath.c_str());
+        return;
+    }
+    file << report.dump(2) << '\n';
+    std::printf("[App] Informe headless en %s\n", m_options.reportPath.c_str());
+}
+
 void Application::Update(double dt) {
     // === Input ===
     if (m_cameraOrbit)
     {
+        PROFILE_SCOPE("CameraOrbit");
         m_cameraOrbit->Update(dt);
     }
 
     // === Toggles existentes ===
     static bool f1Latch=false, vLatch=false;
 
-    if (m_window->IsKeyDown(GLFW_KEY_F1)) {
+    if (IsKeyDown(GLFW_KEY_F1)) {
         if (!f1Latch) { f1Latch = true; m_renderer->ToggleWireframe(); }
     } else f1Latch = false;
 
     static bool f3Latch = false;
-    if (m_window->IsKeyDown(GLFW_KEY_F3))
+    if (IsKeyDown(GLFW_KEY_F3))
     {
         if (!f3Latch)
         {
@@ -178,12 +532,26 @@ void Application::Update(double dt) {
         f3Latch = false;
     }
 
-    if (m_window->IsKeyDown(GLFW_KEY_V)) {
+    if (IsKeyDown(GLFW_KEY_V)) {
         if (!vLatch) { vLatch = true; m_renderer->ToggleVsync(); }
     } else vLatch = false;
 
+    static bool f8Latch = false;
+    if (IsKeyDown(GLFW_KEY_F8))
+    {
+        if (!f8Latch)
+        {
+            f8Latch = true;
+            Profiler::RequestCapture(120);
+        }
+    }
+    else
+    {
+        f8Latch = false;
+    }
+
     static bool f9Latch = false;
-    if (m_window->IsKeyDown(GLFW_KEY_F9))
+    if (IsKeyDown(GLFW_KEY_F9))
     {
         if (!f9Latch)
         {
@@ -193,6 +561,15 @@ void Application::Update(double dt) {
                 m_resourceManager->PrintStats();
             }
             m_physics.LogStats();
+            FrameStats::Log();
+            const size_t dirtyAfter = m_scene.CountDirtyTransforms();
+            std::printf("[ECS] Entities: %zu | Transforms: %zu | MeshRenderers: %zu | Dirty (pre/post): %zu -> %zu%s\n",
+                        m_lastEntityCount,
+                        m_lastTransformCount,
+                        m_lastMeshRendererCount,
+                        m_lastDirtyBefore,
+                        dirtyAfter,
+                        dirtyAfter == 0 ? " [OK]" : " [WARN]");
         }
     }
     else
@@ -200,13 +577,55 @@ void Application::Update(double dt) {
         f9Latch = false;
     }
 
+    static bool f10Latch = false;
+    if (IsKeyDown(GLFW_KEY_F10))
+    {
+        if (!f10Latch)
+        {
+            f10Latch = true;
+            PhysicsBenchmark::PrintResult(PhysicsBenchmark::RunTriggerBenchmark());
+        }
+    }
+    else
+    {
+        f10Latch = false;
+    }
+
+    static bool f11Latch = false;
+    if (IsKeyDown(GLFW_KEY_F11))
+    {
+        if (!f11Latch)
+        {
+            f11Latch = true;
+            PhysicsBenchmark::RunDynamicStressBenchmark();
+            m_physics.LogStats();
+        }
+    }
+    else
+    {
+        f11Latch = false;
+    }
+
     static bool f5Latch = false;
-    if (m_window->IsKeyDown(GLFW_KEY_F5))
+    if (IsKeyDown(GLFW_KEY_F5))
     {
         if (!f5Latch)
         {
             f5Latch = true;
-            ReloadScene("recargada");
+            if (m_inputRecorder || m_inputReplay)
+            {
+                // La grabación sólo guarda la entrada: recargar rompería la reproducción.
+                std::printf("[App] F5 desactivado mientras se graba o reproduce la entrada\n");
+            }
+            else if (IsKeyDown(GLFW_KEY_LEFT_SHIFT) || IsKeyDown(GLFW_KEY_RIGHT_SHIFT))
+            {
+                // Shift+F5: recarga completa (reconstruye también el mundo de físicas)
+                ReloadScene("recargada");
+            }
+            else
+            {
+                ReloadSceneIncremental();
+            }
         }
     }
     else
@@ -221,26 +640,26 @@ void Application::Update(double dt) {
     const float shinySpd = 128.0f;                // unidades por segundo
 
     // Girar luz con flechas
-    if (m_window->IsKeyDown(GLFW_KEY_LEFT))  m_renderer->AddLightYawPitch(-rotSpeed*(float)dt, 0.0f);
-    if (m_window->IsKeyDown(GLFW_KEY_RIGHT)) m_renderer->AddLightYawPitch( rotSpeed*(float)dt, 0.0f);
-    if (m_window->IsKeyDown(GLFW_KEY_UP))    m_renderer->AddLightYawPitch(0.0f, -rotSpeed*(float)dt*0.5f);
-    if (m_window->IsKeyDown(GLFW_KEY_DOWN))  m_renderer->AddLightYawPitch(0.0f,  rotSpeed*(float)dt*0.5f);
+    if (IsKeyDown(GLFW_KEY_LEFT))  m_renderer->AddLightYawPitch(-rotSpeed*(float)dt, 0.0f);
+    if (IsKeyDown(GLFW_KEY_RIGHT)) m_renderer->AddLightYawPitch( rotSpeed*(float)dt, 0.0f);
+    if (IsKeyDown(GLFW_KEY_UP))    m_renderer->AddLightYawPitch(0.0f, -rotSpeed*(float)dt*0.5f);
+    if (IsKeyDown(GLFW_KEY_DOWN))  m_renderer->AddLightYawPitch(0.0f,  rotSpeed*(float)dt*0.5f);
 
     // Ambient Z/X
-    if (m_window->IsKeyDown(GLFW_KEY_Z)) m_renderer->AdjustAmbient(-ambSpeed*(float)dt);
-    if (m_window->IsKeyDown(GLFW_KEY_X)) m_renderer->AdjustAmbient( ambSpeed*(float)dt);
+    if (IsKeyDown(GLFW_KEY_Z)) m_renderer->AdjustAmbient(-ambSpeed*(float)dt);
+    if (IsKeyDown(GLFW_KEY_X)) m_renderer->AdjustAmbient( ambSpeed*(float)dt);
 
     // Spec intensity C/V
-    if (m_window->IsKeyDown(GLFW_KEY_C)) m_renderer->AdjustSpecIntensity(-specISpd*(float)dt);
-    if (m_window->IsKeyDown(GLFW_KEY_V)) m_renderer->AdjustSpecIntensity( specISpd*(float)dt);
+    if (IsKeyDown(GLFW_KEY_C)) m_renderer->AdjustSpecIntensity(-specISpd*(float)dt);
+    if (IsKeyDown(GLFW_KEY_V)) m_renderer->AdjustSpecIntensity( specISpd*(float)dt);
 
     // Shininess B/N
-    if (m_window->IsKeyDown(GLFW_KEY_B)) m_renderer->AdjustShininess(-shinySpd*(float)dt);
-    if (m_window->IsKeyDown(GLFW_KEY_N)) m_renderer->AdjustShininess( shinySpd*(float)dt);
+    if (IsKeyDown(GLFW_KEY_B)) m_renderer->AdjustShininess(-shinySpd*(float)dt);
+    if (IsKeyDown(GLFW_KEY_N)) m_renderer->AdjustShininess( shinySpd*(float)dt);
 
     // Reset R (con latch)
     static bool rLatch=false;
-    if (m_window->IsKeyDown(GLFW_KEY_R)) {
+    if (IsKeyDown(GLFW_KEY_R)) {
         if (!rLatch) { rLatch = true; m_renderer->ResetLightingDefaults(); }
     } else rLatch=false;
 
@@ -278,16 +697,27 @@ void Application::Update(double dt) {
     if (m_renderer)
     {
         m_renderer->SetPhysicsDebugInfo(physicsLine);
+
+        // El desglose por fases acompaña al overlay de físicas (F3)
+        std::vector<std::string> profileLines;
+        if (m_physics.IsDebugOverlayEnabled())
+        {
+            m_physics.GetProfiler().AppendHudLines(profileLines);
+        }
+        m_renderer->SetPhysicsProfileInfo(profileLines);
     }
 
-    m_lastDirtyBefore = m_scene.CountDirtyTransforms();
-    TransformSystem::Update(m_scene);
-    m_lastDirtyAfter = m_scene.CountDirtyTransforms();
+    // El sistema cuenta los dirty que procesa; los que quedan (sin raíz con
+    // Transform) sólo se cuentan al pedirlos con F9 o en la demo del ECS.
+    {
+        PROFILE_SCOPE("TransformSystem::Update");
+        m_lastDirtyBefore = TransformSystem::Update(m_scene);
+    }
 
 #ifdef SANDBOXCITY_ECS_DEMO
-    if (m_lastDirtyAfter != 0)
+    if (const size_t dirtyAfter = m_scene.CountDirtyTransforms(); dirtyAfter != 0)
     {
-        std::printf("[ECS] ALERTA: dirty tras Update = %zu\n", m_lastDirtyAfter);
+        std::printf("[ECS] ALERTA: dirty tras Update = %zu\n", dirtyAfter);
     }
 #endif
 
@@ -306,11 +736,17 @@ void Application::ReloadScene(const char* reason)
 
     const std::string sceneFile = m_scenePath.empty() ? std::string("assets/scenes/demo.json") : m_scenePath;
     std::string error;
-    if (!LoadSceneFromJson(sceneFile, m_scene, *m_resourceManager, &error))
+    Scene loaded;
+    if (!LoadSceneFromJson(sceneFile, loaded, *m_resourceManager, &error))
     {
         std::printf("[App] Error al cargar escena '%s': %s\n", sceneFile.c_str(), error.c_str());
         return;
     }
+    // La carga se sincroniza entera (OnSceneReloaded); sus cambios sobran
+    loaded.DiscardChanges();
+    m_authoredScene = loaded;
+    m_scene = std::move(loaded);
+    m_sceneCommands.Clear(); // hablan de ids de la escena anterior
 
     TransformSystem::Update(m_scene);
     m_lastEntityCount       = m_scene.GetEntityCount();
@@ -331,6 +767,106 @@ void Application::ReloadScene(const char* reason)
     }
 }
 
+void Application::ReloadSceneIncremental()
+{
+    if (!m_resourceManager || m_authoredScene.GetEntityCount() == 0 || m_physics.NeedsWorldRebuild())
+    {
+        ReloadScene("recargada");
+        return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const std::string sceneFile = m_scenePath.empty() ? std::string("assets/scenes/demo.json") : m_scenePath;
+    std::string error;
+    Scene loaded;
+    if (!LoadSceneFromJson(sceneFile, loaded, *m_resourceManager, &error))
+    {
+        std::printf("[App] Error al cargar escena '%s': %s\n", sceneFile.c_str(), error.c_str());
+        return;
+    }
+
+    const SceneDiffStats diff = ApplySceneDiff(m_authoredScene, loaded, m_scene);
+    loaded.DiscardChanges();
+    m_authoredScene = std::move(loaded);
+
+    m_physics.OnSceneEdited(m_scene);
+    TransformSystem::Update(m_scene);
+
+    const EntityId previousCj = m_cjEntity;
+    m_cjEntity = m_scene.FindEntityByLogicalId("cj");
+    m_checkpointEntity = m_scene.FindEntityByLogicalId("checkpoint");
+    if (m_cameraOrbit && m_cjEntity != previousCj)
+    {
+        m_cameraOrbit->OnSceneReloaded();
+    }
+
+    m_lastEntityCount       = m_scene.GetEntityCount();
+    m_lastTransformCount    = m_scene.GetTransformCount();
+    m_lastMeshRendererCount = m_scene.GetMeshRendererCount();
+
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::printf("[App] Escena recargada (incremental) en %.2f ms: +%zu -%zu ~%zu =%zu\n",
+                ms, diff.added, diff.removed, diff.changed, diff.unchanged);
+}
+
+void Application::WatchFiles()
+{
+    m_fileWatcher = std::make_unique<FileWatcher>();
+    std::printf("[App] Recarga en caliente: %s\n", m_fileWatcher->IsUsingInotify() ? "inotify" : "polling");
+
+    // Los Reload*IfNeeded comparan la fecha del fichero, así que una
+    // notificación sin cambio real no recarga nada.
+    if (!m_input.GetBindingPath().empty())
+    {
+        m_fileWatcher->WatchFile(m_input.GetBindingPath(), [this](const std::filesystem::path&)
+        {
+            m_input.ReloadIfChanged();
+        });
+    }
+    if (!m_physics.GetConfigPath().empty())
+    {
+        m_fileWatcher->WatchFile(m_physics.GetConfigPath(), [this](const std::filesystem::path&)
+        {
+            if (m_physics.ReloadConfigIfNeeded(m_scene))
+            {
+                m_fixedDt = m_physics.GetFixedStep();
+            }
+        });
+    }
+    if (m_cameraOrbit && !m_cameraOrbit->GetConfigPath().empty())
+    {
+        m_fileWatcher->WatchFile(m_cameraOrbit->GetConfigPath(), [this](const std::filesystem::path&)
+        {
+            m_cameraOrbit->ReloadConfigIfNeeded();
+        });
+    }
+    if (m_resourceManager && !m_resourceManager->GetAssetsRoot().empty())
+    {
+        m_fileWatcher->WatchDirectory(m_resourceManager->GetAssetsRoot(), [this](const std::filesystem::path& path)
+        {
+            OnAssetChanged(path.string());
+        });
+    }
+}
+
+void Application::OnAssetChanged(const std::string& absolutePath)
+{
+    // Sólo lo que ya está en caché; un asset sin usar se cargará cuando se pida.
+    if (!m_resourceManager || !m_resourceManager->IsLoaded(absolutePath))
+    {
+        return;
+    }
+    // La recarga destruye buffers/texturas que el paquete en grabación puede usar
+    if (m_renderer)
+    {
+        m_renderer->WaitForSubmission();
+    }
+    if (m_resourceManager->Reload(absolutePath))
+    {
+        std::printf("[HotReload] Recargado: %s\n", absolutePath.c_str());
+    }
+}
+
 void Application::PrintSceneSummary(const char* reason)
 {
     const char* label = reason ? reason : "actualizada";
@@ -354,11 +890,18 @@ void Application::Render() {
     }
     if (!m_renderer) return;
 
-    m_renderer->BeginFrame(&m_scene);
+    PROFILE_SCOPE("Render");
+    {
+        FrameStats::ScopedStage stage(FrameStage::Render);
+        m_renderer->BeginFrame(&m_scene);
 
-    const PhysicsDebugLineBuffer& debugLines = m_physics.GetDebugLines();
-    m_renderer->DrawDebugLines(debugLines);
+        float viewProj[16];
+        m_renderer->GetViewProjection(viewProj);
+        const PhysicsDebugLineBuffer& debugLines = m_physics.BuildDebugLines(viewProj);
+        m_renderer->DrawDebugLines(debugLines);
+    }
 
+    FrameStats::ScopedStage stage(FrameStage::Present);
     m_renderer->EndFrame();
 }
 
@@ -395,5 +938,11 @@ std::string Application::GetEntityLabel(EntityId id) const
         }
     }
 
-    return std::string("#") + std::to_string(id);
+    // "#índice" y la generación si el slot ya se ha reutilizado
+    std::string label = std::string("#") + std::to_string(EntityIndex(id));
+    if (const uint32_t generation = EntityGeneration(id); generation != 0)
+    {
+        label += "/g" + std::to_string(generation);
+    }
+    return label;
 }
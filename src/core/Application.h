@@ -1,9 +1,12 @@
 #pragma once
 #include <memory>
 #include <string>
+#include <vector>
 #include <cstddef>
+#include <cstdint>
 
 #include "../ecs/Scene.h"
+#include "../ecs/SceneCommandBuffer.h"
 #include "../input/InputSystem.h"
 #include "../physics/PhysicsSystem.h"
 
@@ -13,33 +16,82 @@ class Window;
 class Renderer;
 class Camera;
 class CameraOrbitController;
+class InputScript;
+class InputRecorder;
+class InputReplay;
+class FileWatcher;
 namespace resource { class ResourceManager; }
 
+struct ApplicationOptions
+{
+    // Sin ventana, con bgfx Noop y dt fijo; sale tras 'frames' frames y
+    // escribe un informe de tiempos en 'reportPath'.
+    bool        headless = false;
+    uint64_t    frames = 600;
+    double      timestep = 1.0 / 60.0;
+    uint32_t    width = 1280;
+    uint32_t    height = 720;
+    std::string scenePath = "assets/scenes/demo.json";
+    std::string inputScriptPath; // InputScript opcional (headless)
+    std::string recordInputPath; // graba la entrada por frame (InputRecorder)
+    std::string replayInputPath; // reproduce una grabación; fija también el dt
+    std::string reportPath = "headless_report.json";
+};
+
 class Application {
 public:
-    Application();
+    explicit Application(const ApplicationOptions& options = ApplicationOptions{});
     ~Application();
     void Run();
 
 private:
     void Update(double dt);
     void Render();
+    bool IsKeyDown(int glfwKey) const;
+    float GetViewportAspect() const;
+    void WriteHeadlessReport(double wallSeconds) const;
+    void FinishInputReplay();
+    // Hash de la pose de cuerpos y personajes para comparar grabación y reproducción.
+    uint64_t ComputeSimulationChecksum() const;
     void ReloadScene(const char* reason);
+    // Aplica sólo lo que ha cambiado en el JSON desde la última carga.
+    void ReloadSceneIncremental();
+    void WatchFiles();
+    void OnAssetChanged(const std::string& absolutePath);
     void PrintSceneSummary(const char* reason);
     void OnTriggerEvent(const PhysicsSystem::TriggerEvent& evt);
     std::string GetEntityLabel(EntityId id) const;
 
 private:
-    std::unique_ptr<Window>                      m_window;
+    ApplicationOptions                           m_options;
+    std::unique_ptr<Window>                      m_window; // nulo en headless
     std::unique_ptr<Renderer>                    m_renderer;
     std::unique_ptr<Camera>                      m_camera;
     std::unique_ptr<CameraOrbitController>       m_cameraOrbit;
     std::unique_ptr<resource::ResourceManager>   m_resourceManager;
+    std::unique_ptr<FileWatcher>                 m_fileWatcher; // nulo en headless
 
     InputSystem   m_input;
     PhysicsSystem m_physics;
+    std::unique_ptr<InputScript> m_inputScript;
+
+    // Handles de la línea de depuración de entrada del HUD
+    struct HudInputIds
+    {
+        InputId moveForward;
+        InputId moveRight;
+        InputId lookX;
+        InputId lookY;
+        InputId jump;
+        InputId sprint;
+    } m_hudInputIds;
+    std::unique_ptr<InputRecorder> m_inputRecorder;
+    std::unique_ptr<InputReplay>   m_inputReplay;
 
     Scene     m_scene;
+    Scene     m_authoredScene; // última carga del JSON, base de la recarga incremental
+    // Cambios estructurales de los sistemas; se aplican tras los pasos fijos
+    SceneCommandQueue m_sceneCommands;
     std::string m_scenePath;
 
     EntityId m_cjEntity = kInvalidEntity;
@@ -49,11 +101,13 @@ private:
     size_t m_lastTransformCount     = 0;
     size_t m_lastMeshRendererCount  = 0;
     size_t m_lastDirtyBefore        = 0;
-    size_t m_lastDirtyAfter         = 0;
 
     bool   m_running = true;
     double m_accum   = 0.0;
     double m_fixedDt = 1.0 / 60.0;
 
     double m_statusAccum = 0.0;
+
+    uint64_t           m_frameIndex = 0;
+    std::vector<float> m_headlessFrameMs;
 };
@@ -1,69 +1,353 @@
 #pragma once
 
-#include <functional>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
-#include <typeindex>
-#include <typeinfo>
-#include <unordered_map>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+// Índice denso por tipo de evento, asignado la primera vez que se usa el tipo.
+// Publish indexa un vector con él en lugar de buscar std::type_index en un mapa.
+namespace EventTypeIds
+{
+    inline uint32_t Next()
+    {
+        static std::atomic<uint32_t> s_next{0};
+        return s_next.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    template<typename Event>
+    uint32_t Get()
+    {
+        static const uint32_t s_id = Next();
+        return s_id;
+    }
+}
+
+// Token para Unsubscribe. Un token por defecto no es válido.
+struct EventSubscription
+{
+    static constexpr uint32_t kInvalid = UINT32_MAX;
+
+    uint32_t type = kInvalid;
+    uint32_t id   = kInvalid;
+
+    bool IsValid() const { return type != kInvalid; }
+};
+
+// Callable con almacenamiento interno fijo (sin heap). El tamaño cubre una
+// lambda con varias capturas o un std::function; lo que no quepa no compila.
+template<typename Event>
+class EventHandler
+{
+public:
+    static constexpr size_t kStorageSize = 64;
+
+    EventHandler() = default;
+
+    template<typename Fn, typename = std::enable_if_t<!std::is_same_v<std::decay_t<Fn>, EventHandler>>>
+    explicit EventHandler(Fn&& fn)
+    {
+        using Callable = std::decay_t<Fn>;
+        static_assert(sizeof(Callable) <= kStorageSize, "Handler demasiado grande para EventHandler");
+        static_assert(alignof(Callable) <= alignof(std::max_align_t), "Alineación de handler no soportada");
+        static_assert(std::is_nothrow_move_constructible_v<Callable>, "El handler debe poder moverse sin excepciones");
+
+        new (&m_storage) Callable(std::forward<Fn>(fn));
+        m_invoke = [](void* storage, const Event& event)
+        {
+            (*static_cast<Callable*>(storage))(event);
+        };
+        m_manage = [](void* dst, void* src)
+        {
+            if (dst)
+            {
+                new (dst) Callable(std::move(*static_cast<Callable*>(src)));
+            }
+            static_cast<Callable*>(src)->~Callable();
+        };
+    }
+
+    EventHandler(EventHandler&& other) noexcept
+    {
+        MoveFrom(other);
+    }
+
+    EventHandler& operator=(EventHandler&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Reset();
+            MoveFrom(other);
+        }
+        return *this;
+    }
+
+    EventHandler(const EventHandler&) = delete;
+    EventHandler& operator=(const EventHandler&) = delete;
+
+    ~EventHandler()
+    {
+        Reset();
+    }
+
+    void operator()(const Event& event) { m_invoke(&m_storage, event); }
+    explicit operator bool() const { return m_invoke != nullptr; }
+
+    void Reset()
+    {
+        if (m_manage)
+        {
+            m_manage(nullptr, &m_storage);
+        }
+        m_invoke = nullptr;
+        m_manage = nullptr;
+    }
+
+private:
+    void MoveFrom(EventHandler& other)
+    {
+        if (other.m_manage)
+        {
+            // Mueve al almacenamiento propio y destruye el original
+            other.m_manage(&m_storage, &other.m_storage);
+        }
+        m_invoke = other.m_invoke;
+        m_manage = other.m_manage;
+        other.m_invoke = nullptr;
+        other.m_manage = nullptr;
+    }
+
+    alignas(std::max_align_t) unsigned char m_storage[kStorageSize];
+    void (*m_invoke)(void*, const Event&) = nullptr;
+    void (*m_manage)(void* dst, void* src) = nullptr; // dst nulo = sólo destruir
+};
+
+// Bus de eventos tipado.
+//  - Publish entrega en el acto a los suscriptores, en orden de suscripción.
+//  - Enqueue copia el evento a un buffer contiguo por tipo y DispatchQueued
+//    los entrega todos en el punto de sincronización (tipo a tipo, en orden).
+// Tras el calentamiento ni Publish ni Enqueue reservan memoria. Suscribirse o
+// darse de baja desde un handler es seguro: los cambios se aplican al acabar
+// la entrega en curso.
 class EventBus
 {
 public:
-    template<typename Event>
-    void Subscribe(std::function<void(const Event&)> callback)
+    template<typename Event, typename Fn>
+    EventSubscription Subscribe(Fn&& handler)
     {
-        auto& list = GetOrCreateList<Event>();
-        list.callbacks.push_back(std::move(callback));
+        Channel<Event>& channel = GetOrCreateChannel<Event>();
+        const uint32_t id = m_nextSubscriptionId++;
+        channel.Add(id, EventHandler<Event>(std::forward<Fn>(handler)));
+        return EventSubscription{EventTypeIds::Get<Event>(), id};
+    }
+
+    // Invalida 'subscription'. Tokens ya usados o por defecto se ignoran.
+    void Unsubscribe(EventSubscription& subscription)
+    {
+        if (subscription.IsValid() && subscription.type < m_channels.size() && m_channels[subscription.type])
+        {
+            m_channels[subscription.type]->Remove(subscription.id);
+        }
+        subscription = EventSubscription{};
     }
 
     template<typename Event>
     void Publish(const Event& event)
     {
-        auto it = m_subscribers.find(std::type_index(typeid(Event)));
-        if (it == m_subscribers.end())
+        if (Channel<Event>* channel = FindChannel<Event>())
         {
-            return;
+            channel->Dispatch(event);
         }
-        auto* basePtr = static_cast<HandlerList<Event>*>(it->second.get());
-        for (auto& cb : basePtr->callbacks)
+    }
+
+    // Sin suscriptores el evento se descarta sin copiarlo.
+    template<typename Event>
+    void Enqueue(const Event& event)
+    {
+        static_assert(std::is_copy_constructible_v<Event>, "Enqueue necesita eventos copiables");
+        Channel<Event>* channel = FindChannel<Event>();
+        if (channel && channel->HasHandlers())
         {
-            cb(event);
+            if (channel->queued.empty())
+            {
+                m_pendingChannels.push_back(EventTypeIds::Get<Event>());
+            }
+            channel->queued.push_back(event);
         }
     }
 
+    // Entrega lo encolado. Lo que se encole durante la entrega espera al
+    // siguiente DispatchQueued, también en canales que aún no se han entregado:
+    // se retiran las colas de todos los canales antes de entregar ninguno.
+    void DispatchQueued()
+    {
+        m_dispatchingChannels.swap(m_pendingChannels);
+        for (uint32_t type : m_dispatchingChannels)
+        {
+            m_channels[type]->TakeQueued();
+        }
+        for (uint32_t type : m_dispatchingChannels)
+        {
+            m_channels[type]->DispatchTaken();
+        }
+        m_dispatchingChannels.clear();
+    }
+
+    template<typename Event>
+    size_t GetSubscriberCount() const
+    {
+        const uint32_t type = EventTypeIds::Get<Event>();
+        return type < m_channels.size() && m_channels[type] ? m_channels[type]->CountHandlers() : 0;
+    }
+
     void Clear()
     {
-        m_subscribers.clear();
+        m_channels.clear();
+        m_pendingChannels.clear();
     }
 
 private:
-    struct HandlerListBase
+    struct ChannelBase
     {
-        virtual ~HandlerListBase() = default;
+        virtual ~ChannelBase() = default;
+        virtual void   Remove(uint32_t id) = 0;
+        virtual void   TakeQueued() = 0;
+        virtual void   DispatchTaken() = 0;
+        virtual size_t CountHandlers() const = 0;
     };
 
     template<typename Event>
-    struct HandlerList : HandlerListBase
+    struct Channel : ChannelBase
     {
-        std::vector<std::function<void(const Event&)>> callbacks;
+        struct Slot
+        {
+            uint32_t            id = 0;
+            bool                alive = true;
+            EventHandler<Event> handler;
+        };
+
+        std::vector<Slot>  slots;
+        std::vector<Slot>  added;      // suscritos durante una entrega
+        std::vector<Event> queued;
+        std::vector<Event> dispatching;
+        uint32_t           depth = 0;
+        bool               hasDead = false;
+
+        void Add(uint32_t id, EventHandler<Event> handler)
+        {
+            (depth > 0 ? added : slots).push_back(Slot{id, true, std::move(handler)});
+        }
+
+        void Remove(uint32_t id) override
+        {
+            for (std::vector<Slot>* list : {&slots, &added})
+            {
+                for (Slot& slot : *list)
+                {
+                    if (slot.id == id && slot.alive)
+                    {
+                        slot.alive = false;
+                        hasDead = true;
+                    }
+                }
+            }
+            if (depth == 0)
+            {
+                Compact();
+            }
+        }
+
+        bool HasHandlers() const { return !slots.empty() || !added.empty(); }
+
+        size_t CountHandlers() const override
+        {
+            size_t count = 0;
+            for (const std::vector<Slot>* list : {&slots, &added})
+            {
+                for (const Slot& slot : *list)
+                {
+                    count += slot.alive ? 1 : 0;
+                }
+            }
+            return count;
+        }
+
+        void Dispatch(const Event& event)
+        {
+            ++depth;
+            // Índice y tamaño fijos: 'slots' no crece durante la entrega
+            const size_t count = slots.size();
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (slots[i].alive)
+                {
+                    slots[i].handler(event);
+                }
+            }
+            if (--depth == 0)
+            {
+                Compact();
+            }
+        }
+
+        void TakeQueued() override
+        {
+            dispatching.swap(queued);
+        }
+
+        void DispatchTaken() override
+        {
+            for (const Event& event : dispatching)
+            {
+                Dispatch(event);
+            }
+            dispatching.clear();
+        }
+
+        void Compact()
+        {
+            if (hasDead)
+            {
+                std::erase_if(slots, [](const Slot& slot) { return !slot.alive; });
+                std::erase_if(added, [](const Slot& slot) { return !slot.alive; });
+                hasDead = false;
+            }
+            for (Slot& slot : added)
+            {
+                slots.push_back(std::move(slot));
+            }
+            added.clear();
+        }
     };
 
     template<typename Event>
-    HandlerList<Event>& GetOrCreateList()
+    Channel<Event>* FindChannel()
+    {
+        const uint32_t type = EventTypeIds::Get<Event>();
+        return type < m_channels.size() ? static_cast<Channel<Event>*>(m_channels[type].get()) : nullptr;
+    }
+
+    template<typename Event>
+    Channel<Event>& GetOrCreateChannel()
     {
-        const std::type_index typeIdx(typeid(Event));
-        auto it = m_subscribers.find(typeIdx);
-        if (it == m_subscribers.end())
+        const uint32_t type = EventTypeIds::Get<Event>();
+        if (type >= m_channels.size())
         {
-            auto list = std::make_unique<HandlerList<Event>>();
-            auto* ptr = list.get();
-            m_subscribers.emplace(typeIdx, std::move(list));
-            return *ptr;
+            m_channels.resize(type + 1);
         }
-        return *static_cast<HandlerList<Event>*>(it->second.get());
+        if (!m_channels[type])
+        {
+            m_channels[type] = std::make_unique<Channel<Event>>();
+        }
+        return static_cast<Channel<Event>&>(*m_channels[type]);
     }
 
-    std::unordered_map<std::type_index, std::unique_ptr<HandlerListBase>> m_subscribers;
+    std::vector<std::unique_ptr<ChannelBase>> m_channels; // por EventTypeIds::Get
+    std::vector<uint32_t>                     m_pendingChannels;
+    std::vector<uint32_t>                     m_dispatchingChannels;
+    uint32_t                                  m_nextSubscriptionId = 0;
 };
-
@@ -0,0 +1,351 @@
+#include "FileWatcher.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cstdio>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    std::filesystem::path NormalizeWatchPath(const std::filesystem::path& path)
+    {
+        std::error_code ec;
+        std::filesystem::path result = std::filesystem::weakly_canonical(std::filesystem::absolute(path, ec), ec);
+        if (ec)
+        {
+            result = path.lexically_normal();
+        }
+        return result;
+    }
+
+#if defined(__linux__)
+    constexpr uint32_t kNativeMask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE;
+    constexpr int      kNativePollTimeoutMs = 100; // latencia máxima para parar el hilo
+#endif
+}
+
+FileWatcher::FileWatcher()
+{
+#if defined(__linux__)
+    m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotifyFd < 0)
+    {
+        std::printf("[FileWatcher] inotify no disponible (errno %d); se usa polling cada %lld ms\n",
+                    errno, static_cast<long long>(kPollInterval.count()));
+    }
+#endif
+    m_thread = std::thread(&FileWatcher::ThreadLoop, this);
+}
+
+FileWatcher::~FileWatcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_stopCv.notify_all();
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+#if defined(__linux__)
+    if (m_inotifyFd >= 0)
+    {
+        close(m_inotifyFd);
+    }
+#endif
+}
+
+FileWatcher::WatchId FileWatcher::WatchFile(const std::filesystem::path& file, Callback callback)
+{
+    return AddWatch(file, false, std::move(callback));
+}
+
+FileWatcher::WatchId FileWatcher::WatchDirectory(const std::filesystem::path& directory, Callback callback)
+{
+    return AddWatch(directory, true, std::move(callback));
+}
+
+FileWatcher::WatchId FileWatcher::AddWatch(const std::filesystem::path& path, bool directory, Callback callback)
+{
+    const std::filesystem::path normalized = NormalizeWatchPath(path);
+    std::error_code ec;
+    if (directory ? !std::filesystem::is_directory(normalized, ec) : !std::filesystem::exists(normalized, ec))
+    {
+        std::printf("[FileWatcher] No existe: %s\n", normalized.string().c_str());
+        return kInvalidWatch;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const WatchId id = m_nextId++;
+    m_watches.push_back(Watch{id, normalized, directory, std::move(callback)});
+
+#if defined(__linux__)
+    if (m_inotifyFd >= 0)
+    {
+        // Se vigila el directorio y no el fichero: los editores que guardan
+        // escribiendo otro fichero y renombrando cambian el inodo.
+        AddNativeWatch(directory ? normalized : normalized.parent_path(), directory);
+    }
+#endif
+    return id;
+}
+
+void FileWatcher::Unwatch(WatchId id)
+{
+    // Los watches de inotify se mantienen hasta destruir el vigilante; los
+    // cambios que ya no casan con ningún Watch se descartan al despachar.
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::erase_if(m_watches, [id](const Watch& watch) { return watch.id == id; });
+}
+
+void FileWatcher::SetDebounce(std::chrono::milliseconds debounce)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_debounce = debounce;
+}
+
+bool FileWatcher::Matches(const Watch& watch, const std::filesystem::path& changed)
+{
+    if (!watch.directory)
+    {
+        return changed == watch.path;
+    }
+    // Prefijo por componentes: "assets/tex" no casa con "assets/textures/a.png"
+    auto [watchIt, changedIt] = std::mismatch(watch.path.begin(), watch.path.end(), changed.begin(), changed.end());
+    return watchIt == watch.path.end() && changedIt != changed.end();
+}
+
+void FileWatcher::QueueChange(const std::filesystem::path& path)
+{
+    // Llamado con m_mutex tomado
+    m_pending[path.string()] = Clock::now();
+    m_hasPending.store(true, std::memory_order_release);
+}
+
+size_t FileWatcher::DispatchChanges()
+{
+    if (!m_hasPending.load(std::memory_order_acquire))
+    {
+        return 0;
+    }
+    PROFILE_SCOPE("FileWatcher::Dispatch");
+
+    // Los callbacks se llaman sin el mutex: pueden añadir o quitar watches.
+    std::vector<std::pair<Callback, std::filesystem::path>> calls;
+    size_t notified = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const Clock::time_point now = Clock::now();
+        for (auto it = m_pending.begin(); it != m_pending.end();)
+        {
+            if (now - it->second < m_debounce)
+            {
+                ++it;
+                continue;
+            }
+
+            const std::filesystem::path changed(it->first);
+            for (const Watch& watch : m_watches)
+            {
+                if (Matches(watch, changed))
+                {
+                    calls.emplace_back(watch.callback, changed);
+                }
+            }
+            ++notified;
+            it = m_pending.erase(it);
+        }
+        m_hasPending.store(!m_pending.empty(), std::memory_order_release);
+    }
+
+    for (auto& [callback, path] : calls)
+    {
+        callback(path);
+    }
+    return notified;
+}
+
+void FileWatcher::ThreadLoop()
+{
+    Profiler::SetThreadName("FileWatcher");
+
+#if defined(__linux__)
+    if (m_inotifyFd >= 0)
+    {
+        pollfd fd{m_inotifyFd, POLLIN, 0};
+        for (;;)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_stop)
+                {
+                    return;
+                }
+            }
+            const int ready = poll(&fd, 1, kNativePollTimeoutMs);
+            if (ready > 0 && (fd.revents & POLLIN))
+            {
+                ReadNativeEvents();
+            }
+        }
+    }
+#endif
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stop)
+    {
+        lock.unlock();
+        PollOnce();
+        lock.lock();
+        m_stopCv.wait_for(lock, kPollInterval, [this]() { return m_stop; });
+    }
+}
+
+void FileWatcher::PollOnce()
+{
+    std::vector<Watch> watches;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        watches.reserve(m_watches.size());
+        for (const Watch& watch : m_watches)
+        {
+            watches.push_back(Watch{watch.id, watch.path, watch.directory, nullptr});
+        }
+    }
+
+    std::vector<std::filesystem::path> changed;
+    std::unordered_map<WatchId, Snapshot> snapshots;
+    for (const Watch& watch : watches)
+    {
+        Snapshot& current = snapshots[watch.id];
+        std::error_code ec;
+        if (watch.directory)
+        {
+            for (auto it = std::filesystem::recursive_directory_iterator(watch.path, ec);
+                 !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+            {
+                if (it->is_regular_file(ec))
+                {
+                    current[it->path().string()] = it->last_write_time(ec);
+                }
+            }
+        }
+        else
+        {
+            const auto writeTime = std::filesystem::last_write_time(watch.path, ec);
+            if (!ec)
+            {
+                current[watch.path.string()] = writeTime;
+            }
+        }
+
+        // La primera pasada de un watch sólo toma la referencia
+        auto previous = m_pollSnapshots.find(watch.id);
+        if (previous == m_pollSnapshots.end())
+        {
+            continue;
+        }
+        for (const auto& [path, writeTime] : current)
+        {
+            auto old = previous->second.find(path);
+            if (old == previous->second.end() || old->second != writeTime)
+            {
+                changed.emplace_back(path);
+            }
+        }
+    }
+    // Sustituir también descarta los watches que ya no existen
+    m_pollSnapshots = std::move(snapshots);
+
+    if (!changed.empty())
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const std::filesystem::path& path : changed)
+        {
+            QueueChange(path);
+        }
+    }
+}
+
+#if defined(__linux__)
+void FileWatcher::AddNativeWatch(const std::filesystem::path& directory, bool recursive)
+{
+    // Llamado con m_mutex tomado
+    const int wd = inotify_add_watch(m_inotifyFd, directory.c_str(), kNativeMask);
+    if (wd < 0)
+    {
+        std::printf("[FileWatcher] inotify_add_watch falló en %s (errno %d)\n", directory.string().c_str(), errno);
+        return;
+    }
+
+    // inotify devuelve el mismo wd para el mismo directorio
+    NativeDirectory& entry = m_nativeDirectories[wd];
+    const bool wasRecursive = entry.recursive;
+    entry.path = directory;
+    entry.recursive = entry.recursive || recursive;
+
+    if (recursive && !wasRecursive)
+    {
+        std::error_code ec;
+        for (auto it = std::filesystem::directory_iterator(directory, ec);
+             !ec && it != std::filesystem::directory_iterator(); it.increment(ec))
+        {
+            if (it->is_directory(ec))
+            {
+                AddNativeWatch(it->path(), true);
+            }
+        }
+    }
+}
+
+void FileWatcher::ReadNativeEvents()
+{
+    alignas(inotify_event) char buffer[16 * 1024];
+    for (;;)
+    {
+        const ssize_t length = read(m_inotifyFd, buffer, sizeof(buffer));
+        if (length <= 0)
+        {
+            // EAGAIN: no queda nada que leer
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (ssize_t offset = 0; offset < length;)
+        {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+            if (event->mask & IN_Q_OVERFLOW)
+            {
+                std::printf("[FileWatcher] Cola de inotify desbordada; se pierden cambios\n");
+                continue;
+            }
+            auto it = m_nativeDirectories.find(event->wd);
+            if (it == m_nativeDirectories.end() || event->len == 0)
+            {
+                continue;
+            }
+
+            const std::filesystem::path path = it->second.path / event->name;
+            if (event->mask & IN_ISDIR)
+            {
+                // Directorio nuevo dentro de un watch recursivo: se vigila también
+                if (it->second.recursive && (event->mask & (IN_CREATE | IN_MOVED_TO)))
+                {
+                    AddNativeWatch(path, true);
+                }
+                continue;
+            }
+            QueueChange(path);
+        }
+    }
+}
+#endif
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Vigila ficheros y directorios desde un hilo propio y entrega los cambios en
+// el hilo que llama a DispatchChanges (una vez por frame, en el hilo principal).
+//  - Linux: inotify sobre los directorios (un guardado por renombrado del
+//    editor también se detecta). Sin inotify o en otra plataforma se hace
+//    polling de last_write_time cada kPollInterval en el hilo del vigilante.
+//  - Debounce: un fichero se notifica cuando lleva 'debounce' sin cambios, así
+//    un guardado en varias escrituras produce una sola notificación.
+class FileWatcher
+{
+public:
+    using WatchId = uint32_t;
+    static constexpr WatchId kInvalidWatch = 0;
+    // Recibe la ruta absoluta del fichero que ha cambiado.
+    using Callback = std::function<void(const std::filesystem::path& path)>;
+
+    static constexpr std::chrono::milliseconds kDefaultDebounce{100};
+    static constexpr std::chrono::milliseconds kPollInterval{250};
+
+    FileWatcher();
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    // Devuelven kInvalidWatch si la ruta no existe.
+    WatchId WatchFile(const std::filesystem::path& file, Callback callback);
+    // Recursivo: incluye los subdirectorios creados después.
+    WatchId WatchDirectory(const std::filesystem::path& directory, Callback callback);
+    void Unwatch(WatchId id);
+
+    // Llama a los callbacks de los cambios ya estabilizados. Sin cambios
+    // pendientes sólo cuesta una lectura atómica. Devuelve los ficheros notificados.
+    size_t DispatchChanges();
+
+    void SetDebounce(std::chrono::milliseconds debounce);
+    bool IsUsingInotify() const { return m_inotifyFd >= 0; }
+
+private:
+    struct Watch
+    {
+        WatchId               id = kInvalidWatch;
+        std::filesystem::path path;
+        bool                  directory = false;
+        Callback              callback;
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    WatchId AddWatch(const std::filesystem::path& path, bool directory, Callback callback);
+    static bool Matches(const Watch& watch, const std::filesystem::path& changed);
+    void QueueChange(const std::filesystem::path& path);
+
+    void ThreadLoop();
+    void PollOnce();
+#if defined(__linux__)
+    void AddNativeWatch(const std::filesystem::path& directory, bool recursive);
+    void ReadNativeEvents();
+#endif
+
+private:
+    std::mutex                                  m_mutex;
+    std::vector<Watch>                          m_watches;
+    std::unordered_map<std::string, Clock::time_point> m_pending; // ruta -> último cambio
+    std::atomic<bool>                           m_hasPending{false};
+    std::chrono::milliseconds                   m_debounce = kDefaultDebounce;
+    WatchId                                     m_nextId = 1;
+
+    // inotify: descriptor por directorio vigilado (bajo m_mutex)
+    struct NativeDirectory
+    {
+        std::filesystem::path path;
+        bool                  recursive = false;
+    };
+    int                                         m_inotifyFd = -1;
+    std::unordered_map<int, NativeDirectory>    m_nativeDirectories;
+
+    // Polling: última fecha vista por watch y fichero (sólo el hilo del vigilante)
+    using Snapshot = std::unordered_map<std::string, std::filesystem::file_time_type>;
+    std::unordered_map<WatchId, Snapshot>       m_pollSnapshots;
+
+    std::thread                                 m_thread;
+    std::condition_variable                     m_stopCv;
+    bool                                        m_stop = false;
+};
@@ -0,0 +1,169 @@
+#include "FrameStats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+    constexpr double kHitchFactor = 2.0;
+
+    double Percentile(std::vector<float>& values, double p)
+    {
+        const size_t index = std::min(values.size() - 1,
+                                      static_cast<size_t>(std::ceil(p * static_cast<double>(values.size()))) - 1);
+        std::nth_element(values.begin(), values.begin() + index, values.end());
+        return values[index];
+    }
+}
+
+void FrameStats::AddStageTime(FrameStage stage, double ms)
+{
+    if (stage == FrameStage::Count)
+    {
+        return;
+    }
+    s_currentStageMs[static_cast<size_t>(stage)] += ms;
+}
+
+void FrameStats::EndFrame(double frameMs)
+{
+    const bool hitch = s_count > 0 && frameMs > kHitchFactor * (s_frameSum / static_cast<double>(s_count));
+
+    // Al llenar la ventana se sobrescribe la muestra más antigua.
+    if (s_count == kWindow)
+    {
+        s_frameSum -= s_frameMs[s_head];
+        if (s_hitch[s_head])
+        {
+            --s_hitchesInWindow;
+        }
+    }
+
+    s_frameMs[s_head] = static_cast<float>(frameMs);
+    s_hitch[s_head] = hitch;
+    for (size_t i = 0; i < kStageCount; ++i)
+    {
+        s_stageMs[i][s_head] = static_cast<float>(s_currentStageMs[i]);
+    }
+    s_currentStageMs.fill(0.0);
+
+    s_frameSum += frameMs;
+    if (hitch)
+    {
+        ++s_hitchesInWindow;
+        ++s_totalHitches;
+    }
+
+    s_head = (s_head + 1) % kWindow;
+    s_count = std::min(s_count + 1, kWindow);
+}
+
+void FrameStats::Reset()
+{
+    s_head = 0;
+    s_count = 0;
+    s_frameSum = 0.0;
+    s_hitchesInWindow = 0;
+    s_totalHitches = 0;
+    s_currentStageMs.fill(0.0);
+    s_hitch.fill(false);
+}
+
+FrameTimeSummary FrameStats::Summarize(const std::array<float, kWindow>& samples)
+{
+    FrameTimeSummary summary;
+    if (s_count == 0)
+    {
+        return summary;
+    }
+
+    static std::vector<float> scratch;
+    scratch.assign(samples.begin(), samples.begin() + s_count);
+
+    double sum = 0.0;
+    float maxValue = 0.0f;
+    for (float value : scratch)
+    {
+        sum += value;
+        maxValue = std::max(maxValue, value);
+    }
+
+    summary.avgMs = sum / static_cast<double>(s_count);
+    summary.maxMs = maxValue;
+    summary.p50Ms = Percentile(scratch, 0.50);
+    summary.p95Ms = Percentile(scratch, 0.95);
+    summary.p99Ms = Percentile(scratch, 0.99);
+    return summary;
+}
+
+FrameTimeSummary FrameStats::GetFrameSummary()
+{
+    return Summarize(s_frameMs);
+}
+
+FrameTimeSummary FrameStats::GetStageSummary(FrameStage stage)
+{
+    if (stage == FrameStage::Count)
+    {
+        return {};
+    }
+    return Summarize(s_stageMs[static_cast<size_t>(stage)]);
+}
+
+uint32_t FrameStats::GetHitchCount()
+{
+    return s_hitchesInWindow;
+}
+
+uint64_t FrameStats::GetTotalHitchCount()
+{
+    return s_totalHitches;
+}
+
+size_t FrameStats::GetSampleCount()
+{
+    return s_count;
+}
+
+double FrameStats::GetAverageFps()
+{
+    if (s_count == 0 || s_frameSum <= 0.0)
+    {
+        return 0.0;
+    }
+    return 1000.0 * static_cast<double>(s_count) / s_frameSum;
+}
+
+const char* FrameStats::GetStageName(FrameStage stage)
+{
+    switch (stage)
+    {
+    case FrameStage::Input:   return "input";
+    case FrameStage::Update:  return "update";
+    case FrameStage::Render:  return "render";
+    case FrameStage::Present: return "present";
+    default:                  return "?";
+    }
+}
+
+void FrameStats::Log()
+{
+    const FrameTimeSummary frame = GetFrameSummary();
+    std::printf("[Frame] samples=%zu fps=%.1f avg=%.3fms p50=%.3fms p95=%.3fms p99=%.3fms max=%.3fms hitches=%u (total %llu)\n",
+                s_count,
+                GetAverageFps(),
+                frame.avgMs, frame.p50Ms, frame.p95Ms, frame.p99Ms, frame.maxMs,
+                s_hitchesInWindow,
+                static_cast<unsigned long long>(s_totalHitches));
+
+    for (size_t i = 0; i < kStageCount; ++i)
+    {
+        const FrameStage stage = static_cast<FrameStage>(i);
+        const FrameTimeSummary summary = GetStageSummary(stage);
+        std::printf("[Frame]   %-8s avg=%.3fms p50=%.3fms p95=%.3fms p99=%.3fms max=%.3fms\n",
+                    GetStageName(stage),
+                    summary.avgMs, summary.p50Ms, summary.p95Ms, summary.p99Ms, summary.maxMs);
+    }
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+enum class FrameStage : uint8_t
+{
+    Input,
+    Update,   // bucle de paso fijo (cámara, físicas, transforms)
+    Render,   // generación de draw calls
+    Present,  // bgfx::frame
+    Count,
+};
+
+struct FrameTimeSummary
+{
+    double avgMs = 0.0;
+    double p50Ms = 0.0;
+    double p95Ms = 0.0;
+    double p99Ms = 0.0;
+    double maxMs = 0.0;
+};
+
+// Estadísticas de tiempo de frame sobre las últimas kWindow muestras.
+// Un frame es un "hitch" si dura más del doble de la media de la ventana.
+class FrameStats
+{
+public:
+    static constexpr size_t kWindow = 512;
+    static constexpr size_t kStageCount = static_cast<size_t>(FrameStage::Count);
+
+    static void AddStageTime(FrameStage stage, double ms);
+    // Cierra el frame: 'frameMs' es el tiempo total entre Ticks.
+    static void EndFrame(double frameMs);
+    static void Reset();
+
+    static FrameTimeSummary GetFrameSummary();
+    static FrameTimeSummary GetStageSummary(FrameStage stage);
+    static uint32_t GetHitchCount();        // en la ventana actual
+    static uint64_t GetTotalHitchCount();   // desde el arranque / Reset
+    static size_t   GetSampleCount();
+    static double   GetAverageFps();
+
+    static const char* GetStageName(FrameStage stage);
+    static void Log();
+
+    class ScopedStage
+    {
+    public:
+        explicit ScopedStage(FrameStage stage)
+            : m_stage(stage)
+            , m_start(std::chrono::steady_clock::now())
+        {
+        }
+
+        ~ScopedStage()
+        {
+            const auto end = std::chrono::steady_clock::now();
+            AddStageTime(m_stage, std::chrono::duration<double, std::milli>(end - m_start).count());
+        }
+
+        ScopedStage(const ScopedStage&) = delete;
+        ScopedStage& operator=(const ScopedStage&) = delete;
+
+    private:
+        FrameStage m_stage;
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+private:
+    static FrameTimeSummary Summarize(const std::array<float, kWindow>& samples);
+
+    inline static std::array<float, kWindow> s_frameMs{};
+    inline static std::array<std::array<float, kWindow>, kStageCount> s_stageMs{};
+    inline static std::array<double, kStageCount> s_currentStageMs{};
+    inline static std::array<bool, kWindow> s_hitch{};
+    inline static size_t   s_head = 0;
+    inline static size_t   s_count = 0;
+    inline static double   s_frameSum = 0.0;
+    inline static uint32_t s_hitchesInWindow = 0;
+    inline static uint64_t s_totalHitches = 0;
+};
@@ -0,0 +1,193 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+    struct ProfileEvent
+    {
+        const char* name = nullptr;
+        uint64_t    startNs = 0;
+        uint64_t    endNs = 0;
+    };
+
+    constexpr uint64_t kEventsPerThread = 1u << 15; // potencia de dos
+
+    // Sólo el hilo dueño escribe; el lector publica/consume con 'head'.
+    struct ThreadBuffer
+    {
+        uint32_t                                  threadIndex = 0;
+        std::string                               name;
+        std::array<ProfileEvent, kEventsPerThread> events{};
+        std::atomic<uint64_t>                     head{0};
+    };
+
+    struct Registry
+    {
+        std::mutex                                 mutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    };
+
+    Registry& GetRegistry()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    thread_local ThreadBuffer* t_buffer = nullptr;
+
+    ThreadBuffer& GetThreadBuffer()
+    {
+        if (!t_buffer)
+        {
+            Registry& registry = GetRegistry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            auto buffer = std::make_unique<ThreadBuffer>();
+            buffer->threadIndex = static_cast<uint32_t>(registry.buffers.size());
+            buffer->name = "Thread " + std::to_string(buffer->threadIndex);
+            t_buffer = buffer.get();
+            registry.buffers.push_back(std::move(buffer));
+        }
+        return *t_buffer;
+    }
+
+    // Estado de captura: sólo lo toca el hilo principal.
+    uint32_t    g_framesRemaining = 0;
+    bool        g_pendingStart = false;
+    uint64_t    g_captureStartNs = 0;
+    std::string g_outputPath;
+
+    void WriteCapture(uint64_t startNs, uint64_t endNs)
+    {
+        std::ofstream file(g_outputPath);
+        if (!file.is_open())
+        {
+            std::printf("[Profiler] No se pudo escribir '%s'\n", g_outputPath.c_str());
+            return;
+        }
+
+        Registry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        size_t eventCount = 0;
+        bool first = true;
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        for (const auto& buffer : registry.buffers)
+        {
+            file << (first ? "" : ",\n")
+                 << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadIndex
+                 << ",\"args\":{\"name\":\"" << buffer->name << "\"}}";
+            first = false;
+
+            const uint64_t head = buffer->head.load(std::memory_order_acquire);
+            const uint64_t count = std::min(head, kEventsPerThread);
+            for (uint64_t i = head - count; i < head; ++i)
+            {
+                const ProfileEvent& evt = buffer->events[i & (kEventsPerThread - 1)];
+                if (!evt.name || evt.startNs < startNs || evt.startNs > endNs)
+                {
+                    continue;
+                }
+                char line[256];
+                std::snprintf(line, sizeof(line),
+                              ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                              evt.name,
+                              buffer->threadIndex,
+                              static_cast<double>(evt.startNs - startNs) / 1000.0,
+                              static_cast<double>(evt.endNs - evt.startNs) / 1000.0);
+                file << line;
+                ++eventCount;
+            }
+        }
+        file << "\n]}\n";
+
+        std::printf("[Profiler] Captura escrita en '%s' (%zu eventos)\n", g_outputPath.c_str(), eventCount);
+    }
+}
+
+namespace Profiler
+{
+    uint64_t NowNs()
+    {
+        using clock = std::chrono::steady_clock;
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            clock::now().time_since_epoch()).count());
+    }
+
+    void SetThreadName(const char* name)
+    {
+        ThreadBuffer& buffer = GetThreadBuffer();
+        std::lock_guard<std::mutex> lock(GetRegistry().mutex);
+        buffer.name = name ? name : "";
+    }
+
+    void BeginFrame()
+    {
+        if (g_pendingStart)
+        {
+            g_pendingStart = false;
+            g_captureStartNs = NowNs();
+            detail::g_recording.store(true, std::memory_order_relaxed);
+            return;
+        }
+
+        if (!detail::g_recording.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+
+        if (g_framesRemaining > 0)
+        {
+            --g_framesRemaining;
+        }
+        if (g_framesRemaining == 0)
+        {
+            detail::g_recording.store(false, std::memory_order_relaxed);
+            WriteCapture(g_captureStartNs, NowNs());
+        }
+    }
+
+    void RequestCapture(uint32_t frameCount, const std::string& outputPath)
+    {
+#if defined(SANDBOXCITY_PROFILER) && SANDBOXCITY_PROFILER
+        if (IsCapturing() || frameCount == 0)
+        {
+            return;
+        }
+        g_framesRemaining = frameCount;
+        g_outputPath = outputPath;
+        g_pendingStart = true;
+        std::printf("[Profiler] Capturando %u frames...\n", frameCount);
+#else
+        (void)frameCount;
+        (void)outputPath;
+        std::printf("[Profiler] Compilado sin SANDBOXCITY_PROFILER; captura no disponible\n");
+#endif
+    }
+
+    bool IsCapturing()
+    {
+        return g_pendingStart || detail::g_recording.load(std::memory_order_relaxed);
+    }
+
+    namespace detail
+    {
+        void Record(const char* name, uint64_t startNs, uint64_t endNs)
+        {
+            ThreadBuffer& buffer = GetThreadBuffer();
+            const uint64_t head = buffer.head.load(std::memory_order_relaxed);
+            ProfileEvent& evt = buffer.events[head & (kEventsPerThread - 1)];
+            evt.name = name;
+            evt.startNs = startNs;
+            evt.endNs = endNs;
+            buffer.head.store(head + 1, std::memory_order_release);
+        }
+    }
+}
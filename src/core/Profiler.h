@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Profiler de CPU por marcadores con ámbito. Cada hilo escribe en su propio
+// ring buffer sin locks; sólo se graba mientras hay una captura en curso.
+// Con SANDBOXCITY_PROFILER=0 PROFILE_SCOPE no genera código.
+namespace Profiler
+{
+    void SetThreadName(const char* name);
+
+    // Una vez por frame desde el hilo principal: arranca/cierra capturas.
+    void BeginFrame();
+
+    // Graba los próximos 'frameCount' frames y los vuelca como Chrome trace
+    // JSON (chrome://tracing, Perfetto) en 'outputPath'.
+    void RequestCapture(uint32_t frameCount, const std::string& outputPath = "profile_capture.json");
+    bool IsCapturing();
+
+    uint64_t NowNs();
+
+    namespace detail
+    {
+        inline std::atomic<bool> g_recording{false};
+        void Record(const char* name, uint64_t startNs, uint64_t endNs);
+    }
+
+#if defined(SANDBOXCITY_PROFILER) && SANDBOXCITY_PROFILER
+    class Scope
+    {
+    public:
+        explicit Scope(const char* name)
+            : m_name(name)
+            , m_start(detail::g_recording.load(std::memory_order_relaxed) ? NowNs() : 0)
+        {
+        }
+
+        ~Scope()
+        {
+            if (m_start != 0)
+            {
+                detail::Record(m_name, m_start, NowNs());
+            }
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const char* m_name;
+        uint64_t    m_start;
+    };
+#else
+    class Scope
+    {
+    public:
+        explicit Scope(const char*) {}
+    };
+#endif
+}
+
+#if defined(SANDBOXCITY_PROFILER) && SANDBOXCITY_PROFILER
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+// 'name' debe vivir todo el programa (literal de cadena).
+#define PROFILE_SCOPE(name) ::Profiler::Scope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#endif
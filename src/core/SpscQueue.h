@@ -0,0 +1,68 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Cola circular sin locks de un productor y un consumidor. Capacity debe ser
+// potencia de dos; caben Capacity elementos. TryPush sólo desde el hilo
+// productor y TryPop sólo desde el consumidor.
+template <typename T, size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity debe ser potencia de dos");
+    static_assert(std::is_trivially_copyable_v<T>, "SpscQueue sólo admite tipos trivialmente copiables");
+
+public:
+    bool TryPush(const T& value)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cachedHead == Capacity)
+        {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead == Capacity)
+            {
+                return false;
+            }
+        }
+        m_items[tail & (Capacity - 1)] = value;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool TryPop(T& out)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_cachedTail)
+        {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cachedTail)
+            {
+                return false;
+            }
+        }
+        out = m_items[head & (Capacity - 1)];
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Aproximado si se llama mientras el otro hilo opera.
+    size_t Size() const
+    {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+
+    static constexpr size_t GetCapacity() { return Capacity; }
+
+private:
+    static constexpr size_t kCacheLine = 64;
+
+    // Productor y consumidor en líneas de caché distintas para no compartirlas.
+    alignas(kCacheLine) std::atomic<size_t> m_tail{0};
+    size_t                                  m_cachedHead = 0; // sólo productor
+    alignas(kCacheLine) std::atomic<size_t> m_head{0};
+    size_t                                  m_cachedTail = 0; // sólo consumidor
+    alignas(kCacheLine) std::array<T, Capacity> m_items{};
+};
@@ -0,0 +1,138 @@
+#include "ThreadPool.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <string>
+
+namespace
+{
+    thread_local bool t_isPoolWorker = false;
+}
+
+ThreadPool::ThreadPool(unsigned workerCount)
+{
+    if (workerCount == 0)
+    {
+        const unsigned hw = std::thread::hardware_concurrency();
+        workerCount = hw > 1 ? hw - 1 : 1;
+    }
+
+    m_workers.reserve(workerCount);
+    for (unsigned i = 0; i < workerCount; ++i)
+    {
+        m_workers.emplace_back(&ThreadPool::WorkerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wakeCv.notify_all();
+
+    for (std::thread& worker : m_workers)
+    {
+        if (worker.joinable())
+        {
+            worker.join();
+        }
+    }
+}
+
+ThreadPool& ThreadPool::Shared()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::ParallelFor(int begin, int end, int grain, const std::function<void(int, int)>& body, unsigned maxThreads)
+{
+    if (begin >= end)
+    {
+        return;
+    }
+    grain = std::max(grain, 1);
+
+    const unsigned totalThreads = GetWorkerCount() + 1;
+    const unsigned threads = maxThreads == 0 ? totalThreads : std::min(maxThreads, totalThreads);
+    const int blocks = (end - begin + grain - 1) / grain;
+
+    if (t_isPoolWorker || threads <= 1 || blocks <= 1)
+    {
+        body(begin, end);
+        return;
+    }
+
+    std::lock_guard<std::mutex> submit(m_submitMutex);
+
+    const unsigned helpers = std::min<unsigned>(threads - 1, static_cast<unsigned>(blocks - 1));
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_body = &body;
+        m_end = end;
+        m_grain = grain;
+        m_next.store(begin, std::memory_order_relaxed);
+        m_participants = helpers;
+        m_pending = helpers;
+        ++m_generation;
+    }
+    m_wakeCv.notify_all();
+
+    RunBlocks();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_doneCv.wait(lock, [this]() { return m_pending == 0; });
+    m_body = nullptr;
+}
+
+void ThreadPool::RunBlocks()
+{
+    for (;;)
+    {
+        const int blockBegin = m_next.fetch_add(m_grain, std::memory_order_relaxed);
+        if (blockBegin >= m_end)
+        {
+            break;
+        }
+        (*m_body)(blockBegin, std::min(blockBegin + m_grain, m_end));
+    }
+}
+
+void ThreadPool::WorkerLoop(unsigned workerIndex)
+{
+    t_isPoolWorker = true;
+    const std::string threadName = "Worker " + std::to_string(workerIndex);
+    Profiler::SetThreadName(threadName.c_str());
+    uint64_t seenGeneration = 0;
+
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeCv.wait(lock, [&]() { return m_stop || m_generation != seenGeneration; });
+            if (m_stop)
+            {
+                return;
+            }
+            seenGeneration = m_generation;
+            // Sólo los primeros 'm_participants' workers entran en esta tanda.
+            if (workerIndex >= m_participants)
+            {
+                continue;
+            }
+        }
+
+        {
+            PROFILE_SCOPE("ThreadPool::Job");
+            RunBlocks();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_pending;
+        }
+        m_doneCv.notify_one();
+    }
+}
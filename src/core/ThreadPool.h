@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pool de hilos del motor. Pensado para trabajo "fork-join": ParallelFor
+// reparte un rango en bloques entre los workers y el hilo llamante y no
+// vuelve hasta que todos terminan.
+class ThreadPool
+{
+public:
+    // workerCount = 0 -> hardware_concurrency - 1 (el hilo llamante también trabaja).
+    explicit ThreadPool(unsigned workerCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned GetWorkerCount() const { return static_cast<unsigned>(m_workers.size()); }
+
+    // Ejecuta body(blockBegin, blockEnd) sobre [begin, end) en bloques de 'grain'.
+    // maxThreads limita los hilos participantes (incluido el llamante); 0 = todos.
+    // Las llamadas anidadas desde un worker se ejecutan en línea.
+    void ParallelFor(int begin, int end, int grain, const std::function<void(int, int)>& body, unsigned maxThreads = 0);
+
+    // Pool compartido del proceso, creado al primer uso.
+    static ThreadPool& Shared();
+
+private:
+    void WorkerLoop(unsigned workerIndex);
+    void RunBlocks();
+
+private:
+    std::vector<std::thread> m_workers;
+
+    std::mutex              m_submitMutex;
+    std::mutex              m_mutex;
+    std::condition_variable m_wakeCv;
+    std::condition_variable m_doneCv;
+    uint64_t                m_generation = 0;
+    unsigned                m_participants = 0;
+    unsigned                m_pending = 0;
+    bool                    m_stop = false;
+
+    const std::function<void(int, int)>* m_body = nullptr;
+    int                                  m_end = 0;
+    int                                  m_grain = 1;
+    std::atomic<int>                     m_next{0};
+};
@@ -28,6 +28,17 @@ void Time::Tick() {
     s_fps = (s_delta > 0.0) ? (1.0 / s_delta) : 0.0;
 }
 
+void Time::Advance(double dt) {
+    // Se mantiene s_prevTicks al día para poder volver a Tick() sin un salto.
+    using clock = std::chrono::steady_clock;
+    s_prevTicks = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        clock::now().time_since_epoch()).count();
+
+    s_delta = (dt > 0.0) ? dt : 0.0;
+    s_time += s_delta;
+    s_fps = (s_delta > 0.0) ? (1.0 / s_delta) : 0.0;
+}
+
 // === getters requeridos por el linker ===
 double Time::DeltaTime() { return s_delta; }
 double Time::ElapsedTime() { return s_time; }
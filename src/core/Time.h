@@ -5,6 +5,7 @@ class Time {
 public:
     static void   Init();
     static void   Tick();
+    static void   Advance(double dt); // dt fijo en lugar del reloj (modo headless)
     static double DeltaTime();   // dt del último frame (seg)
     static double ElapsedTime(); // tiempo total (seg)
     static double FPS();
@@ -0,0 +1,314 @@
+#include "ArchetypeStorage.h"
+
+#include <cstring>
+#include <new>
+
+namespace
+{
+    constexpr size_t kTransformFloats = 3 + 4 + 3 + 16;
+    constexpr size_t kChunkAlignment = 64;
+    const size_t kTransformBit = static_cast<size_t>(ComponentType::Transform);
+}
+
+void ArchetypeStorage::ChunkMemoryDeleter::operator()(std::byte* memory) const
+{
+    ::operator delete(memory, std::align_val_t{kChunkAlignment});
+}
+
+ArchetypeStorage::ArchetypeStorage() = default;
+ArchetypeStorage::~ArchetypeStorage() = default;
+
+size_t ArchetypeStorage::GetRowsPerChunk(Mask mask) const
+{
+    const size_t bytesPerRow = sizeof(EntityId) + (mask.test(kTransformBit) ? kTransformFloats * sizeof(float) : 0);
+    const size_t rows = kChunkBytes / bytesPerRow;
+    return rows - rows % kRowGranularity;
+}
+
+size_t ArchetypeStorage::GetChunkCount() const
+{
+    size_t count = 0;
+    for (const Archetype& archetype : m_archetypes)
+    {
+        count += archetype.chunks.size();
+    }
+    return count;
+}
+
+uint32_t ArchetypeStorage::FindOrCreateArchetype(Mask mask)
+{
+    const uint32_t key = static_cast<uint32_t>(mask.to_ulong());
+    auto it = m_archetypeByMask.find(key);
+    if (it != m_archetypeByMask.end())
+    {
+        return it->second;
+    }
+
+    Archetype archetype;
+    archetype.mask = mask;
+    archetype.hasTransform = mask.test(kTransformBit);
+    archetype.capacity = static_cast<uint32_t>(GetRowsPerChunk(mask));
+    const uint32_t index = static_cast<uint32_t>(m_archetypes.size());
+    m_archetypes.push_back(std::move(archetype));
+    m_archetypeByMask.emplace(key, index);
+    return index;
+}
+
+const ArchetypeStorage::Location* ArchetypeStorage::FindLocation(EntityId id) const
+{
+    const uint32_t index = EntityIndex(id);
+    if (index >= m_locations.size() || m_locations[index].id != id || id == kInvalidEntity)
+    {
+        return nullptr;
+    }
+    return &m_locations[index];
+}
+
+bool ArchetypeStorage::Contains(EntityId id) const
+{
+    return FindLocation(id) != nullptr;
+}
+
+ArchetypeStorage::Mask ArchetypeStorage::GetMask(EntityId id) const
+{
+    const Location* location = FindLocation(id);
+    return location ? m_archetypes[location->archetype].mask : Mask{};
+}
+
+ArchetypeStorage::TransformColumns ArchetypeStorage::Columns(const Archetype& archetype, const Chunk& chunk)
+{
+    TransformColumns columns;
+    if (!archetype.hasTransform)
+    {
+        return columns;
+    }
+
+    float* base = reinterpret_cast<float*>(chunk.memory.get() + archetype.capacity * sizeof(EntityId));
+    const size_t stride = archetype.capacity;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        columns.position[i] = base + (0 + i) * stride;
+        columns.scale[i]    = base + (7 + i) * stride;
+    }
+    for (size_t i = 0; i < 4; ++i)
+    {
+        columns.rotation[i] = base + (3 + i) * stride;
+    }
+    for (size_t i = 0; i < 16; ++i)
+    {
+        columns.world[i] = base + (10 + i) * stride;
+    }
+    return columns;
+}
+
+ArchetypeStorage::ChunkView ArchetypeStorage::MakeView(const Archetype& archetype, size_t chunk) const
+{
+    const Chunk& data = archetype.chunks[chunk];
+    ChunkView view;
+    view.mask = archetype.mask;
+    view.entities = reinterpret_cast<const EntityId*>(data.memory.get());
+    view.count = data.count;
+    view.transform = Columns(archetype, data);
+    return view;
+}
+
+void ArchetypeStorage::InitTransformRow(const TransformColumns& columns, size_t row)
+{
+    for (size_t i = 0; i < 3; ++i)
+    {
+        columns.position[i][row] = 0.0f;
+        columns.rotation[i][row] = 0.0f;
+        columns.scale[i][row] = 1.0f;
+    }
+    columns.rotation[3][row] = 1.0f;
+    for (size_t i = 0; i < 16; ++i)
+    {
+        columns.world[i][row] = (i % 5 == 0) ? 1.0f : 0.0f;
+    }
+}
+
+void ArchetypeStorage::CopyTransformRow(const TransformColumns& from, size_t fromRow, const TransformColumns& to, size_t toRow)
+{
+    for (size_t i = 0; i < 3; ++i)
+    {
+        to.position[i][toRow] = from.position[i][fromRow];
+        to.rotation[i][toRow] = from.rotation[i][fromRow];
+        to.scale[i][toRow] = from.scale[i][fromRow];
+    }
+    to.rotation[3][toRow] = from.rotation[3][fromRow];
+    for (size_t i = 0; i < 16; ++i)
+    {
+        to.world[i][toRow] = from.world[i][fromRow];
+    }
+}
+
+ArchetypeStorage::Location ArchetypeStorage::AppendRow(uint32_t archetypeIndex, EntityId id)
+{
+    Archetype& archetype = m_archetypes[archetypeIndex];
+    if (archetype.chunks.empty() || archetype.chunks.back().count == archetype.capacity)
+    {
+        Chunk chunk;
+        chunk.memory.reset(static_cast<std::byte*>(::operator new(kChunkBytes, std::align_val_t{kChunkAlignment})));
+        archetype.chunks.push_back(std::move(chunk));
+    }
+
+    Chunk& chunk = archetype.chunks.back();
+    const uint32_t row = chunk.count++;
+    reinterpret_cast<EntityId*>(chunk.memory.get())[row] = id;
+    ++archetype.rowCount;
+    return Location{id, archetypeIndex, static_cast<uint32_t>(archetype.chunks.size() - 1), row};
+}
+
+void ArchetypeStorage::RemoveRow(const Location& location)
+{
+    Archetype& archetype = m_archetypes[location.archetype];
+    Chunk& lastChunk = archetype.chunks.back();
+    const uint32_t lastChunkIndex = static_cast<uint32_t>(archetype.chunks.size() - 1);
+    const uint32_t lastRow = lastChunk.count - 1;
+
+    if (location.chunk != lastChunkIndex || location.row != lastRow)
+    {
+        // La última fila del arquetipo pasa al hueco
+        Chunk& target = archetype.chunks[location.chunk];
+        const EntityId moved = reinterpret_cast<const EntityId*>(lastChunk.memory.get())[lastRow];
+        reinterpret_cast<EntityId*>(target.memory.get())[location.row] = moved;
+        if (archetype.hasTransform)
+        {
+            CopyTransformRow(Columns(archetype, lastChunk), lastRow, Columns(archetype, target), location.row);
+        }
+        Location& movedLocation = m_locations[EntityIndex(moved)];
+        movedLocation.chunk = location.chunk;
+        movedLocation.row = location.row;
+    }
+
+    --lastChunk.count;
+    --archetype.rowCount;
+    // Se conserva un chunk vacío por arquetipo para no reservar en cada churn
+    if (lastChunk.count == 0 && archetype.chunks.size() > 1)
+    {
+        archetype.chunks.pop_back();
+    }
+}
+
+bool ArchetypeStorage::Add(EntityId id, Mask mask)
+{
+    if (id == kInvalidEntity)
+    {
+        return false;
+    }
+    if (Contains(id))
+    {
+        SetMask(id, mask);
+        return true;
+    }
+
+    const uint32_t index = EntityIndex(id);
+    if (index >= m_locations.size())
+    {
+        m_locations.resize(static_cast<size_t>(index) + 1);
+    }
+
+    const uint32_t archetypeIndex = FindOrCreateArchetype(mask);
+    const Location location = AppendRow(archetypeIndex, id);
+    const Archetype& archetype = m_archetypes[archetypeIndex];
+    if (archetype.hasTransform)
+    {
+        InitTransformRow(Columns(archetype, archetype.chunks[location.chunk]), location.row);
+    }
+    m_locations[index] = location;
+    ++m_entityCount;
+    return true;
+}
+
+void ArchetypeStorage::Remove(EntityId id)
+{
+    const Location* location = FindLocation(id);
+    if (!location)
+    {
+        return;
+    }
+    const Location removed = *location;
+    m_locations[EntityIndex(id)] = Location{};
+    RemoveRow(removed);
+    --m_entityCount;
+}
+
+void ArchetypeStorage::SetMask(EntityId id, Mask mask)
+{
+    const Location* found = FindLocation(id);
+    if (!found || m_archetypes[found->archetype].mask == mask)
+    {
+        return;
+    }
+
+    const Location previous = *found;
+    const uint32_t archetypeIndex = FindOrCreateArchetype(mask);
+    const Location next = AppendRow(archetypeIndex, id);
+
+    const Archetype& from = m_archetypes[previous.archetype];
+    const Archetype& to = m_archetypes[archetypeIndex];
+    if (to.hasTransform)
+    {
+        const TransformColumns target = Columns(to, to.chunks[next.chunk]);
+        if (from.hasTransform)
+        {
+            CopyTransformRow(Columns(from, from.chunks[previous.chunk]), previous.row, target, next.row);
+        }
+        else
+        {
+            InitTransformRow(target, next.row);
+        }
+    }
+
+    RemoveRow(previous);
+    m_locations[EntityIndex(id)] = next;
+}
+
+bool ArchetypeStorage::SetTransform(EntityId id, const float3& position, const quat& rotation, const float3& scale)
+{
+    const Location* location = FindLocation(id);
+    if (!location)
+    {
+        return false;
+    }
+    const Archetype& archetype = m_archetypes[location->archetype];
+    if (!archetype.hasTransform)
+    {
+        return false;
+    }
+
+    const TransformColumns columns = Columns(archetype, archetype.chunks[location->chunk]);
+    const size_t row = location->row;
+    columns.position[0][row] = position.x;
+    columns.position[1][row] = position.y;
+    columns.position[2][row] = position.z;
+    columns.rotation[0][row] = rotation.x;
+    columns.rotation[1][row] = rotation.y;
+    columns.rotation[2][row] = rotation.z;
+    columns.rotation[3][row] = rotation.w;
+    columns.scale[0][row] = scale.x;
+    columns.scale[1][row] = scale.y;
+    columns.scale[2][row] = scale.z;
+    return true;
+}
+
+bool ArchetypeStorage::GetWorld(EntityId id, float outWorld[16]) const
+{
+    const Location* location = FindLocation(id);
+    if (!location)
+    {
+        return false;
+    }
+    const Archetype& archetype = m_archetypes[location->archetype];
+    if (!archetype.hasTransform)
+    {
+        return false;
+    }
+
+    const TransformColumns columns = Columns(archetype, archetype.chunks[location->chunk]);
+    for (size_t i = 0; i < 16; ++i)
+    {
+        outWorld[i] = columns.world[i][location->row];
+    }
+    return true;
+}
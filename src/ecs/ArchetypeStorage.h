@@ -0,0 +1,132 @@
+#pragma once
+
+#include "ComponentChangeLog.h"
+#include "Entity.h"
+#include "Transform.h"
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Almacenamiento por arquetipos: las entidades con la misma máscara de
+// componentes comparten arquetipo y viven en chunks de 16 KB con columnas SoA.
+// Con Transform, cada componente de posición/rotación/escala y cada elemento
+// de la matriz mundo es un array contiguo de floats, así que un bucle sobre un
+// chunk procesa 4-8 entidades por instrucción SIMD.
+//  - Cambiar la máscara mueve la fila a otro arquetipo (copia de columnas).
+//  - Quitar una entidad rellena el hueco con la última fila del arquetipo, así
+//    los chunks no tienen huecos y el orden de las filas no es estable.
+//  - No hay jerarquía: todas las filas son raíces (world = SRT local).
+// Es la alternativa a los mapas por componente de Scene; bench/BenchScene
+// compara ambos en churn de componentes e iteración.
+class ArchetypeStorage
+{
+public:
+    using Mask = std::bitset<32>; // bits = ComponentType
+
+    static constexpr size_t kChunkBytes = 16 * 1024;
+    // Filas por chunk múltiplo de esto: cada columna empieza alineada a 64 bytes
+    static constexpr size_t kRowGranularity = 16;
+
+    struct TransformColumns
+    {
+        float* position[3] = {};
+        float* rotation[4] = {}; // cuaternión x, y, z, w, como Transform::rotation
+        float* scale[3] = {};
+        float* world[16] = {};
+    };
+
+    struct ChunkView
+    {
+        Mask             mask;
+        const EntityId*  entities = nullptr;
+        size_t           count = 0;
+        TransformColumns transform; // nulos si el arquetipo no tiene Transform
+    };
+
+    ArchetypeStorage();
+    ~ArchetypeStorage();
+
+    ArchetypeStorage(const ArchetypeStorage&) = delete;
+    ArchetypeStorage& operator=(const ArchetypeStorage&) = delete;
+
+    // Alta con la máscara dada; el Transform arranca con escala 1 y mundo identidad.
+    bool Add(EntityId id, Mask mask);
+    void Remove(EntityId id);
+    void SetMask(EntityId id, Mask mask);
+    bool Contains(EntityId id) const;
+    Mask GetMask(EntityId id) const;
+
+    bool SetTransform(EntityId id, const float3& position, const quat& rotation, const float3& scale);
+    bool GetWorld(EntityId id, float outWorld[16]) const;
+
+    // fn(ChunkView&) por cada chunk no vacío cuyo arquetipo incluye 'required'.
+    template<typename Fn>
+    void ForEachChunk(Mask required, Fn&& fn)
+    {
+        for (Archetype& archetype : m_archetypes)
+        {
+            if ((archetype.mask & required) != required)
+            {
+                continue;
+            }
+            for (size_t c = 0; c < archetype.chunks.size() && archetype.chunks[c].count > 0; ++c)
+            {
+                ChunkView view = MakeView(archetype, c);
+                fn(view);
+            }
+        }
+    }
+
+    size_t GetEntityCount() const { return m_entityCount; }
+    size_t GetArchetypeCount() const { return m_archetypes.size(); }
+    size_t GetChunkCount() const;
+    size_t GetRowsPerChunk(Mask mask) const;
+
+private:
+    struct ChunkMemoryDeleter
+    {
+        void operator()(std::byte* memory) const;
+    };
+
+    struct Chunk
+    {
+        std::unique_ptr<std::byte, ChunkMemoryDeleter> memory;
+        uint32_t count = 0;
+    };
+
+    struct Archetype
+    {
+        Mask               mask;
+        bool               hasTransform = false;
+        uint32_t           capacity = 0;   // filas por chunk
+        std::vector<Chunk> chunks;         // los llenos delante; sólo el último puede estar a medias
+        size_t             rowCount = 0;
+    };
+
+    struct Location
+    {
+        EntityId id = kInvalidEntity;
+        uint32_t archetype = 0;
+        uint32_t chunk = 0;
+        uint32_t row = 0;
+    };
+
+    uint32_t FindOrCreateArchetype(Mask mask);
+    const Location* FindLocation(EntityId id) const;
+    Location AppendRow(uint32_t archetypeIndex, EntityId id);
+    void RemoveRow(const Location& location);
+    static void InitTransformRow(const TransformColumns& columns, size_t row);
+    static void CopyTransformRow(const TransformColumns& from, size_t fromRow, const TransformColumns& to, size_t toRow);
+    static TransformColumns Columns(const Archetype& archetype, const Chunk& chunk);
+    ChunkView MakeView(const Archetype& archetype, size_t chunk) const;
+
+private:
+    std::vector<Archetype>                  m_archetypes;
+    std::unordered_map<uint32_t, uint32_t>  m_archetypeByMask;
+    std::vector<Location>                   m_locations; // por EntityIndex
+    size_t                                  m_entityCount = 0;
+};
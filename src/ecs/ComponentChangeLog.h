@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Entity.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Tipos de componente de Scene; el valor es también su bit en la máscara.
+enum class ComponentType : uint8_t
+{
+    Transform,
+    MeshRenderer,
+    PhysicsCharacter,
+    Collider,
+    RigidBody,
+    TriggerVolume,
+    Count,
+};
+
+enum class ComponentChange : uint8_t
+{
+    Added,
+    Removed,
+    Modified,
+};
+
+// Registro de altas, bajas y modificaciones de un tipo de componente. Cada
+// consumidor guarda la versión hasta la que ha leído y en la siguiente pasada
+// recorre sólo lo nuevo. El registro se recorta solo: si un consumidor se queda
+// atrás más de kMaxEntries cambios, ForEachSince devuelve false y le toca
+// recorrer la escena entera.
+class ComponentChangeLog
+{
+public:
+    static constexpr size_t kMaxEntries = 64 * 1024;
+
+    struct Entry
+    {
+        EntityId        entity = kInvalidEntity;
+        ComponentChange change = ComponentChange::Added;
+    };
+
+    void Record(EntityId entity, ComponentChange change)
+    {
+        if (m_entries.size() >= kMaxEntries)
+        {
+            // Se descarta la mitad más antigua: coste amortizado O(1) por cambio
+            const size_t dropped = m_entries.size() / 2;
+            m_entries.erase(m_entries.begin(), m_entries.begin() + static_cast<std::ptrdiff_t>(dropped));
+            m_baseVersion += dropped;
+        }
+        m_entries.push_back(Entry{entity, change});
+    }
+
+    // Versión tras el último cambio registrado.
+    uint64_t GetVersion() const { return m_baseVersion + m_entries.size(); }
+
+    // Llama a fn(const Entry&) con los cambios posteriores a 'since', en orden.
+    // Devuelve false (sin llamar a fn) si parte de ellos ya se ha descartado.
+    template<typename Fn>
+    bool ForEachSince(uint64_t since, Fn&& fn) const
+    {
+        if (since < m_baseVersion || since > GetVersion())
+        {
+            return false;
+        }
+        for (size_t i = static_cast<size_t>(since - m_baseVersion); i < m_entries.size(); ++i)
+        {
+            fn(m_entries[i]);
+        }
+        return true;
+    }
+
+    // Olvida los cambios sin retroceder la versión (p. ej. tras una carga).
+    void Discard()
+    {
+        m_baseVersion += m_entries.size();
+        m_entries.clear();
+    }
+
+private:
+    std::vector<Entry> m_entries;
+    uint64_t           m_baseVersion = 0;
+};
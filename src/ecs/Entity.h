@@ -1,5 +1,28 @@
 #pragma once
 #include <cstdint>
 
+// Id de entidad = índice de slot (bits bajos) + generación (bits altos). Al
+// destruir una entidad la generación de su slot sube, así que un id guardado
+// (runtime de físicas, objetivo de la cámara, eventos) deja de estar vivo en
+// lugar de apuntar a la entidad que reutilice el slot.
 using EntityId = uint32_t;
 static constexpr EntityId kInvalidEntity = 0;
+
+static constexpr uint32_t kEntityIndexBits = 22;                               // ~4M entidades vivas
+static constexpr uint32_t kEntityIndexMask = (1u << kEntityIndexBits) - 1;
+static constexpr uint32_t kEntityGenerationMask = (1u << (32 - kEntityIndexBits)) - 1;
+
+constexpr uint32_t EntityIndex(EntityId id)
+{
+    return id & kEntityIndexMask;
+}
+
+constexpr uint32_t EntityGeneration(EntityId id)
+{
+    return id >> kEntityIndexBits;
+}
+
+constexpr EntityId MakeEntityId(uint32_t index, uint32_t generation)
+{
+    return ((generation & kEntityGenerationMask) << kEntityIndexBits) | (index & kEntityIndexMask);
+}
@@ -1,17 +1,15 @@
 #pragma once
 
 #include "Entity.h"
+#include "../resource/ResourceHandle.h"
 
-#include <memory>
 #include <unordered_map>
 
-struct Mesh;
-struct Material;
-
+// Los handles se resuelven con el ResourceManager al dibujar, así que una
+// malla o material recargado en caliente se ve sin tocar el componente.
 struct MeshRenderer
 {
-    std::shared_ptr<Mesh>     mesh;
-    std::shared_ptr<Material> material;
-    std::unordered_map<uint32_t, std::shared_ptr<Material>> materialOverrides;
+    resource::MeshHandle     mesh;
+    resource::MaterialHandle material;
+    std::unordered_map<uint32_t, resource::MaterialHandle> materialOverrides;
 };
-
@@ -4,15 +4,24 @@
 #include "Transform.h"
 #include "MeshRenderer.h"
 #include "../render/Renderer.h"
+#include "../resource/ResourceManager.h"
 #include "../asset/Mesh.h"
 #include "../render/Material.h"
 
 void RenderSystem::Render(Scene& scene, Renderer& renderer)
 {
+    resource::ResourceManager* resources = renderer.GetResourceManager();
+    if (!resources)
+    {
+        return;
+    }
+
     auto& renderers = scene.GetMeshRenderers();
     for (const auto& [entity, meshRenderer] : renderers)
     {
-        if (!meshRenderer.mesh || !meshRenderer.material)
+        const Mesh* mesh = resources->GetMesh(meshRenderer.mesh);
+        const Material* material = resources->GetMaterial(meshRenderer.material);
+        if (!mesh || !material)
         {
             continue;
         }
@@ -23,7 +32,6 @@ void RenderSystem::Render(Scene& scene, Renderer& renderer)
             continue;
         }
 
-        renderer.SubmitMeshLit(*meshRenderer.mesh, *meshRenderer.material, transform->world);
+        renderer.SubmitMeshLit(*mesh, *material, transform->world);
     }
 }
-
@@ -8,35 +8,58 @@
 
 namespace
 {
-    constexpr size_t kTransformBit        = 0;
-    constexpr size_t kMeshRendererBit     = 1;
-    constexpr size_t kPhysicsCharacterBit = 2;
-    constexpr size_t kColliderBit         = 3;
-    constexpr size_t kRigidBodyBit        = 4;
-    constexpr size_t kTriggerBit          = 5;
+    constexpr size_t kTransformBit        = static_cast<size_t>(ComponentType::Transform);
+    constexpr size_t kMeshRendererBit     = static_cast<size_t>(ComponentType::MeshRenderer);
+    constexpr size_t kPhysicsCharacterBit = static_cast<size_t>(ComponentType::PhysicsCharacter);
+    constexpr size_t kColliderBit         = static_cast<size_t>(ComponentType::Collider);
+    constexpr size_t kRigidBodyBit        = static_cast<size_t>(ComponentType::RigidBody);
+    constexpr size_t kTriggerBit          = static_cast<size_t>(ComponentType::TriggerVolume);
 
     const std::vector<EntityId> kEmptyChildren{};
+
+    constexpr size_t   kMinFreeIndices = 1024;
+    constexpr uint32_t kUnusedGeneration = UINT32_MAX; // no cabe en un id
+}
+
+Scene::Scene()
+    : m_generations{kUnusedGeneration}
+    , m_entityMasks(1)
+{
 }
 
 EntityId Scene::CreateEntity()
 {
-    EntityId id = kInvalidEntity;
-    if (!m_freeIds.empty())
+    uint32_t index = 0;
+    if (m_freeIndices.size() > kMinFreeIndices)
     {
-        id = m_freeIds.back();
-        m_freeIds.pop_back();
+        index = m_freeIndices.front();
+        m_freeIndices.pop_front();
     }
     else
     {
-        id = ++m_nextId;
-        if (id == kInvalidEntity)
+        // El último índice no se usa: con la última generación sería 0xFFFFFFFF
+        if (m_generations.size() >= kEntityIndexMask)
         {
-            id = ++m_nextId;
+            if (m_freeIndices.empty())
+            {
+                std::printf("[Scene] Sin índices de entidad libres (%zu vivas)\n", m_aliveCount);
+                return kInvalidEntity;
+            }
+            index = m_freeIndices.front();
+            m_freeIndices.pop_front();
+        }
+        else
+        {
+            index = static_cast<uint32_t>(m_generations.size());
+            m_generations.push_back(0);
+            m_entityMasks.emplace_back();
         }
     }
 
-    m_entityMasks[id] = ComponentMask{};
+    const EntityId id = MakeEntityId(index, m_generations[index]);
+    m_entityMasks[index].reset();
     m_children[id];
+    ++m_aliveCount;
     return id;
 }
 
@@ -76,15 +99,22 @@ void Scene::DestroyEntity(EntityId id)
     }
 
     m_parents.erase(id);
-    m_entityMasks.erase(id);
 
-    m_freeIds.push_back(id);
-    std::erase_if(m_logicalIds, [id](const auto& pair) { return pair.second == id; });
-}
+    // Los ids que aún tengan otros dejan de estar vivos
+    const uint32_t index = EntityIndex(id);
+    m_generations[index] = (m_generations[index] + 1) & kEntityGenerationMask;
+    m_entityMasks[index].reset();
+    m_freeIndices.push_back(index);
+    --m_aliveCount;
 
-bool Scene::IsAlive(EntityId id) const
-{
-    return m_entityMasks.find(id) != m_entityMasks.end();
+    if (auto keysIt = m_logicalKeysByEntity.find(id); keysIt != m_logicalKeysByEntity.end())
+    {
+        for (const std::string& key : keysIt->second)
+        {
+            m_logicalIds.erase(key);
+        }
+        m_logicalKeysByEntity.erase(keysIt);
+    }
 }
 
 Transform* Scene::AddTransform(EntityId id)
@@ -98,6 +128,7 @@ Transform* Scene::AddTransform(EntityId id)
     Transform& transform = it->second;
     transform.MarkDirty();
     SetMaskBit(id, kTransformBit, true);
+    RecordChange(kTransformBit, id, inserted ? ComponentChange::Added : ComponentChange::Modified);
     return &transform;
 }
 
@@ -128,6 +159,7 @@ void Scene::RemoveTransform(EntityId id)
     {
         m_transforms.erase(it);
         SetMaskBit(id, kTransformBit, false);
+        RecordChange(kTransformBit, id, ComponentChange::Removed);
     }
 }
 
@@ -141,6 +173,7 @@ MeshRenderer* Scene::AddMeshRenderer(EntityId id)
     auto [it, inserted] = m_meshRenderers.emplace(id, MeshRenderer{});
     MeshRenderer& renderer = it->second;
     SetMaskBit(id, kMeshRendererBit, true);
+    RecordChange(kMeshRendererBit, id, inserted ? ComponentChange::Added : ComponentChange::Modified);
     return &renderer;
 }
 
@@ -171,6 +204,7 @@ void Scene::RemoveMeshRenderer(EntityId id)
     {
         m_meshRenderers.erase(it);
         SetMaskBit(id, kMeshRendererBit, false);
+        RecordChange(kMeshRendererBit, id, ComponentChange::Removed);
     }
 }
 
@@ -185,6 +219,7 @@ Collider* Scene::AddCollider(EntityId id)
     Collider& collider = it->second;
     collider.dirty = true;
     SetMaskBit(id, kColliderBit, true);
+    RecordChange(kColliderBit, id, inserted ? ComponentChange::Added : ComponentChange::Modified);
     return &collider;
 }
 
@@ -208,6 +243,17 @@ const Collider* Scene::GetCollider(EntityId id) const
     return &it->second;
 }
 
+Collider* Scene::EditCollider(EntityId id)
+{
+    Collider* collider = GetCollider(id);
+    if (collider)
+    {
+        collider->dirty = true;
+        RecordChange(kColliderBit, id, ComponentChange::Modified);
+    }
+    return collider;
+}
+
 void Scene::RemoveCollider(EntityId id)
 {
     auto it = m_colliders.find(id);
@@ -215,6 +261,7 @@ void Scene::RemoveCollider(EntityId id)
     {
         m_colliders.erase(it);
         SetMaskBit(id, kColliderBit, false);
+        RecordChange(kColliderBit, id, ComponentChange::Removed);
     }
 }
 
@@ -229,6 +276,7 @@ RigidBody* Scene::AddRigidBody(EntityId id)
     RigidBody& body = it->second;
     body.dirty = true;
     SetMaskBit(id, kRigidBodyBit, true);
+    RecordChange(kRigidBodyBit, id, inserted ? ComponentChange::Added : ComponentChange::Modified);
     return &body;
 }
 
@@ -252,6 +300,17 @@ const RigidBody* Scene::GetRigidBody(EntityId id) const
     return &it->second;
 }
 
+RigidBody* Scene::EditRigidBody(EntityId id)
+{
+    RigidBody* body = GetRigidBody(id);
+    if (body)
+    {
+        body->dirty = true;
+        RecordChange(kRigidBodyBit, id, ComponentChange::Modified);
+    }
+    return body;
+}
+
 void Scene::RemoveRigidBody(EntityId id)
 {
     auto it = m_rigidBodies.find(id);
@@ -259,6 +318,7 @@ void Scene::RemoveRigidBody(EntityId id)
     {
         m_rigidBodies.erase(it);
         SetMaskBit(id, kRigidBodyBit, false);
+        RecordChange(kRigidBodyBit, id, ComponentChange::Removed);
     }
 }
 
@@ -273,6 +333,7 @@ TriggerVolume* Scene::AddTriggerVolume(EntityId id)
     TriggerVolume& trigger = it->second;
     trigger.dirty = true;
     SetMaskBit(id, kTriggerBit, true);
+    RecordChange(kTriggerBit, id, inserted ? ComponentChange::Added : ComponentChange::Modified);
     return &trigger;
 }
 
@@ -296,6 +357,17 @@ const TriggerVolume* Scene::GetTriggerVolume(EntityId id) const
     return &it->second;
 }
 
+TriggerVolume* Scene::EditTriggerVolume(EntityId id)
+{
+    TriggerVolume* trigger = GetTriggerVolume(id);
+    if (trigger)
+    {
+        trigger->dirty = true;
+        RecordChange(kTriggerBit, id, ComponentChange::Modified);
+    }
+    return trigger;
+}
+
 void Scene::RemoveTriggerVolume(EntityId id)
 {
     auto it = m_triggerVolumes.find(id);
@@ -303,6 +375,7 @@ void Scene::RemoveTriggerVolume(EntityId id)
     {
         m_triggerVolumes.erase(it);
         SetMaskBit(id, kTriggerBit, false);
+        RecordChange(kTriggerBit, id, ComponentChange::Removed);
     }
 }
 
@@ -318,6 +391,7 @@ PhysicsCharacter* Scene::AddPhysicsCharacter(EntityId id)
     character.entity = id;
     character.dirty = true;
     SetMaskBit(id, kPhysicsCharacterBit, true);
+    RecordChange(kPhysicsCharacterBit, id, inserted ? ComponentChange::Added : ComponentChange::Modified);
     return &character;
 }
 
@@ -348,6 +422,7 @@ void Scene::RemovePhysicsCharacter(EntityId id)
     {
         m_physicsCharacters.erase(it);
         SetMaskBit(id, kPhysicsCharacterBit, false);
+        RecordChange(kPhysicsCharacterBit, id, ComponentChange::Removed);
     }
 }
 
@@ -414,7 +489,7 @@ const std::vector<EntityId>& Scene::GetChildren(EntityId parent) const
 
 size_t Scene::GetEntityCount() const
 {
-    return m_entityMasks.size();
+    return m_aliveCount;
 }
 
 size_t Scene::GetTransformCount() const
@@ -508,6 +583,45 @@ std::unordered_map<EntityId, PhysicsCharacter>& Scene::GetPhysicsCharacters()
 void Scene::SetLogicalLookup(std::unordered_map<std::string, EntityId> lookup)
 {
     m_logicalIds = std::move(lookup);
+    m_logicalKeysByEntity.clear();
+    for (const auto& [key, entity] : m_logicalIds)
+    {
+        m_logicalKeysByEntity[entity].push_back(key);
+    }
+}
+
+void Scene::SetLogicalId(const std::string& key, EntityId id)
+{
+    auto [it, inserted] = m_logicalIds.try_emplace(key, id);
+    if (!inserted)
+    {
+        if (it->second == id)
+        {
+            return;
+        }
+        RemoveLogicalId(key);
+        m_logicalIds.emplace(key, id);
+    }
+    m_logicalKeysByEntity[id].push_back(key);
+}
+
+void Scene::RemoveLogicalId(const std::string& key)
+{
+    auto it = m_logicalIds.find(key);
+    if (it == m_logicalIds.end())
+    {
+        return;
+    }
+
+    if (auto keysIt = m_logicalKeysByEntity.find(it->second); keysIt != m_logicalKeysByEntity.end())
+    {
+        std::erase(keysIt->second, key);
+        if (keysIt->second.empty())
+        {
+            m_logicalKeysByEntity.erase(keysIt);
+        }
+    }
+    m_logicalIds.erase(it);
 }
 
 EntityId Scene::FindEntityByLogicalId(const std::string& key) const
@@ -554,13 +668,38 @@ bool Scene::HasTransform(EntityId id) const
     return m_transforms.find(id) != m_transforms.end();
 }
 
+const ComponentChangeLog& Scene::GetChanges(ComponentType type) const
+{
+    return m_changes[static_cast<size_t>(type)];
+}
+
+void Scene::MarkModified(ComponentType type, EntityId id)
+{
+    if (IsAlive(id))
+    {
+        m_changes[static_cast<size_t>(type)].Record(id, ComponentChange::Modified);
+    }
+}
+
+void Scene::DiscardChanges()
+{
+    for (ComponentChangeLog& log : m_changes)
+    {
+        log.Discard();
+    }
+}
+
+void Scene::RecordChange(size_t bit, EntityId id, ComponentChange change)
+{
+    m_changes[bit].Record(id, change);
+}
+
 void Scene::SetMaskBit(EntityId id, size_t bit, bool value)
 {
-    auto it = m_entityMasks.find(id);
-    if (it == m_entityMasks.end())
+    if (!IsAlive(id))
     {
         return;
     }
-    it->second.set(bit, value);
+    m_entityMasks[EntityIndex(id)].set(bit, value);
 }
 
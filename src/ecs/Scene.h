@@ -1,15 +1,18 @@
 #pragma once
 
 #include "Entity.h"
+#include "ComponentChangeLog.h"
 #include "Transform.h"
 #include "MeshRenderer.h"
 #include "PhysicsComponents.h"
 #include "../physics/PhysicsCharacter.h"
 
+#include <array>
 #include <unordered_map>
 #include <string>
 #include <vector>
 #include <bitset>
+#include <deque>
 #include <functional>
 #include <memory>
 
@@ -19,11 +22,18 @@ struct Material;
 class Scene
 {
 public:
-    Scene() = default;
+    Scene();
 
+    // Devuelve kInvalidEntity si se agotan los índices.
     EntityId CreateEntity();
     void     DestroyEntity(EntityId id);
-    bool     IsAlive(EntityId id) const;
+    // Un acceso al array de generaciones: los ids de entidades destruidas
+    // (aunque su slot ya se haya reutilizado) no están vivos.
+    bool     IsAlive(EntityId id) const
+    {
+        const uint32_t index = EntityIndex(id);
+        return index < m_generations.size() && m_generations[index] == EntityGeneration(id);
+    }
 
     Transform*       AddTransform(EntityId id);
     Transform*       GetTransform(EntityId id);
@@ -38,16 +48,19 @@ public:
     Collider*       AddCollider(EntityId id);
     Collider*       GetCollider(EntityId id);
     const Collider* GetCollider(EntityId id) const;
+    Collider*       EditCollider(EntityId id);
     void            RemoveCollider(EntityId id);
 
     RigidBody*       AddRigidBody(EntityId id);
     RigidBody*       GetRigidBody(EntityId id);
     const RigidBody* GetRigidBody(EntityId id) const;
+    RigidBody*       EditRigidBody(EntityId id);
     void             RemoveRigidBody(EntityId id);
 
     TriggerVolume*       AddTriggerVolume(EntityId id);
     TriggerVolume*       GetTriggerVolume(EntityId id);
     const TriggerVolume* GetTriggerVolume(EntityId id) const;
+    TriggerVolume*       EditTriggerVolume(EntityId id);
     void                 RemoveTriggerVolume(EntityId id);
 
     PhysicsCharacter*       AddPhysicsCharacter(EntityId id);
@@ -65,6 +78,18 @@ public:
     size_t GetPhysicsCharacterCount() const;
     size_t CountDirtyTransforms() const;
 
+    // Cambios por tipo de componente. Add* registra Added (o Modified si ya
+    // existía) y Remove*/DestroyEntity registran Removed. Las escrituras a
+    // través de Get* no se ven: para cambiar un Collider, RigidBody o
+    // TriggerVolume ya añadido se usa Edit*, que marca dirty y registra
+    // Modified; en el resto de tipos, MarkModified. En debug las físicas
+    // avisan de los cambios que se salten esto. Los Transform no registran
+    // Modified; para eso está su flag dirty.
+    const ComponentChangeLog& GetChanges(ComponentType type) const;
+    void MarkModified(ComponentType type, EntityId id);
+    // Olvida los cambios registrados (una escena recién cargada se consume entera).
+    void DiscardChanges();
+
     const std::unordered_map<EntityId, Transform>& GetTransforms() const;
     std::unordered_map<EntityId, Transform>&       GetTransforms();
     const std::unordered_map<EntityId, MeshRenderer>& GetMeshRenderers() const;
@@ -79,6 +104,9 @@ public:
     std::unordered_map<EntityId, PhysicsCharacter>&       GetPhysicsCharacters();
 
     void SetLogicalLookup(std::unordered_map<std::string, EntityId> lookup);
+    // Alta o cambio de una sola clave, sin tocar el resto del mapa.
+    void SetLogicalId(const std::string& key, EntityId id);
+    void RemoveLogicalId(const std::string& key);
     EntityId FindEntityByLogicalId(const std::string& key) const;
     const std::unordered_map<std::string, EntityId>& GetLogicalLookup() const { return m_logicalIds; }
 
@@ -92,9 +120,13 @@ private:
     using ComponentMask = std::bitset<32>;
 
     void SetMaskBit(EntityId id, size_t bit, bool value);
+    void RecordChange(size_t bit, EntityId id, ComponentChange change);
 
 private:
-    std::unordered_map<EntityId, ComponentMask>    m_entityMasks;
+    // Por índice de slot. El slot 0 no se usa (kInvalidEntity) y su generación
+    // no cabe en un id, así que IsAlive(kInvalidEntity) es false sin otro caso.
+    std::vector<uint32_t>                          m_generations;
+    std::vector<ComponentMask>                     m_entityMasks;
     std::unordered_map<EntityId, Transform>        m_transforms;
     std::unordered_map<EntityId, MeshRenderer>     m_meshRenderers;
     std::unordered_map<EntityId, Collider>         m_colliders;
@@ -104,7 +136,12 @@ private:
     std::unordered_map<EntityId, EntityId>         m_parents;
     std::unordered_map<EntityId, std::vector<EntityId>> m_children;
     std::unordered_map<std::string, EntityId>      m_logicalIds;
-    std::vector<EntityId>                          m_freeIds;
-    EntityId                                       m_nextId = kInvalidEntity;
+    // Índice inverso de m_logicalIds: destruir sólo borra las claves propias
+    std::unordered_map<EntityId, std::vector<std::string>> m_logicalKeysByEntity;
+    // FIFO y sin tocar hasta tener kMinFreeIndices: un slot tarda en volver a
+    // usarse y la generación (10 bits) tarda mucho más en dar la vuelta.
+    std::deque<uint32_t>                           m_freeIndices;
+    size_t                                         m_aliveCount = 0;
+    std::array<ComponentChangeLog, static_cast<size_t>(ComponentType::Count)> m_changes;
 };
 
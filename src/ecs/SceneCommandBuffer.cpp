@@ -0,0 +1,268 @@
+#include "SceneCommandBuffer.h"
+#include "Scene.h"
+#include "../core/Profiler.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace
+{
+    std::atomic<uint64_t> g_nextQueueSerial{1};
+
+    // Último buffer usado por este hilo, para no tomar el mutex en cada comando
+    struct LocalBufferCache
+    {
+        uint64_t            serial = 0;
+        SceneCommandBuffer* buffer = nullptr;
+    };
+    thread_local LocalBufferCache t_localBuffer;
+
+    void AddTo(Scene&, EntityId, const std::monostate&)
+    {
+    }
+
+    void AddTo(Scene& scene, EntityId id, const Transform& value)
+    {
+        if (Transform* transform = scene.AddTransform(id))
+        {
+            *transform = value;
+            scene.MarkHierarchyDirty(id);
+        }
+    }
+
+    void AddTo(Scene& scene, EntityId id, const MeshRenderer& value)
+    {
+        if (MeshRenderer* renderer = scene.AddMeshRenderer(id))
+        {
+            *renderer = value;
+        }
+    }
+
+    void AddTo(Scene& scene, EntityId id, const Collider& value)
+    {
+        if (Collider* collider = scene.AddCollider(id))
+        {
+            *collider = value;
+            collider->dirty = true;
+        }
+    }
+
+    void AddTo(Scene& scene, EntityId id, const RigidBody& value)
+    {
+        if (RigidBody* body = scene.AddRigidBody(id))
+        {
+            *body = value;
+            body->dirty = true;
+        }
+    }
+
+    void AddTo(Scene& scene, EntityId id, const TriggerVolume& value)
+    {
+        if (TriggerVolume* trigger = scene.AddTriggerVolume(id))
+        {
+            *trigger = value;
+            trigger->dirty = true;
+        }
+    }
+
+    void AddTo(Scene& scene, EntityId id, const PhysicsCharacter& value)
+    {
+        if (PhysicsCharacter* character = scene.AddPhysicsCharacter(id))
+        {
+            *character = value;
+            character->entity = id;
+            character->ghost = nullptr;
+            character->controller = nullptr;
+            character->dirty = true;
+        }
+    }
+
+    void RemoveFrom(Scene&, EntityId, const std::monostate&) {}
+    void RemoveFrom(Scene& scene, EntityId id, const Transform&) { scene.RemoveTransform(id); }
+    void RemoveFrom(Scene& scene, EntityId id, const MeshRenderer&) { scene.RemoveMeshRenderer(id); }
+    void RemoveFrom(Scene& scene, EntityId id, const Collider&) { scene.RemoveCollider(id); }
+    void RemoveFrom(Scene& scene, EntityId id, const RigidBody&) { scene.RemoveRigidBody(id); }
+    void RemoveFrom(Scene& scene, EntityId id, const TriggerVolume&) { scene.RemoveTriggerVolume(id); }
+    void RemoveFrom(Scene& scene, EntityId id, const PhysicsCharacter&) { scene.RemovePhysicsCharacter(id); }
+}
+
+SceneCommandBuffer::PendingEntity SceneCommandBuffer::CreateEntity()
+{
+    const PendingEntity entity{m_pendingCount++};
+    Record(CommandType::Create, EntityRef{kInvalidEntity, entity.index}, EntityRef{}, std::monostate{});
+    return entity;
+}
+
+void SceneCommandBuffer::DestroyEntity(EntityId id)
+{
+    Record(CommandType::Destroy, EntityRef{id}, EntityRef{}, std::monostate{});
+}
+
+void SceneCommandBuffer::DestroyEntity(PendingEntity entity)
+{
+    Record(CommandType::Destroy, EntityRef{kInvalidEntity, entity.index}, EntityRef{}, std::monostate{});
+}
+
+void SceneCommandBuffer::SetParent(EntityId child, EntityId parent)
+{
+    Record(CommandType::SetParent, EntityRef{child}, EntityRef{parent}, std::monostate{});
+}
+
+void SceneCommandBuffer::SetParent(PendingEntity child, EntityId parent)
+{
+    Record(CommandType::SetParent, EntityRef{kInvalidEntity, child.index}, EntityRef{parent}, std::monostate{});
+}
+
+void SceneCommandBuffer::SetParent(PendingEntity child, PendingEntity parent)
+{
+    Record(CommandType::SetParent, EntityRef{kInvalidEntity, child.index}, EntityRef{kInvalidEntity, parent.index}, std::monostate{});
+}
+
+void SceneCommandBuffer::Record(CommandType type, EntityRef entity, EntityRef parent, ComponentValue component)
+{
+    m_commands.push_back(Command{type, entity, parent, std::move(component), m_sortKey});
+}
+
+EntityId SceneCommandBuffer::Resolve(const EntityRef& ref, const std::vector<EntityId>& created)
+{
+    if (ref.pending == UINT32_MAX)
+    {
+        return ref.id;
+    }
+    return ref.pending < created.size() ? created[ref.pending] : kInvalidEntity;
+}
+
+void SceneCommandBuffer::Playback(Scene& scene, std::vector<EntityId>* created)
+{
+    std::vector<EntityId> localCreated;
+    std::vector<EntityId>& ids = created ? *created : localCreated;
+    ids.assign(m_pendingCount, kInvalidEntity);
+
+    for (const Command& command : m_commands)
+    {
+        Apply(scene, command, ids);
+    }
+    Clear();
+}
+
+void SceneCommandBuffer::Apply(Scene& scene, const Command& command, std::vector<EntityId>& created)
+{
+    if (command.type == CommandType::Create)
+    {
+        created[command.entity.pending] = scene.CreateEntity();
+        return;
+    }
+
+    // Add*/Remove*/SetParent ya ignoran ids que no están vivos
+    const EntityId id = Resolve(command.entity, created);
+    switch (command.type)
+    {
+    case CommandType::Destroy:
+        scene.DestroyEntity(id);
+        break;
+    case CommandType::AddComponent:
+        std::visit([&](const auto& value) { AddTo(scene, id, value); }, command.component);
+        break;
+    case CommandType::RemoveComponent:
+        std::visit([&](const auto& value) { RemoveFrom(scene, id, value); }, command.component);
+        break;
+    case CommandType::SetParent:
+        scene.SetParent(id, Resolve(command.parent, created));
+        break;
+    default:
+        break;
+    }
+}
+
+void SceneCommandBuffer::Clear()
+{
+    m_commands.clear();
+    m_pendingCount = 0;
+    m_sortKey = 0;
+}
+
+SceneCommandQueue::SceneCommandQueue()
+    : m_serial(g_nextQueueSerial.fetch_add(1, std::memory_order_relaxed))
+{
+}
+
+SceneCommandQueue::~SceneCommandQueue() = default;
+
+SceneCommandBuffer& SceneCommandQueue::Local()
+{
+    if (t_localBuffer.serial == m_serial)
+    {
+        return *t_localBuffer.buffer;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const std::thread::id self = std::this_thread::get_id();
+    ThreadBuffer* found = nullptr;
+    for (const auto& entry : m_buffers)
+    {
+        if (entry->thread == self)
+        {
+            found = entry.get();
+            break;
+        }
+    }
+    if (!found)
+    {
+        m_buffers.push_back(std::make_unique<ThreadBuffer>());
+        found = m_buffers.back().get();
+        found->thread = self;
+    }
+
+    t_localBuffer.serial = m_serial;
+    t_localBuffer.buffer = &found->buffer;
+    return found->buffer;
+}
+
+size_t SceneCommandQueue::Playback(Scene& scene)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_order.clear();
+    for (size_t b = 0; b < m_buffers.size(); ++b)
+    {
+        const std::vector<SceneCommandBuffer::Command>& commands = m_buffers[b]->buffer.m_commands;
+        for (size_t c = 0; c < commands.size(); ++c)
+        {
+            m_order.push_back(OrderedCommand{commands[c].sortKey, static_cast<uint32_t>(b), static_cast<uint32_t>(c)});
+        }
+    }
+    if (m_order.empty())
+    {
+        return 0;
+    }
+
+    PROFILE_SCOPE("SceneCommands::Playback");
+    // Estable: a igual clave se conserva el orden de grabación de cada buffer
+    std::stable_sort(m_order.begin(), m_order.end(), [](const OrderedCommand& lhs, const OrderedCommand& rhs)
+    {
+        return lhs.sortKey < rhs.sortKey;
+    });
+
+    for (const auto& entry : m_buffers)
+    {
+        entry->created.assign(entry->buffer.m_pendingCount, kInvalidEntity);
+    }
+    for (const OrderedCommand& ref : m_order)
+    {
+        ThreadBuffer& entry = *m_buffers[ref.buffer];
+        SceneCommandBuffer::Apply(scene, entry.buffer.m_commands[ref.command], entry.created);
+    }
+    for (const auto& entry : m_buffers)
+    {
+        entry->buffer.Clear();
+    }
+    return m_order.size();
+}
+
+void SceneCommandQueue::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& entry : m_buffers)
+    {
+        entry->buffer.Clear();
+    }
+}
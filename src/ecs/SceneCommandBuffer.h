@@ -0,0 +1,158 @@
+#pragma once
+
+#include "Entity.h"
+#include "Transform.h"
+#include "MeshRenderer.h"
+#include "PhysicsComponents.h"
+#include "../physics/PhysicsCharacter.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <variant>
+#include <vector>
+
+class Scene;
+
+// Cambios estructurales diferidos (crear/destruir entidades, añadir/quitar
+// componentes, padres) grabados mientras los sistemas recorren la escena y
+// aplicados de golpe en un punto de sincronización con Playback. Un buffer lo
+// usa un solo hilo; para varios hilos está SceneCommandQueue.
+class SceneCommandBuffer
+{
+public:
+    // Entidad creada en este buffer; su EntityId real existe tras Playback.
+    struct PendingEntity
+    {
+        uint32_t index = UINT32_MAX;
+    };
+
+    PendingEntity CreateEntity();
+    void          DestroyEntity(EntityId id);
+    void          DestroyEntity(PendingEntity entity);
+
+    // Añade o sustituye el componente con el valor dado.
+    template<typename T>
+    void AddComponent(EntityId id, const T& value)
+    {
+        Record(CommandType::AddComponent, EntityRef{id}, EntityRef{}, value);
+    }
+    template<typename T>
+    void AddComponent(PendingEntity entity, const T& value)
+    {
+        Record(CommandType::AddComponent, EntityRef{kInvalidEntity, entity.index}, EntityRef{}, value);
+    }
+
+    template<typename T>
+    void RemoveComponent(EntityId id)
+    {
+        Record(CommandType::RemoveComponent, EntityRef{id}, EntityRef{}, T{});
+    }
+
+    void SetParent(EntityId child, EntityId parent);
+    void SetParent(PendingEntity child, EntityId parent);
+    void SetParent(PendingEntity child, PendingEntity parent);
+
+    // Clave con la que se marcan los comandos grabados a partir de ahora
+    // (p. ej. el índice del elemento de un ParallelFor). SceneCommandQueue
+    // aplica por clave creciente para que el resultado no dependa del hilo
+    // que procesó cada elemento. Una PendingEntity sólo debe usarse con la
+    // misma clave con la que se creó.
+    void     SetSortKey(uint64_t key) { m_sortKey = key; }
+    uint64_t GetSortKey() const { return m_sortKey; }
+
+    // Aplica los comandos en el orden en que se grabaron (sin mirar la clave)
+    // y vacía el buffer. Los que apuntan a entidades ya destruidas se ignoran. 'created' recibe
+    // el id real de cada PendingEntity (por su índice).
+    void Playback(Scene& scene, std::vector<EntityId>* created = nullptr);
+
+    bool   IsEmpty() const { return m_commands.empty(); }
+    size_t GetCommandCount() const { return m_commands.size(); }
+    void   Clear();
+
+private:
+    enum class CommandType : uint8_t
+    {
+        Create,
+        Destroy,
+        AddComponent,
+        RemoveComponent,
+        SetParent,
+    };
+
+    using ComponentValue = std::variant<std::monostate, Transform, MeshRenderer, Collider, RigidBody, TriggerVolume, PhysicsCharacter>;
+
+    // Entidad existente (id) o creada en este buffer (pending)
+    struct EntityRef
+    {
+        EntityId id = kInvalidEntity;
+        uint32_t pending = UINT32_MAX;
+    };
+
+    struct Command
+    {
+        CommandType    type = CommandType::Create;
+        EntityRef      entity;
+        EntityRef      parent;
+        ComponentValue component;
+        uint64_t       sortKey = 0;
+    };
+
+    friend class SceneCommandQueue;
+
+    void Record(CommandType type, EntityRef entity, EntityRef parent, ComponentValue component);
+    static EntityId Resolve(const EntityRef& ref, const std::vector<EntityId>& created);
+    static void     Apply(Scene& scene, const Command& command, std::vector<EntityId>& created);
+
+private:
+    std::vector<Command> m_commands;
+    uint32_t             m_pendingCount = 0;
+    uint64_t             m_sortKey = 0;
+};
+
+// Un SceneCommandBuffer por hilo. Local() no bloquea salvo la primera vez que
+// un hilo graba en la cola; Playback se llama con todos los hilos parados
+// (p. ej. tras un ThreadPool::ParallelFor) y mezcla los buffers por clave
+// (SceneCommandBuffer::SetSortKey). Está garantizado el orden entre claves
+// distintas y, dentro de una clave, el de grabación de cada buffer; comandos
+// con la misma clave grabados desde hilos distintos no tienen orden fijo
+// entre ellos (dependen de qué hilo usó antes la cola).
+class SceneCommandQueue
+{
+public:
+    SceneCommandQueue();
+    ~SceneCommandQueue();
+
+    SceneCommandQueue(const SceneCommandQueue&) = delete;
+    SceneCommandQueue& operator=(const SceneCommandQueue&) = delete;
+
+    SceneCommandBuffer& Local();
+
+    // Devuelve el número de comandos aplicados.
+    size_t Playback(Scene& scene);
+    // Descarta lo grabado (p. ej. al sustituir la escena entera).
+    void Clear();
+
+private:
+    struct ThreadBuffer
+    {
+        std::thread::id       thread;
+        SceneCommandBuffer    buffer;
+        std::vector<EntityId> created; // PendingEntity -> id durante Playback
+    };
+
+    // Referencia a un comando de m_buffers para ordenarlos sin moverlos
+    struct OrderedCommand
+    {
+        uint64_t sortKey = 0;
+        uint32_t buffer = 0;
+        uint32_t command = 0;
+    };
+
+    std::mutex                                 m_mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+    std::vector<OrderedCommand>                m_order;
+    uint64_t                                   m_serial = 0; // distingue colas en la caché por hilo
+};
@@ -17,17 +17,14 @@ void Transform::MarkDirty()
 
 void Transform::RecalculateLocalMatrix()
 {
-    bx::mtxSRT(local,
-               scale.x, scale.y, scale.z,
-               rotationEuler.x, rotationEuler.y, rotationEuler.z,
-               position.x, position.y, position.z);
+    math::MtxFromTRS(local, position, rotation, scale);
 }
 
 void Transform::UpdateWorldMatrix(const float* parentWorld)
 {
     if (parentWorld)
     {
-        bx::mtxMul(world, parentWorld, local);
+        math::MtxMul(world, parentWorld, local);
     }
     else
     {
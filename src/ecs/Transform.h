@@ -1,18 +1,12 @@
 #pragma once
 
 #include "Entity.h"
-
-struct float3
-{
-    float x = 0.0f;
-    float y = 0.0f;
-    float z = 0.0f;
-};
+#include "../math/SimdMath.h"
 
 struct Transform
 {
     float3 position{0.0f, 0.0f, 0.0f};
-    float3 rotationEuler{0.0f, 0.0f, 0.0f};
+    quat   rotation{};  // las escenas la escriben en Euler; ver math::QuatFromEuler
     float3 scale{1.0f, 1.0f, 1.0f};
     float  local[16]{};
     float  world[16]{};
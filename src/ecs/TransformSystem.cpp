@@ -1,13 +1,12 @@
 #include "TransformSystem.h"
 
+#include "ArchetypeStorage.h"
 #include "Scene.h"
 #include "Transform.h"
 
-#include <bx/math.h>
-
 namespace
 {
-    void UpdateNode(Scene& scene, EntityId entity, const float* parentWorld, bool parentDirty)
+    void UpdateNode(Scene& scene, EntityId entity, const float* parentWorld, bool parentDirty, size_t& dirtyCount)
     {
         Transform* transform = scene.GetTransform(entity);
         if (!transform)
@@ -19,6 +18,7 @@ namespace
         if (localDirty)
         {
             transform->RecalculateLocalMatrix();
+            ++dirtyCount;
         }
 
         bool worldDirty = localDirty || parentDirty;
@@ -32,16 +32,85 @@ namespace
         const auto& children = scene.GetChildren(entity);
         for (EntityId child : children)
         {
-            UpdateNode(scene, child, transform->world, worldDirty);
+            UpdateNode(scene, child, transform->world, worldDirty, dirtyCount);
         }
     }
+
+    // Misma fórmula que math::MtxFromTRS, una entidad por carril y sin trigonometría
+    void ComputeWorldColumns(const ArchetypeStorage::TransformColumns& c, size_t count)
+    {
+        const float* __restrict px = c.position[0];
+        const float* __restrict py = c.position[1];
+        const float* __restrict pz = c.position[2];
+        const float* __restrict qx = c.rotation[0];
+        const float* __restrict qy = c.rotation[1];
+        const float* __restrict qz = c.rotation[2];
+        const float* __restrict qw = c.rotation[3];
+        const float* __restrict scx = c.scale[0];
+        const float* __restrict scy = c.scale[1];
+        const float* __restrict scz = c.scale[2];
+        float* __restrict w0 = c.world[0];
+        float* __restrict w1 = c.world[1];
+        float* __restrict w2 = c.world[2];
+        float* __restrict w4 = c.world[4];
+        float* __restrict w5 = c.world[5];
+        float* __restrict w6 = c.world[6];
+        float* __restrict w8 = c.world[8];
+        float* __restrict w9 = c.world[9];
+        float* __restrict w10 = c.world[10];
+        float* __restrict w12 = c.world[12];
+        float* __restrict w13 = c.world[13];
+        float* __restrict w14 = c.world[14];
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float x2 = qx[i] + qx[i];
+            const float y2 = qy[i] + qy[i];
+            const float z2 = qz[i] + qz[i];
+            const float xx = qx[i] * x2;
+            const float yy = qy[i] * y2;
+            const float zz = qz[i] * z2;
+            const float xy = qx[i] * y2;
+            const float xz = qx[i] * z2;
+            const float yz = qy[i] * z2;
+            const float wx = qw[i] * x2;
+            const float wy = qw[i] * y2;
+            const float wz = qw[i] * z2;
+
+            w0[i]  = scx[i] * (1.0f - (yy + zz));
+            w1[i]  = scx[i] * (xy + wz);
+            w2[i]  = scx[i] * (xz - wy);
+            w4[i]  = scy[i] * (xy - wz);
+            w5[i]  = scy[i] * (1.0f - (xx + zz));
+            w6[i]  = scy[i] * (yz + wx);
+            w8[i]  = scz[i] * (xz + wy);
+            w9[i]  = scz[i] * (yz - wx);
+            w10[i] = scz[i] * (1.0f - (xx + yy));
+            w12[i] = px[i];
+            w13[i] = py[i];
+            w14[i] = pz[i];
+        }
+        // 3, 7, 11 y 15 son constantes desde el alta de la fila
+    }
 }
 
-void TransformSystem::Update(Scene& scene)
+size_t TransformSystem::Update(Scene& scene)
 {
-    scene.ForEachRootTransform([&scene](EntityId entity)
+    size_t dirtyCount = 0;
+    scene.ForEachRootTransform([&scene, &dirtyCount](EntityId entity)
     {
-        UpdateNode(scene, entity, nullptr, false);
+        UpdateNode(scene, entity, nullptr, false, dirtyCount);
     });
+    return dirtyCount;
 }
 
+
+void TransformSystem::UpdateArchetypes(ArchetypeStorage& storage)
+{
+    ArchetypeStorage::Mask required;
+    required.set(static_cast<size_t>(ComponentType::Transform));
+    storage.ForEachChunk(required, [](ArchetypeStorage::ChunkView& chunk)
+    {
+        ComputeWorldColumns(chunk.transform, chunk.count);
+    });
+}
@@ -1,10 +1,19 @@
 #pragma once
 
+#include <cstddef>
+
 class Scene;
+class ArchetypeStorage;
 
 class TransformSystem
 {
 public:
-    static void Update(Scene& scene);
+    // Devuelve cuántos Transform tenían dirty (los que se han recalculado).
+    static size_t Update(Scene& scene);
+
+    // Recalcula la matriz mundo de todas las filas con Transform de un
+    // ArchetypeStorage (sin jerarquía: world = SRT). Recorre las columnas SoA
+    // de cada chunk en un bucle sin saltos que el compilador vectoriza.
+    static void UpdateArchetypes(ArchetypeStorage& storage);
 };
 
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+
+// Evento de teclado/ratón capturado por los callbacks de GLFW en Window.
+// 'time' es glfwGetTime() en el momento del callback, así que el orden y el
+// instante de pulsaciones dentro de un mismo frame se conservan.
+struct InputEvent
+{
+    enum class Type : uint8_t
+    {
+        Key,
+        MouseButton,
+        Scroll,
+    };
+
+    Type   type = Type::Key;
+    bool   down = false;  // Key/MouseButton: pulsado (true) o soltado (false)
+    int    code = 0;      // GLFW_KEY_* o GLFW_MOUSE_BUTTON_*
+    float  scrollX = 0.0f;
+    float  scrollY = 0.0f;
+    double time = 0.0;
+};
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+
+// Handle de un eje o acción: índice en los arrays planos de InputSystem.
+// Se resuelve una vez por nombre y sigue siendo válido al recargar bindings
+// (los nombres nunca se des-registran). Ejes y acciones tienen espacios de
+// índices separados.
+struct InputId
+{
+    static constexpr uint32_t kInvalid = UINT32_MAX;
+
+    uint32_t index = kInvalid;
+
+    bool IsValid() const { return index != kInvalid; }
+};
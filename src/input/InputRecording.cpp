@@ -0,0 +1,339 @@
+#include "InputRecording.h"
+
+#include "InputSystem.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+    constexpr char     kMagic[4] = {'S', 'C', 'I', 'R'};
+    constexpr uint32_t kVersion = 1;
+
+    template <typename T>
+    void WritePod(std::FILE* file, const T& value)
+    {
+        std::fwrite(&value, sizeof(T), 1, file);
+    }
+
+    void WriteString(std::FILE* file, const std::string& text)
+    {
+        const uint16_t length = static_cast<uint16_t>(std::min<size_t>(text.size(), UINT16_MAX));
+        WritePod(file, length);
+        std::fwrite(text.data(), 1, length, file);
+    }
+
+    class ByteReader
+    {
+    public:
+        ByteReader(const uint8_t* data, size_t size)
+            : m_data(data)
+            , m_size(size)
+        {
+        }
+
+        template <typename T>
+        bool Read(T& out)
+        {
+            if (m_offset + sizeof(T) > m_size)
+            {
+                return false;
+            }
+            std::memcpy(&out, m_data + m_offset, sizeof(T));
+            m_offset += sizeof(T);
+            return true;
+        }
+
+        bool ReadString(std::string& out)
+        {
+            uint16_t length = 0;
+            if (!Read(length) || m_offset + length > m_size)
+            {
+                return false;
+            }
+            out.assign(reinterpret_cast<const char*>(m_data + m_offset), length);
+            m_offset += length;
+            return true;
+        }
+
+        bool ReadBytes(void* out, size_t count)
+        {
+            if (m_offset + count > m_size)
+            {
+                return false;
+            }
+            std::memcpy(out, m_data + m_offset, count);
+            m_offset += count;
+            return true;
+        }
+
+        size_t Remaining() const { return m_size - m_offset; }
+
+    private:
+        const uint8_t* m_data = nullptr;
+        size_t         m_size = 0;
+        size_t         m_offset = 0;
+    };
+
+    bool Fail(std::string* err, const std::string& message)
+    {
+        if (err)
+        {
+            *err = message;
+        }
+        return false;
+    }
+}
+
+InputRecorder::~InputRecorder()
+{
+    Close();
+}
+
+bool InputRecorder::Open(const std::string& path,
+                         const InputSystem& input,
+                         const InputRecordingInfo& info,
+                         std::string* err)
+{
+    Close();
+
+    m_file = std::fopen(path.c_str(), "wb");
+    if (!m_file)
+    {
+        return Fail(err, "No se pudo crear " + path);
+    }
+
+    m_path = path;
+    m_axisNames = input.GetAxisNames();
+    m_actionNames = input.GetActionNames();
+    m_axisIds.clear();
+    m_actionIds.clear();
+    for (const std::string& name : m_axisNames)
+    {
+        m_axisIds.push_back(input.FindAxis(name));
+    }
+    for (const std::string& name : m_actionNames)
+    {
+        m_actionIds.push_back(input.FindAction(name));
+    }
+    m_frames = 0;
+
+    std::fwrite(kMagic, 1, sizeof(kMagic), m_file);
+    WritePod(m_file, kVersion);
+    m_frameCountOffset = std::ftell(m_file);
+    WritePod(m_file, uint64_t{0});
+    WritePod(m_file, info.fixedStep);
+    WritePod(m_file, static_cast<uint8_t>(info.physicsMultithreaded ? 1 : 0));
+    WriteString(m_file, info.scenePath);
+
+    WritePod(m_file, static_cast<uint32_t>(m_axisNames.size()));
+    for (const std::string& name : m_axisNames)
+    {
+        WriteString(m_file, name);
+    }
+    WritePod(m_file, static_cast<uint32_t>(m_actionNames.size()));
+    for (const std::string& name : m_actionNames)
+    {
+        WriteString(m_file, name);
+    }
+
+    m_frameBuffer.assign(sizeof(double)
+                             + m_axisNames.size() * sizeof(float)
+                             + (m_actionNames.size() + 7) / 8,
+                         0);
+
+    std::printf("[InputRecord] Grabando en %s (%zu ejes, %zu acciones)\n",
+                path.c_str(),
+                m_axisNames.size(),
+                m_actionNames.size());
+    return true;
+}
+
+void InputRecorder::RecordFrame(const InputSystem& input, double dt)
+{
+    if (!m_file)
+    {
+        return;
+    }
+
+    uint8_t* cursor = m_frameBuffer.data();
+    std::memcpy(cursor, &dt, sizeof(dt));
+    cursor += sizeof(dt);
+
+    for (InputId id : m_axisIds)
+    {
+        const float value = input.GetAxis(id);
+        std::memcpy(cursor, &value, sizeof(value));
+        cursor += sizeof(value);
+    }
+
+    std::memset(cursor, 0, (m_actionNames.size() + 7) / 8);
+    for (size_t i = 0; i < m_actionIds.size(); ++i)
+    {
+        if (input.GetAction(m_actionIds[i]).held)
+        {
+            cursor[i / 8] |= static_cast<uint8_t>(1u << (i % 8));
+        }
+    }
+
+    std::fwrite(m_frameBuffer.data(), 1, m_frameBuffer.size(), m_file);
+    ++m_frames;
+}
+
+void InputRecorder::Close()
+{
+    if (!m_file)
+    {
+        return;
+    }
+
+    // Cabecera con el número real de frames
+    std::fseek(m_file, m_frameCountOffset, SEEK_SET);
+    WritePod(m_file, m_frames);
+    std::fclose(m_file);
+    m_file = nullptr;
+
+    std::printf("[InputRecord] %s: %llu frames, %zu bytes/frame\n",
+                m_path.c_str(),
+                static_cast<unsigned long long>(m_frames),
+                m_frameBuffer.size());
+}
+
+bool InputReplay::Load(const std::string& path, std::string* err)
+{
+    *this = InputReplay{};
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+    {
+        return Fail(err, "No se pudo abrir " + path);
+    }
+    const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    ByteReader reader(bytes.data(), bytes.size());
+    char magic[4] = {};
+    uint32_t version = 0;
+    uint64_t headerFrames = 0;
+    uint8_t multithreaded = 0;
+    if (!reader.ReadBytes(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0)
+    {
+        return Fail(err, "No es una grabación de entrada");
+    }
+    if (!reader.Read(version) || version != kVersion)
+    {
+        return Fail(err, "Versión de grabación no soportada: " + std::to_string(version));
+    }
+    if (!reader.Read(headerFrames)
+        || !reader.Read(m_info.fixedStep)
+        || !reader.Read(multithreaded)
+        || !reader.ReadString(m_info.scenePath))
+    {
+        return Fail(err, "Cabecera truncada");
+    }
+    m_info.physicsMultithreaded = multithreaded != 0;
+
+    uint32_t axisCount = 0;
+    if (!reader.Read(axisCount))
+    {
+        return Fail(err, "Cabecera truncada");
+    }
+    m_axisNames.resize(axisCount);
+    for (std::string& name : m_axisNames)
+    {
+        if (!reader.ReadString(name))
+        {
+            return Fail(err, "Cabecera truncada");
+        }
+    }
+
+    uint32_t actionCount = 0;
+    if (!reader.Read(actionCount))
+    {
+        return Fail(err, "Cabecera truncada");
+    }
+    m_actionNames.resize(actionCount);
+    for (std::string& name : m_actionNames)
+    {
+        if (!reader.ReadString(name))
+        {
+            return Fail(err, "Cabecera truncada");
+        }
+    }
+
+    m_actionBytes = (actionCount + 7) / 8;
+    const size_t frameSize = sizeof(double) + axisCount * sizeof(float) + m_actionBytes;
+    const uint64_t available = reader.Remaining() / frameSize;
+    // Una grabación sin cerrar (crash) tiene 0 en la cabecera: se usa lo que haya.
+    m_frameCount = headerFrames != 0 && headerFrames <= available ? headerFrames : available;
+    if (headerFrames != 0 && headerFrames != available)
+    {
+        std::printf("[InputReplay] %s: cabecera indica %llu frames, el fichero contiene %llu\n",
+                    path.c_str(),
+                    static_cast<unsigned long long>(headerFrames),
+                    static_cast<unsigned long long>(available));
+    }
+
+    m_dt.resize(static_cast<size_t>(m_frameCount));
+    m_axes.resize(static_cast<size_t>(m_frameCount) * axisCount);
+    m_actionBits.resize(static_cast<size_t>(m_frameCount) * m_actionBytes);
+    for (size_t frame = 0; frame < m_frameCount; ++frame)
+    {
+        reader.Read(m_dt[frame]);
+        reader.ReadBytes(m_axes.data() + frame * axisCount, axisCount * sizeof(float));
+        reader.ReadBytes(m_actionBits.data() + frame * m_actionBytes, m_actionBytes);
+    }
+
+    std::printf("[InputReplay] %s: %llu frames, %zu ejes, %zu acciones, escena '%s'\n",
+                path.c_str(),
+                static_cast<unsigned long long>(m_frameCount),
+                m_axisNames.size(),
+                m_actionNames.size(),
+                m_info.scenePath.c_str());
+    return true;
+}
+
+bool InputReplay::ApplyFrame(InputSystem& input, uint64_t frame, double& outDt)
+{
+    if (frame >= m_frameCount)
+    {
+        return false;
+    }
+
+    if (m_boundInput != &input)
+    {
+        m_boundInput = &input;
+        m_axisIds.clear();
+        m_actionIds.clear();
+        for (const std::string& name : m_axisNames)
+        {
+            m_axisIds.push_back(input.RegisterAxis(name));
+        }
+        for (const std::string& name : m_actionNames)
+        {
+            m_actionIds.push_back(input.RegisterAction(name));
+        }
+    }
+
+    if (!input.IsScriptedInput())
+    {
+        input.SetScriptedInput(true);
+    }
+
+    const size_t index = static_cast<size_t>(frame);
+    const float* axes = m_axes.data() + index * m_axisNames.size();
+    for (size_t i = 0; i < m_axisNames.size(); ++i)
+    {
+        input.SetScriptedAxis(m_axisIds[i], axes[i]);
+    }
+
+    const uint8_t* bits = m_actionBits.data() + index * m_actionBytes;
+    for (size_t i = 0; i < m_actionNames.size(); ++i)
+    {
+        input.SetScriptedAction(m_actionIds[i], (bits[i / 8] & (1u << (i % 8))) != 0);
+    }
+
+    outDt = m_dt[index];
+    return true;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "InputId.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+class InputSystem;
+
+// Grabación binaria de la entrada por frame para reproducir sesiones exactas.
+//
+// Formato (little-endian, tipos nativos):
+//   char[4]  "SCIR"
+//   uint32   versión (1)
+//   uint64   frames (0 si la grabación no se cerró; se deduce del tamaño)
+//   double   fixedStep de físicas al grabar
+//   uint8    mundo de físicas multihilo
+//   str      escena             (str = uint16 longitud + bytes)
+//   uint32   nº de ejes,     str nombre por eje
+//   uint32   nº de acciones, str nombre por acción
+//   frames:  double dt | float eje[nEjes] | uint8 bits[(nAcciones + 7) / 8]
+//
+// Se guardan los valores ya resueltos de InputSystem (tras sensibilidad,
+// suavizado y clamp) y el dt del frame, que es todo lo que consume la
+// simulación: al reproducir con el mismo dt el bucle de paso fijo hace los
+// mismos pasos con la misma entrada.
+struct InputRecordingInfo
+{
+    std::string scenePath;
+    double      fixedStep = 0.0;
+    bool        physicsMultithreaded = false;
+};
+
+class InputRecorder
+{
+public:
+    InputRecorder() = default;
+    ~InputRecorder();
+
+    InputRecorder(const InputRecorder&) = delete;
+    InputRecorder& operator=(const InputRecorder&) = delete;
+
+    // Fija los ejes y acciones a grabar con los definidos ahora en 'input'.
+    bool Open(const std::string& path,
+              const InputSystem& input,
+              const InputRecordingInfo& info,
+              std::string* err = nullptr);
+    // Llamar tras InputSystem::Update con el dt que ha usado ese frame.
+    void RecordFrame(const InputSystem& input, double dt);
+    void Close();
+
+    bool     IsOpen() const { return m_file != nullptr; }
+    uint64_t GetFrameCount() const { return m_frames; }
+
+private:
+    std::FILE*               m_file = nullptr;
+    std::string              m_path;
+    std::vector<std::string> m_axisNames;
+    std::vector<std::string> m_actionNames;
+    std::vector<InputId>     m_axisIds;
+    std::vector<InputId>     m_actionIds;
+    std::vector<uint8_t>     m_frameBuffer;
+    long                     m_frameCountOffset = 0;
+    uint64_t                 m_frames = 0;
+};
+
+class InputReplay
+{
+public:
+    bool Load(const std::string& path, std::string* err = nullptr);
+
+    // Fija en 'input' (modo scripted) los valores del frame y devuelve su dt.
+    // false si 'frame' está fuera de la grabación.
+    bool ApplyFrame(InputSystem& input, uint64_t frame, double& outDt);
+
+    uint64_t                  GetFrameCount() const { return m_frameCount; }
+    const InputRecordingInfo& GetInfo() const { return m_info; }
+
+private:
+    InputRecordingInfo       m_info;
+    std::vector<std::string> m_axisNames;
+    std::vector<std::string> m_actionNames;
+    const InputSystem*       m_boundInput = nullptr; // dueño de m_axisIds/m_actionIds
+    std::vector<InputId>     m_axisIds;
+    std::vector<InputId>     m_actionIds;
+    std::vector<double>      m_dt;          // por frame
+    std::vector<float>       m_axes;        // frame * nEjes + eje
+    std::vector<uint8_t>     m_actionBits;  // frame * m_actionBytes + byte
+    size_t                   m_actionBytes = 0;
+    uint64_t                 m_frameCount = 0;
+};
@@ -0,0 +1,137 @@
+#include "InputScript.h"
+
+#include "InputSystem.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+using json = nlohmann::json;
+
+bool InputScript::Load(const std::string& path, std::string* err)
+{
+    m_events.clear();
+    m_cursor = 0;
+    m_loopOffset = 0;
+    m_loop = false;
+
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        if (err)
+        {
+            *err = "No se pudo abrir " + path;
+        }
+        return false;
+    }
+
+    json root;
+    try
+    {
+        file >> root;
+    }
+    catch (const std::exception& e)
+    {
+        if (err)
+        {
+            *err = std::string("JSON inválido: ") + e.what();
+        }
+        return false;
+    }
+
+    m_loop = root.value("loop", false);
+
+    const json events = root.value("events", json::array());
+    if (!events.is_array())
+    {
+        if (err)
+        {
+            *err = "'events' debe ser un array";
+        }
+        return false;
+    }
+
+    for (const json& eventJson : events)
+    {
+        if (!eventJson.is_object())
+        {
+            continue;
+        }
+
+        Event evt;
+        evt.frame = eventJson.value("frame", uint64_t{0});
+
+        if (auto it = eventJson.find("axes"); it != eventJson.end() && it->is_object())
+        {
+            for (auto axis = it->begin(); axis != it->end(); ++axis)
+            {
+                if (axis.value().is_number())
+                {
+                    evt.axes.emplace_back(axis.key(), axis.value().get<float>());
+                }
+            }
+        }
+
+        if (auto it = eventJson.find("actions"); it != eventJson.end() && it->is_object())
+        {
+            for (auto action = it->begin(); action != it->end(); ++action)
+            {
+                if (action.value().is_boolean())
+                {
+                    evt.actions.emplace_back(action.key(), action.value().get<bool>());
+                }
+            }
+        }
+
+        m_events.push_back(std::move(evt));
+    }
+
+    std::stable_sort(m_events.begin(), m_events.end(), [](const Event& a, const Event& b)
+    {
+        return a.frame < b.frame;
+    });
+
+    std::printf("[InputScript] %s: %zu eventos, último frame %llu%s\n",
+                path.c_str(),
+                m_events.size(),
+                static_cast<unsigned long long>(GetLastFrame()),
+                m_loop ? " (loop)" : "");
+    return true;
+}
+
+void InputScript::Apply(InputSystem& input, uint64_t frame)
+{
+    if (!input.IsScriptedInput())
+    {
+        input.SetScriptedInput(true);
+    }
+
+    if (m_events.empty() || frame < m_loopOffset)
+    {
+        return;
+    }
+
+    uint64_t local = frame - m_loopOffset;
+    if (m_loop && m_cursor == m_events.size() && local > GetLastFrame())
+    {
+        m_loopOffset = frame;
+        m_cursor = 0;
+        local = 0;
+    }
+
+    while (m_cursor < m_events.size() && m_events[m_cursor].frame <= local)
+    {
+        const Event& evt = m_events[m_cursor];
+        for (const auto& [name, value] : evt.axes)
+        {
+            input.SetScriptedAxis(name, value);
+        }
+        for (const auto& [name, held] : evt.actions)
+        {
+            input.SetScriptedAction(name, held);
+        }
+        ++m_cursor;
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class InputSystem;
+
+// Guion de entrada para el modo headless. Formato JSON:
+//
+// {
+//   "loop": false,
+//   "events": [
+//     { "frame": 0,   "axes": { "MoveForward": 1.0 } },
+//     { "frame": 120, "axes": { "MoveForward": 0.0, "MoveRight": 1.0 } },
+//     { "frame": 180, "actions": { "Jump": true } },
+//     { "frame": 182, "actions": { "Jump": false } }
+//   ]
+// }
+//
+// Cada valor se mantiene hasta que otro evento lo cambia. Con "loop" el guion
+// vuelve a empezar tras el último frame con eventos.
+class InputScript
+{
+public:
+    bool Load(const std::string& path, std::string* err = nullptr);
+
+    // Aplica a 'input' los eventos del frame indicado. Activa el modo
+    // scripted de InputSystem la primera vez.
+    void Apply(InputSystem& input, uint64_t frame);
+
+    bool     IsEmpty() const { return m_events.empty(); }
+    uint64_t GetLastFrame() const { return m_events.empty() ? 0 : m_events.back().frame; }
+
+private:
+    struct Event
+    {
+        uint64_t frame = 0;
+        std::vector<std::pair<std::string, float>> axes;
+        std::vector<std::pair<std::string, bool>>  actions;
+    };
+
+    std::vector<Event> m_events; // ordenados por frame
+    size_t             m_cursor = 0;
+    uint64_t           m_loopOffset = 0;
+    bool               m_loop = false;
+};
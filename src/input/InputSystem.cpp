@@ -166,8 +166,22 @@ void InputSystem::LoadBindings(const std::string& path)
     
     m_bindingPath = path;
 
-    m_axes.clear();
-    m_actions.clear();
+    // Los nombres se conservan para que los InputId ya resueltos sigan valiendo.
+    for (AxisEntry& entry : m_axes)
+    {
+        entry.bindings.clear();
+        entry.value = 0.0f;
+        entry.defined = false;
+    }
+    for (ActionEntry& entry : m_actions)
+    {
+        entry.bindings.clear();
+        entry.previousHeld = false;
+        entry.state = ActionState{};
+        entry.defined = false;
+    }
+    ResetKeySlots();
+    ++m_layoutVersion;
     ResetMouseSmoothing();
 
     std::ifstream file(path);
@@ -222,7 +236,9 @@ void InputSystem::LoadBindings(const std::string& path)
         for (auto& [axisName, bindings] : axesIt->items())
         {
             //("[DEBUG_LOAD] Loading axis '%s'\n", axisName.c_str());
-            AxisEntry entry;
+            const InputId id = RegisterAxis(axisName);
+            AxisEntry& entry = m_axes[id.index];
+            entry.defined = true;
             if (bindings.is_array())
             {
                 //("[DEBUG_LOAD]   Axis '%s' has %zu bindings\n", axisName.c_str(), bindings.size());
@@ -239,6 +255,7 @@ void InputSystem::LoadBindings(const std::string& path)
                         {
                             axisBinding.type = AxisBinding::Type::Key;
                             axisBinding.key = *keyCode;
+                            axisBinding.keySlot = AcquireKeySlot(*keyCode, false);
                             entry.bindings.push_back(axisBinding);
                             //("[DEBUG_LOAD]     Added KEY binding: %s (code=%d)\n", keyIt->get<std::string>().c_str(), *keyCode);
                         }
@@ -263,7 +280,6 @@ void InputSystem::LoadBindings(const std::string& path)
                     }
                 }
             }
-            m_axes.emplace(axisName, std::move(entry));
             //("[DEBUG_LOAD] Axis '%s' loaded with %zu bindings\n", axisName.c_str(), entry.bindings.size());
         }
         //("[DEBUG_LOAD] Total axes loaded: %zu\n", m_axes.size());
@@ -279,7 +295,9 @@ void InputSystem::LoadBindings(const std::string& path)
         for (auto& [actionName, bindings] : actionsIt->items())
         {
             //("[DEBUG_LOAD] Loading action '%s'\n", actionName.c_str());
-            ActionEntry entry;
+            const InputId id = RegisterAction(actionName);
+            ActionEntry& entry = m_actions[id.index];
+            entry.defined = true;
             if (bindings.is_array())
             {
                 for (const auto& binding : bindings)
@@ -292,6 +310,7 @@ void InputSystem::LoadBindings(const std::string& path)
                             ActionBinding actionBinding;
                             actionBinding.type = ActionBinding::Type::Key;
                             actionBinding.code = *keyCode;
+                            actionBinding.keySlot = AcquireKeySlot(*keyCode, false);
                             entry.bindings.push_back(actionBinding);
                             //("[DEBUG_LOAD]   Added action binding: %s\n", keyIt->get<std::string>().c_str());
                         }
@@ -309,6 +328,7 @@ void InputSystem::LoadBindings(const std::string& path)
                             ActionBinding actionBinding;
                             actionBinding.type = ActionBinding::Type::MouseButton;
                             actionBinding.code = *button;
+                            actionBinding.keySlot = AcquireKeySlot(*button, true);
                             entry.bindings.push_back(actionBinding);
                         }
                         else
@@ -318,7 +338,6 @@ void InputSystem::LoadBindings(const std::string& path)
                     }
                 }
             }
-            m_actions.emplace(actionName, std::move(entry));
         }
         //("[DEBUG_LOAD] Total actions loaded: %zu\n", m_actions.size());
     }
@@ -327,6 +346,10 @@ void InputSystem::LoadBindings(const std::string& path)
         //("[ERROR] No 'actions' section found in JSON\n");
     }
 
+    // Los eventos sólo traen cambios: las teclas que ya estaban pulsadas al
+    // recargar se leen una vez.
+    PollDevices();
+
     std::error_code ec;
     auto lastWrite = std::filesystem::last_write_time(path, ec);
     if (!ec)
@@ -366,36 +389,184 @@ void InputSystem::ReloadIfChanged()
 
 void InputSystem::Update(double)
 {
+    // Se vacía la cola siempre, también con script, para que no se llene.
+    DrainEvents();
+
+    if (m_scripted)
+    {
+        UpdateScripted();
+        return;
+    }
+
+    if (!m_eventDriven || !m_glfwWindow)
+    {
+        PollDevices();
+    }
     UpdateActions();
     UpdateAxes();
 }
 
-float InputSystem::GetAxis(std::string_view name) const
+void InputSystem::SetEventDriven(bool enabled)
 {
-    std::string key(name);
-    auto it = m_axes.find(key);
-    if (it == m_axes.end())
+    if (m_eventDriven == enabled)
+    {
+        return;
+    }
+    m_eventDriven = enabled;
+    if (enabled)
     {
-        return 0.0f;
+        // Descarta lo acumulado y parte del estado real de las teclas
+        InputEvent evt;
+        while (m_window && m_window->PopInputEvent(evt))
+        {
+        }
+        PollDevices();
     }
-    return it->second.value;
 }
 
-InputSystem::ActionState InputSystem::GetAction(std::string_view name) const
+void InputSystem::SetScriptedInput(bool enabled)
 {
-    std::string key(name);
-    auto it = m_actions.find(key);
-    if (it == m_actions.end())
+    m_scripted = enabled;
+    if (!enabled)
     {
-        return ActionState{};
+        ClearScriptedValues();
     }
-    return it->second.state;
 }
 
-bool InputSystem::HasAxis(std::string_view name) const
+void InputSystem::SetScriptedAxis(InputId id, float value)
 {
-    std::string key(name);
-    return m_axes.find(key) != m_axes.end();
+    if (id.index < m_axes.size())
+    {
+        // Los nombres del script que no estén en bindings.json cuentan como
+        // definidos para que HasAxis los vea.
+        m_axes[id.index].scriptedValue = value;
+        m_axes[id.index].defined = true;
+    }
+}
+
+void InputSystem::SetScriptedAction(InputId id, bool held)
+{
+    if (id.index < m_actions.size())
+    {
+        m_actions[id.index].scriptedHeld = held;
+        m_actions[id.index].defined = true;
+    }
+}
+
+void InputSystem::ClearScriptedValues()
+{
+    for (AxisEntry& entry : m_axes)
+    {
+        entry.scriptedValue = 0.0f;
+    }
+    for (ActionEntry& entry : m_actions)
+    {
+        entry.scriptedHeld = false;
+    }
+}
+
+void InputSystem::UpdateScripted()
+{
+    for (AxisEntry& entry : m_axes)
+    {
+        entry.value = std::clamp(entry.scriptedValue, -1.0f, 1.0f);
+    }
+
+    for (ActionEntry& entry : m_actions)
+    {
+        const bool held = entry.scriptedHeld;
+        entry.state.held = held;
+        entry.state.pressed = held && !entry.previousHeld;
+        entry.state.released = !held && entry.previousHeld;
+        entry.previousHeld = held;
+    }
+}
+
+InputId InputSystem::RegisterAxis(std::string_view name)
+{
+    if (auto it = m_axisLookup.find(name); it != m_axisLookup.end())
+    {
+        return InputId{it->second};
+    }
+
+    const uint32_t index = static_cast<uint32_t>(m_axes.size());
+    AxisEntry& entry = m_axes.emplace_back();
+    entry.name = std::string(name);
+    m_axisLookup.emplace(entry.name, index);
+    ++m_layoutVersion;
+    return InputId{index};
+}
+
+InputId InputSystem::RegisterAction(std::string_view name)
+{
+    if (auto it = m_actionLookup.find(name); it != m_actionLookup.end())
+    {
+        return InputId{it->second};
+    }
+
+    const uint32_t index = static_cast<uint32_t>(m_actions.size());
+    ActionEntry& entry = m_actions.emplace_back();
+    entry.name = std::string(name);
+    m_actionLookup.emplace(entry.name, index);
+    ++m_layoutVersion;
+    return InputId{index};
+}
+
+InputId InputSystem::FindAxis(std::string_view name) const
+{
+    auto it = m_axisLookup.find(name);
+    return it != m_axisLookup.end() ? InputId{it->second} : InputId{};
+}
+
+InputId InputSystem::FindAction(std::string_view name) const
+{
+    auto it = m_actionLookup.find(name);
+    return it != m_actionLookup.end() ? InputId{it->second} : InputId{};
+}
+
+float InputSystem::GetAxis(InputId id) const
+{
+    return id.index < m_axes.size() ? m_axes[id.index].value : 0.0f;
+}
+
+InputSystem::ActionState InputSystem::GetAction(InputId id) const
+{
+    return id.index < m_actions.size() ? m_actions[id.index].state : ActionState{};
+}
+
+bool InputSystem::HasAxis(InputId id) const
+{
+    return id.index < m_axes.size() && m_axes[id.index].defined;
+}
+
+std::vector<std::string> InputSystem::GetAxisNames() const
+{
+    std::vector<std::string> names;
+    names.reserve(m_axes.size());
+    for (const AxisEntry& entry : m_axes)
+    {
+        if (entry.defined)
+        {
+            names.push_back(entry.name);
+        }
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+std::vector<std::string> InputSystem::GetActionNames() const
+{
+    std::vector<std::string> names;
+    names.reserve(m_actions.size());
+    for (const ActionEntry& entry : m_actions)
+    {
+        if (entry.defined)
+        {
+            names.push_back(entry.name);
+        }
+    }
+    std::sort(names.begin(), names.end());
+    return names;
 }
 
 void InputSystem::ResetMouseSmoothing()
@@ -405,46 +576,111 @@ void InputSystem::ResetMouseSmoothing()
     m_mouseInitialized = false;
 }
 
-void InputSystem::UpdateActions()
+uint32_t InputSystem::AcquireKeySlot(int code, bool mouseButton)
 {
-    if (!m_glfwWindow)
+    std::vector<int32_t>& lookup = mouseButton ? m_buttonSlotByCode : m_keySlotByCode;
+    if (code < 0 || static_cast<size_t>(code) >= lookup.size())
+    {
+        // Fuera de rango para GLFW: slot propio que nunca se pulsa
+        m_polledKeys.push_back(PolledKey{code, mouseButton});
+    }
+    else if (lookup[code] >= 0)
+    {
+        return static_cast<uint32_t>(lookup[code]);
+    }
+    else
+    {
+        lookup[code] = static_cast<int32_t>(m_polledKeys.size());
+        m_polledKeys.push_back(PolledKey{code, mouseButton});
+    }
+    m_keyDown.push_back(0);
+    m_keyPressedInFrame.push_back(0);
+    m_keyReleasedInFrame.push_back(0);
+    return static_cast<uint32_t>(m_polledKeys.size() - 1);
+}
+
+void InputSystem::ResetKeySlots()
+{
+    m_polledKeys.clear();
+    m_keyDown.clear();
+    m_keyPressedInFrame.clear();
+    m_keyReleasedInFrame.clear();
+    m_keySlotByCode.assign(GLFW_KEY_LAST + 1, -1);
+    m_buttonSlotByCode.assign(GLFW_MOUSE_BUTTON_LAST + 1, -1);
+}
+
+void InputSystem::DrainEvents()
+{
+    m_frameEvents.clear();
+    std::fill(m_keyPressedInFrame.begin(), m_keyPressedInFrame.end(), uint8_t{0});
+    std::fill(m_keyReleasedInFrame.begin(), m_keyReleasedInFrame.end(), uint8_t{0});
+    if (!m_window)
+    {
+        return;
+    }
+
+    InputEvent evt;
+    while (m_window->PopInputEvent(evt))
     {
-        for (auto& [_, entry] : m_actions)
+        m_frameEvents.push_back(evt);
+        if (!m_eventDriven || evt.type == InputEvent::Type::Scroll)
+        {
+            // El scroll de los ejes sigue saliendo del acumulado de Window
+            continue;
+        }
+
+        const std::vector<int32_t>& lookup = evt.type == InputEvent::Type::Key ? m_keySlotByCode : m_buttonSlotByCode;
+        if (evt.code < 0 || static_cast<size_t>(evt.code) >= lookup.size() || lookup[evt.code] < 0)
         {
-            entry.state.pressed = false;
-            entry.state.released = entry.previousHeld;
-            entry.state.held = false;
-            entry.previousHeld = false;
+            continue;
         }
+
+        const size_t slot = static_cast<size_t>(lookup[evt.code]);
+        m_keyDown[slot] = evt.down ? 1 : 0;
+        (evt.down ? m_keyPressedInFrame : m_keyReleasedInFrame)[slot] = 1;
+    }
+}
+
+void InputSystem::PollDevices()
+{
+    // Sin ventana todas las teclas cuentan como sueltas
+    if (!m_glfwWindow)
+    {
+        std::fill(m_keyDown.begin(), m_keyDown.end(), uint8_t{0});
         return;
     }
 
-    for (auto& [_, entry] : m_actions)
+    for (size_t i = 0; i < m_polledKeys.size(); ++i)
+    {
+        const PolledKey& key = m_polledKeys[i];
+        const bool inRange = key.code >= 0 && key.code <= (key.mouseButton ? GLFW_MOUSE_BUTTON_LAST : GLFW_KEY_LAST);
+        const int state = !inRange ? GLFW_RELEASE
+            : key.mouseButton ? glfwGetMouseButton(m_glfwWindow, key.code)
+            : glfwGetKey(m_glfwWindow, key.code);
+        m_keyDown[i] = state == GLFW_PRESS ? 1 : 0;
+    }
+}
+
+void InputSystem::UpdateActions()
+{
+    for (ActionEntry& entry : m_actions)
     {
         bool held = false;
+        bool pressedInFrame = false;
+        bool releasedInFrame = false;
         for (const auto& binding : entry.bindings)
         {
-            if (binding.type == ActionBinding::Type::Key)
-            {
-                if (glfwGetKey(m_glfwWindow, binding.code) == GLFW_PRESS)
-                {
-                    held = true;
-                    break;
-                }
-            }
-            else if (binding.type == ActionBinding::Type::MouseButton)
-            {
-                if (glfwGetMouseButton(m_glfwWindow, binding.code) == GLFW_PRESS)
-                {
-                    held = true;
-                    break;
-                }
-            }
+            held |= m_keyDown[binding.keySlot] != 0;
+            pressedInFrame |= m_keyPressedInFrame[binding.keySlot] != 0;
+            releasedInFrame |= m_keyReleasedInFrame[binding.keySlot] != 0;
         }
 
+        // Los *InFrame vienen de eventos: recogen toques que empiezan y
+        // acaban entre dos Update, y también soltar y volver a pulsar una
+        // tecla que ya estaba pulsada.
         entry.state.held = held;
-        entry.state.pressed = held && !entry.previousHeld;
-        entry.state.released = !held && entry.previousHeld;
+        entry.state.pressed = pressedInFrame || (!entry.previousHeld && held);
+        entry.state.released = releasedInFrame || (entry.previousHeld && !held);
         entry.previousHeld = held;
     }
 }
@@ -500,17 +736,17 @@ void InputSystem::UpdateAxes()
 
     //("[DEBUG_INPUT] Processing %zu axes\n", m_axes.size());
     
-    for (auto& [axisName, entry] : m_axes)
+    for (AxisEntry& entry : m_axes)
     {
         float value = 0.0f;
-        //("[DEBUG_INPUT] Axis '%s': %zu bindings\n", axisName.c_str(), entry.bindings.size());
+        //("[DEBUG_INPUT] Axis '%s': %zu bindings\n", entry.name.c_str(), entry.bindings.size());
         
         for (const auto& binding : entry.bindings)
         {
             switch (binding.type)
             {
             case AxisBinding::Type::Key:
-                if (m_glfwWindow && glfwGetKey(m_glfwWindow, binding.key) == GLFW_PRESS)
+                if (m_keyDown[binding.keySlot])
                 {
                     value += binding.scale;
                     //("[DEBUG_INPUT]   Key binding: key=%d, scale=%.2f, NEW_VALUE=%.2f\n", binding.key, binding.scale, value);
@@ -541,6 +777,6 @@ void InputSystem::UpdateAxes()
             }
         }
         entry.value = std::clamp(value, -1.0f, 1.0f);
-        //("[DEBUG_INPUT] Axis '%s' final value: %.2f\n", axisName.c_str(), entry.value);
+        //("[DEBUG_INPUT] Axis '%s' final value: %.2f\n", entry.name.c_str(), entry.value);
     }
 }
\ No newline at end of file
@@ -1,6 +1,11 @@
 #pragma once
 
+#include "InputEvent.h"
+#include "InputId.h"
+
+#include <cstdint>
 #include <filesystem>
+#include <functional>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -25,12 +30,53 @@ public:
     void SetWindow(Window* window);
 
     void LoadBindings(const std::string& path);
+    // Recarga si la fecha del fichero ha cambiado. Lo llama el FileWatcher de
+    // Application, no se consulta en cada frame.
     void ReloadIfChanged();
+    const std::string& GetBindingPath() const { return m_bindingPath; }
     void Update(double dt);
 
-    float GetAxis(std::string_view name) const;
-    ActionState GetAction(std::string_view name) const;
-    bool HasAxis(std::string_view name) const;
+    // Con eventos (por defecto) el estado de teclas y botones sale de la cola
+    // de Window en orden; un toque más corto que un frame da pressed y
+    // released en el mismo frame. Sin eventos se consulta GLFW en cada Update.
+    void SetEventDriven(bool enabled);
+    bool IsEventDriven() const { return m_eventDriven; }
+    // Eventos consumidos en el último Update, en orden de llegada.
+    const std::vector<InputEvent>& GetFrameEvents() const { return m_frameEvents; }
+
+    // Registra el nombre si no existe. Para resolver handles al inicializar.
+    InputId RegisterAxis(std::string_view name);
+    InputId RegisterAction(std::string_view name);
+    // Sin registrar: inválido si el nombre no se ha visto nunca.
+    InputId FindAxis(std::string_view name) const;
+    InputId FindAction(std::string_view name) const;
+    // Cambia cuando se registran nombres nuevos o se recargan los bindings;
+    // quien cachee handles con Find* debe volver a resolverlos entonces.
+    uint32_t GetLayoutVersion() const { return m_layoutVersion; }
+
+    float GetAxis(InputId id) const;
+    ActionState GetAction(InputId id) const;
+    bool HasAxis(InputId id) const;
+
+    // Versiones por nombre (una búsqueda hash por llamada); para código frío.
+    float GetAxis(std::string_view name) const { return GetAxis(FindAxis(name)); }
+    ActionState GetAction(std::string_view name) const { return GetAction(FindAction(name)); }
+    bool HasAxis(std::string_view name) const { return HasAxis(FindAxis(name)); }
+
+    // Nombres de ejes/acciones definidos, ordenados (orden estable para grabar).
+    std::vector<std::string> GetAxisNames() const;
+    std::vector<std::string> GetActionNames() const;
+
+    // Entrada por script (modo headless): con el modo activo Update() ignora
+    // teclado y ratón y toma los valores fijados aquí, que se mantienen hasta
+    // que se cambian. pressed/released se derivan igual que con GLFW.
+    void SetScriptedInput(bool enabled);
+    bool IsScriptedInput() const { return m_scripted; }
+    void SetScriptedAxis(InputId id, float value);
+    void SetScriptedAction(InputId id, bool held);
+    void SetScriptedAxis(std::string_view name, float value) { SetScriptedAxis(RegisterAxis(name), value); }
+    void SetScriptedAction(std::string_view name, bool held) { SetScriptedAction(RegisterAction(name), held); }
+    void ClearScriptedValues();
 
     struct AxisBinding
     {
@@ -40,6 +86,7 @@ public:
 
         Type type = Type::Key;
         int key = 0;
+        uint32_t keySlot = 0; // índice en m_keyDown
         MouseAxis mouseAxis = MouseAxis::DeltaX;
         ScrollAxis scrollAxis = ScrollAxis::Y;
         float scale = 1.0f;
@@ -50,8 +97,11 @@ private:
 
     struct AxisEntry
     {
+        std::string name;
         std::vector<AxisBinding> bindings;
         float value = 0.0f;
+        float scriptedValue = 0.0f;
+        bool  defined = false; // en bindings.json o fijado por script
     };
 
     struct ActionBinding
@@ -59,18 +109,34 @@ private:
         enum class Type { Key, MouseButton };
         Type type = Type::Key;
         int code = 0;
+        uint32_t keySlot = 0; // índice en m_keyDown
     };
 
     struct ActionEntry
     {
+        std::string name;
         std::vector<ActionBinding> bindings;
         bool previousHeld = false;
+        bool scriptedHeld = false;
+        bool defined = false;
         ActionState state{};
     };
 
+    struct StringHash
+    {
+        using is_transparent = void;
+        size_t operator()(std::string_view text) const { return std::hash<std::string_view>{}(text); }
+    };
+    using NameLookup = std::unordered_map<std::string, uint32_t, StringHash, std::equal_to<>>;
+
     void ResetMouseSmoothing();
+    uint32_t AcquireKeySlot(int code, bool mouseButton);
+    void ResetKeySlots();
+    void DrainEvents();
+    void PollDevices();
     void UpdateActions();
     void UpdateAxes();
+    void UpdateScripted();
 
     Window* m_window = nullptr;
     GLFWwindow* m_glfwWindow = nullptr;
@@ -91,7 +157,31 @@ private:
     float m_mouseSmoothedY = 0.0f;
     bool  m_mouseInitialized = false;
 
-    std::unordered_map<std::string, AxisEntry>   m_axes;
-    std::unordered_map<std::string, ActionEntry> m_actions;
+    // Estado plano indexado por InputId::index
+    std::vector<AxisEntry>   m_axes;
+    std::vector<ActionEntry> m_actions;
+    NameLookup               m_axisLookup;
+    NameLookup               m_actionLookup;
+    uint32_t                 m_layoutVersion = 0;
+
+    // Cada tecla/botón distinto de los bindings tiene un slot: se consulta a
+    // GLFW una vez por frame (o lo actualizan los eventos) y los bindings
+    // leen m_keyDown[keySlot].
+    struct PolledKey
+    {
+        int  code = 0;
+        bool mouseButton = false;
+    };
+    std::vector<PolledKey> m_polledKeys;
+    std::vector<uint8_t>   m_keyDown;
+    std::vector<uint8_t>   m_keyPressedInFrame;
+    std::vector<uint8_t>   m_keyReleasedInFrame;
+    std::vector<int32_t>   m_keySlotByCode;    // GLFW_KEY_* -> slot, -1 sin binding
+    std::vector<int32_t>   m_buttonSlotByCode; // GLFW_MOUSE_BUTTON_* -> slot
+
+    bool                    m_eventDriven = true;
+    std::vector<InputEvent> m_frameEvents;
+
+    bool m_scripted = false;
 };
 
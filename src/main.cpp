@@ -1,4 +1,6 @@
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <exception>
 #include <cstdlib>
 #ifdef _WIN32
@@ -8,29 +10,129 @@
 // Tu App
 #include "core/Application.h"
 
-int main()
+// SandboxCity [--headless] [--frames N] [--dt S] [--width W] [--height H]
+//             [--scene fichero.json] [--input-script fichero.json] [--report fichero.json]
+//             [--record-input fichero.scir] [--replay-input fichero.scir]
+//
+// --headless ejecuta N frames con dt fijo, sin ventana y con el backend Noop,
+// y escribe un informe de tiempos de frame en --report.
+// --record-input graba ejes, acciones y dt de cada frame; --replay-input los
+// reproduce (con o sin --headless). Sin --frames, una reproducción headless
+// dura lo que la grabación.
+
+namespace
+{
+    void PrintUsage()
+    {
+        std::printf("Uso: SandboxCity [--headless] [--frames N] [--dt S] [--width W] [--height H]\n"
+                    "                 [--scene fichero.json] [--input-script fichero.json] [--report fichero.json]\n"
+                    "                 [--record-input fichero.scir] [--replay-input fichero.scir]\n");
+    }
+
+    bool ParseArgs(int argc, char** argv, ApplicationOptions& options)
+    {
+        bool hasFrames = false;
+        for (int i = 1; i < argc; ++i)
+        {
+            const char* arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (std::strcmp(arg, "--headless") == 0)
+            {
+                options.headless = true;
+            }
+            else if (std::strcmp(arg, "--frames") == 0 && hasValue)
+            {
+                options.frames = std::strtoull(argv[++i], nullptr, 10);
+                hasFrames = true;
+            }
+            else if (std::strcmp(arg, "--dt") == 0 && hasValue)
+            {
+                options.timestep = std::atof(argv[++i]);
+            }
+            else if (std::strcmp(arg, "--width") == 0 && hasValue)
+            {
+                options.width = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (std::strcmp(arg, "--height") == 0 && hasValue)
+            {
+                options.height = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+            }
+            else if (std::strcmp(arg, "--scene") == 0 && hasValue)
+            {
+                options.scenePath = argv[++i];
+            }
+            else if (std::strcmp(arg, "--input-script") == 0 && hasValue)
+            {
+                options.inputScriptPath = argv[++i];
+            }
+            else if (std::strcmp(arg, "--report") == 0 && hasValue)
+            {
+                options.reportPath = argv[++i];
+            }
+            else if (std::strcmp(arg, "--record-input") == 0 && hasValue)
+            {
+                options.recordInputPath = argv[++i];
+            }
+            else if (std::strcmp(arg, "--replay-input") == 0 && hasValue)
+            {
+                options.replayInputPath = argv[++i];
+            }
+            else
+            {
+                PrintUsage();
+                return false;
+            }
+        }
+
+        if (!options.replayInputPath.empty() && !hasFrames)
+        {
+            options.frames = UINT64_MAX;
+        }
+
+        if (options.timestep <= 0.0 || options.width == 0 || options.height == 0)
+        {
+            PrintUsage();
+            return false;
+        }
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
 {
 #ifdef _WIN32
     // Para que la consola muestre UTF-8 (acentos) correctamente.
     SetConsoleOutputCP(CP_UTF8);
 #endif
 
+    ApplicationOptions options;
+    if (!ParseArgs(argc, argv, options))
+    {
+        return EXIT_FAILURE;
+    }
+
     try {
-        Application app;
+        Application app(options);
         app.Run();
         return EXIT_SUCCESS;
     }
     catch (const std::exception& e) {
         std::fprintf(stderr, "[FATAL] Excepción: %s\n", e.what());
 #ifdef _WIN32
-        Sleep(4000); // deja 4s para leer el mensaje en la consola
+        if (!options.headless)
+        {
+            Sleep(4000); // deja 4s para leer el mensaje en la consola
+        }
 #endif
         return EXIT_FAILURE;
     }
     catch (...) {
         std::fprintf(stderr, "[FATAL] Excepción desconocida.\n");
 #ifdef _WIN32
-        Sleep(4000);
+        if (!options.headless)
+        {
+            Sleep(4000);
+        }
 #endif
         return EXIT_FAILURE;
     }
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <cmath>
+
+// Matemática de la capa ECS/físicas: float3, cuaterniones y matrices 4x4 con
+// la misma convención que bx (filas = ejes, vector fila, traslación en
+// 12..14), así que el resultado se pasa tal cual a bgfx. Con SSE2 (siempre en
+// x64) las operaciones de matriz y cuaternión usan intrínsecos; sin SSE hay
+// una versión escalar equivalente.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SANDBOXCITY_SIMD_SSE 1
+#include <emmintrin.h>
+#endif
+
+struct float3
+{
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+};
+
+// Rotación como cuaternión unitario (convención de Bullet: x, y, z, w).
+struct quat
+{
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+    float w = 1.0f;
+};
+
+namespace math
+{
+    inline float3 Add(const float3& a, const float3& b) { return float3{a.x + b.x, a.y + b.y, a.z + b.z}; }
+    inline float3 Sub(const float3& a, const float3& b) { return float3{a.x - b.x, a.y - b.y, a.z - b.z}; }
+    inline float3 Scale(const float3& v, float s) { return float3{v.x * s, v.y * s, v.z * s}; }
+    inline float Dot(const float3& a, const float3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+    inline bool Equal(const quat& a, const quat& b)
+    {
+        return a.x == b.x && a.y == b.y && a.z == b.z && a.w == b.w;
+    }
+
+    inline float Dot(const quat& a, const quat& b) { return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w; }
+
+    inline quat Normalize(const quat& q)
+    {
+        const float lengthSq = Dot(q, q);
+        if (lengthSq <= 0.0f)
+        {
+            return quat{};
+        }
+        const float inv = 1.0f / std::sqrt(lengthSq);
+#if SANDBOXCITY_SIMD_SSE
+        quat result;
+        _mm_storeu_ps(&result.x, _mm_mul_ps(_mm_loadu_ps(&q.x), _mm_set1_ps(inv)));
+        return result;
+#else
+        return quat{q.x * inv, q.y * inv, q.z * inv, q.w * inv};
+#endif
+    }
+
+    // Interpolación lineal normalizada por el camino corto; para pasos de
+    // física pequeños es indistinguible de slerp y no usa trigonometría.
+    inline quat Nlerp(const quat& a, const quat& b, float t)
+    {
+        const float sign = Dot(a, b) < 0.0f ? -1.0f : 1.0f;
+        const float ta = 1.0f - t;
+        const float tb = t * sign;
+        return Normalize(quat{a.x * ta + b.x * tb, a.y * ta + b.y * tb, a.z * ta + b.z * tb, a.w * ta + b.w * tb});
+    }
+
+    // Matriz mundo (convención bx) de traslación, rotación y escala. Sin
+    // trigonometría: es lo que se recalcula cada vez que cambia un Transform.
+    inline void MtxFromTRS(float* result, const float3& t, const quat& r, const float3& s)
+    {
+        const float x2 = r.x + r.x, y2 = r.y + r.y, z2 = r.z + r.z;
+        const float xx = r.x * x2, yy = r.y * y2, zz = r.z * z2;
+        const float xy = r.x * y2, xz = r.x * z2, yz = r.y * z2;
+        const float wx = r.w * x2, wy = r.w * y2, wz = r.w * z2;
+
+#if SANDBOXCITY_SIMD_SSE
+        _mm_storeu_ps(result + 0, _mm_mul_ps(_mm_setr_ps(1.0f - (yy + zz), xy + wz, xz - wy, 0.0f), _mm_setr_ps(s.x, s.x, s.x, 0.0f)));
+        _mm_storeu_ps(result + 4, _mm_mul_ps(_mm_setr_ps(xy - wz, 1.0f - (xx + zz), yz + wx, 0.0f), _mm_setr_ps(s.y, s.y, s.y, 0.0f)));
+        _mm_storeu_ps(result + 8, _mm_mul_ps(_mm_setr_ps(xz + wy, yz - wx, 1.0f - (xx + yy), 0.0f), _mm_setr_ps(s.z, s.z, s.z, 0.0f)));
+        _mm_storeu_ps(result + 12, _mm_setr_ps(t.x, t.y, t.z, 1.0f));
+#else
+        result[0] = s.x * (1.0f - (yy + zz)); result[1] = s.x * (xy + wz);          result[2] = s.x * (xz - wy);          result[3] = 0.0f;
+        result[4] = s.y * (xy - wz);          result[5] = s.y * (1.0f - (xx + zz)); result[6] = s.y * (yz + wx);          result[7] = 0.0f;
+        result[8] = s.z * (xz + wy);          result[9] = s.z * (yz - wx);          result[10] = s.z * (1.0f - (xx + yy)); result[11] = 0.0f;
+        result[12] = t.x;                     result[13] = t.y;                     result[14] = t.z;                     result[15] = 1.0f;
+#endif
+    }
+
+    // result = a * b, como bx::mtxMul. result puede coincidir con a o b.
+    inline void MtxMul(float* result, const float* a, const float* b)
+    {
+#if SANDBOXCITY_SIMD_SSE
+        const __m128 b0 = _mm_loadu_ps(b + 0);
+        const __m128 b1 = _mm_loadu_ps(b + 4);
+        const __m128 b2 = _mm_loadu_ps(b + 8);
+        const __m128 b3 = _mm_loadu_ps(b + 12);
+        __m128 rows[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            const float* row = a + i * 4;
+            __m128 r = _mm_mul_ps(_mm_set1_ps(row[0]), b0);
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(row[1]), b1));
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(row[2]), b2));
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(row[3]), b3));
+            rows[i] = r;
+        }
+        for (int i = 0; i < 4; ++i)
+        {
+            _mm_storeu_ps(result + i * 4, rows[i]);
+        }
+#else
+        float tmp[16];
+        for (int i = 0; i < 4; ++i)
+        {
+            for (int j = 0; j < 4; ++j)
+            {
+                tmp[i * 4 + j] = a[i * 4 + 0] * b[0 + j] + a[i * 4 + 1] * b[4 + j] + a[i * 4 + 2] * b[8 + j] + a[i * 4 + 3] * b[12 + j];
+            }
+        }
+        for (int i = 0; i < 16; ++i)
+        {
+            result[i] = tmp[i];
+        }
+#endif
+    }
+
+    // Euler en radianes con la convención de bx::mtxSRT (la de "rotationEuler"
+    // en las escenas). Sólo para autoría y depuración: lleva trigonometría.
+    inline quat QuatFromEuler(const float3& euler)
+    {
+        const float sx = std::sin(euler.x), cx = std::cos(euler.x);
+        const float sy = std::sin(euler.y), cy = std::cos(euler.y);
+        const float sz = std::sin(euler.z), cz = std::cos(euler.z);
+        const float sxsz = sx * sz;
+        const float cycz = cy * cz;
+
+        // Filas de bx::mtxSRT con escala 1; m[i*4+j] = R(j, i)
+        const float m00 = cycz - sxsz * sy, m01 = -cx * sz, m02 = cz * sy + cy * sxsz;
+        const float m10 = cz * sx * sy + cy * sz, m11 = cx * cz, m12 = sy * sz - cycz * sx;
+        const float m20 = -cx * sy, m21 = sx, m22 = cx * cy;
+
+        quat q;
+        const float trace = m00 + m11 + m22;
+        if (trace > 0.0f)
+        {
+            const float s = std::sqrt(trace + 1.0f) * 2.0f;
+            q.w = 0.25f * s;
+            q.x = (m12 - m21) / s;
+            q.y = (m20 - m02) / s;
+            q.z = (m01 - m10) / s;
+        }
+        else if (m00 > m11 && m00 > m22)
+        {
+            const float s = std::sqrt(1.0f + m00 - m11 - m22) * 2.0f;
+            q.w = (m12 - m21) / s;
+            q.x = 0.25f * s;
+            q.y = (m10 + m01) / s;
+            q.z = (m20 + m02) / s;
+        }
+        else if (m11 > m22)
+        {
+            const float s = std::sqrt(1.0f + m11 - m00 - m22) * 2.0f;
+            q.w = (m20 - m02) / s;
+            q.x = (m10 + m01) / s;
+            q.y = 0.25f * s;
+            q.z = (m21 + m12) / s;
+        }
+        else
+        {
+            const float s = std::sqrt(1.0f + m22 - m00 - m11) * 2.0f;
+            q.w = (m01 - m10) / s;
+            q.x = (m20 + m02) / s;
+            q.y = (m21 + m12) / s;
+            q.z = 0.25f * s;
+        }
+        return Normalize(q);
+    }
+
+    // Inversa de QuatFromEuler (ángulo x en [-pi/2, pi/2]).
+    inline float3 QuatToEuler(const quat& q)
+    {
+        const float x2 = q.x + q.x, y2 = q.y + q.y, z2 = q.z + q.z;
+        const float xx = q.x * x2, yy = q.y * y2, zz = q.z * z2;
+        const float xy = q.x * y2, xz = q.x * z2, yz = q.y * z2;
+        const float wx = q.w * x2, wy = q.w * y2, wz = q.w * z2;
+
+        // Mismos elementos que MtxFromTRS con escala 1
+        const float m01 = xy + wz;
+        const float m11 = 1.0f - (xx + zz);
+        const float m20 = xz + wy;
+        const float m21 = yz - wx;
+        const float m22 = 1.0f - (xx + yy);
+
+        const float sx = m21 < -1.0f ? -1.0f : (m21 > 1.0f ? 1.0f : m21);
+        return float3{std::asin(sx), std::atan2(-m20, m22), std::atan2(-m01, m11)};
+    }
+}
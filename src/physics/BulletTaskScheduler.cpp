@@ -0,0 +1,68 @@
+#include "BulletTaskScheduler.h"
+
+#include "../core/ThreadPool.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+
+BulletTaskScheduler::BulletTaskScheduler(ThreadPool& pool)
+    : btITaskScheduler("SandboxCityPool")
+    , m_pool(pool)
+{
+    m_numThreads = getMaxNumThreads();
+}
+
+int BulletTaskScheduler::getMaxNumThreads() const
+{
+    const int poolThreads = static_cast<int>(m_pool.GetWorkerCount()) + 1;
+    return std::min(poolThreads, static_cast<int>(BT_MAX_THREAD_COUNT));
+}
+
+int BulletTaskScheduler::getNumThreads() const
+{
+    return m_numThreads;
+}
+
+void BulletTaskScheduler::setNumThreads(int numThreads)
+{
+    m_numThreads = std::clamp(numThreads, 1, getMaxNumThreads());
+}
+
+void BulletTaskScheduler::parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body)
+{
+    m_pool.ParallelFor(iBegin, iEnd, grainSize, [&body](int blockBegin, int blockEnd)
+    {
+        body.forLoop(blockBegin, blockEnd);
+    }, static_cast<unsigned>(m_numThreads));
+}
+
+btScalar BulletTaskScheduler::parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body)
+{
+    std::mutex mutex;
+    btScalar sum = btScalar(0);
+    m_pool.ParallelFor(iBegin, iEnd, grainSize, [&](int blockBegin, int blockEnd)
+    {
+        const btScalar partial = body.sumLoop(blockBegin, blockEnd);
+        std::lock_guard<std::mutex> lock(mutex);
+        sum += partial;
+    }, static_cast<unsigned>(m_numThreads));
+    return sum;
+}
+
+BulletTaskScheduler& BulletTaskScheduler::Install(int threadCount)
+{
+    static BulletTaskScheduler scheduler(ThreadPool::Shared());
+
+    scheduler.setNumThreads(threadCount > 0 ? threadCount : scheduler.getMaxNumThreads());
+    // Se comprueba el global y no un flag propio: otro código (el benchmark de
+    // físicas) puede haber instalado otro scheduler entretanto.
+    if (btGetTaskScheduler() != &scheduler)
+    {
+        btSetTaskScheduler(&scheduler);
+        std::printf("[Physics] Task scheduler '%s' installed (maxThreads=%d)\n",
+                    scheduler.getName(),
+                    scheduler.getMaxNumThreads());
+    }
+    return scheduler;
+}
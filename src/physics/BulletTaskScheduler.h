@@ -0,0 +1,29 @@
+#pragma once
+
+#include <LinearMath/btThreads.h>
+
+class ThreadPool;
+
+// btITaskScheduler que reparte el trabajo de Bullet sobre el ThreadPool del
+// motor en lugar de crear los hilos propios de btCreateDefaultTaskScheduler.
+// Requiere Bullet compilado con BT_THREADSAFE.
+class BulletTaskScheduler : public btITaskScheduler
+{
+public:
+    explicit BulletTaskScheduler(ThreadPool& pool);
+
+    int  getMaxNumThreads() const override;
+    int  getNumThreads() const override;
+    void setNumThreads(int numThreads) override;
+
+    void     parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) override;
+    btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) override;
+
+    // Instala el scheduler global de Bullet si no es ya el activo y ajusta sus hilos.
+    // threadCount <= 0 usa todos los hilos del pool compartido.
+    static BulletTaskScheduler& Install(int threadCount);
+
+private:
+    ThreadPool& m_pool;
+    int         m_numThreads = 1;
+};
@@ -15,6 +15,11 @@ namespace Physics
         g_activeSystem = system;
     }
 
+    PhysicsSystem* GetActiveSystem()
+    {
+        return g_activeSystem;
+    }
+
     bool Raycast(const float3& origin,
                  const float3& direction,
                  float maxDistance,
@@ -33,5 +33,6 @@ namespace Physics
     EventBus* GetEventBus();
 
     void SetActiveSystem(PhysicsSystem* system);
+    PhysicsSystem* GetActiveSystem();
 }
 
@@ -0,0 +1,265 @@
+#include "PhysicsBenchmark.h"
+
+#include "PhysicsAPI.h"
+#include "PhysicsSystem.h"
+#include "BulletTaskScheduler.h"
+
+#include "../camera/Camera.h"
+#include "../ecs/Scene.h"
+#include "../input/InputSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+    constexpr float kTriggerSpacing = 8.0f;
+    constexpr float kTriggerHalfExtent = 2.0f;
+    constexpr float kBodyHalfExtent = 0.25f;
+    constexpr float kBodyAmplitude = 4.0f;
+    constexpr double kStepDt = 1.0 / 120.0;
+
+    int GridSide(int count)
+    {
+        return std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(count)))));
+    }
+
+    std::vector<PhysicsBenchmark::StressSample> g_lastStressResults;
+
+    PhysicsBenchmark::StressSample RunStressPass(int bodyCount, int steps, bool multithreaded, int threads)
+    {
+        constexpr int   kColumnHeight = 10;
+        constexpr float kBoxHalfExtent = 0.5f;
+        constexpr float kColumnSpacing = 1.5f;
+
+        PhysicsBenchmark::StressSample sample;
+        sample.bodies = bodyCount;
+        sample.multithreaded = multithreaded;
+        sample.threads = multithreaded ? threads : 1;
+        sample.steps = steps;
+
+        Scene scene;
+        Camera camera;
+        InputSystem input;
+
+        const int columns = std::max(1, (bodyCount + kColumnHeight - 1) / kColumnHeight);
+        const int side = GridSide(columns);
+        for (int i = 0; i < bodyCount; ++i)
+        {
+            const int column = i / kColumnHeight;
+            const int level = i % kColumnHeight;
+
+            const EntityId id = scene.CreateEntity();
+            Transform* transform = scene.AddTransform(id);
+            transform->position = float3{
+                static_cast<float>(column % side) * kColumnSpacing,
+                kBoxHalfExtent + static_cast<float>(level) * (kBoxHalfExtent * 2.0f + 0.05f),
+                static_cast<float>(column / side) * kColumnSpacing};
+
+            Collider* collider = scene.AddCollider(id);
+            collider->size = float3{kBoxHalfExtent, kBoxHalfExtent, kBoxHalfExtent};
+
+            RigidBody* body = scene.AddRigidBody(id);
+            body->type = RigidBodyType::Dynamic;
+            body->mass = 1.0f;
+        }
+
+        PhysicsSystem physics;
+        physics.SetThreading(multithreaded, threads);
+        physics.Initialize();
+        physics.Update(scene, camera, input, kStepDt);
+        physics.FlushEvents();
+
+        double total = 0.0;
+        for (int step = 0; step < steps; ++step)
+        {
+            physics.Update(scene, camera, input, kStepDt);
+            physics.FlushEvents();
+
+            const double stepMs = physics.GetLastStepDurationMs();
+            total += stepMs;
+            sample.maxStepMs = std::max(sample.maxStepMs, stepMs);
+        }
+        sample.avgStepMs = total / static_cast<double>(std::max(1, steps));
+        return sample;
+    }
+}
+
+namespace PhysicsBenchmark
+{
+    TriggerBenchmarkResult RunTriggerBenchmark(int triggerCount, int bodyCount, int steps)
+    {
+        TriggerBenchmarkResult result;
+        result.triggers = std::max(0, triggerCount);
+        result.bodies = std::max(0, bodyCount);
+        result.steps = std::max(1, steps);
+
+        // El PhysicsSystem del benchmark se registra como sistema activo al
+        // inicializarse; se restaura el anterior al terminar.
+        PhysicsSystem* previousActive = Physics::GetActiveSystem();
+
+        Scene scene;
+        Camera camera;
+        InputSystem input;
+
+        const int triggerSide = GridSide(result.triggers);
+        const float worldSize = static_cast<float>(triggerSide) * kTriggerSpacing;
+
+        for (int i = 0; i < result.triggers; ++i)
+        {
+            const EntityId id = scene.CreateEntity();
+            Transform* transform = scene.AddTransform(id);
+            transform->position = float3{
+                (static_cast<float>(i % triggerSide) + 0.5f) * kTriggerSpacing,
+                kTriggerHalfExtent,
+                (static_cast<float>(i / triggerSide) + 0.5f) * kTriggerSpacing};
+
+            TriggerVolume* trigger = scene.AddTriggerVolume(id);
+            trigger->size = float3{kTriggerHalfExtent, kTriggerHalfExtent, kTriggerHalfExtent};
+        }
+
+        const int bodySide = GridSide(result.bodies);
+        const float bodySpacing = worldSize / static_cast<float>(bodySide);
+
+        std::vector<EntityId> bodies;
+        std::vector<float> baseX;
+        bodies.reserve(result.bodies);
+        baseX.reserve(result.bodies);
+        for (int i = 0; i < result.bodies; ++i)
+        {
+            const EntityId id = scene.CreateEntity();
+            Transform* transform = scene.AddTransform(id);
+            const float x = (static_cast<float>(i % bodySide) + 0.5f) * bodySpacing;
+            transform->position = float3{
+                x,
+                kTriggerHalfExtent,
+                (static_cast<float>(i / bodySide) + 0.5f) * bodySpacing};
+
+            Collider* collider = scene.AddCollider(id);
+            collider->size = float3{kBodyHalfExtent, kBodyHalfExtent, kBodyHalfExtent};
+
+            RigidBody* body = scene.AddRigidBody(id);
+            body->type = RigidBodyType::Kinematic;
+
+            bodies.push_back(id);
+            baseX.push_back(x);
+        }
+
+        {
+            PhysicsSystem physics;
+            physics.Initialize();
+            physics.GetEventBus().Subscribe<PhysicsSystem::TriggerEventBatch>([&result](const PhysicsSystem::TriggerEventBatch& batch)
+            {
+                for (size_t i = 0; i < batch.count; ++i)
+                {
+                    switch (batch.events[i].type)
+                    {
+                    case PhysicsSystem::TriggerEvent::Type::Enter: ++result.enterEvents; break;
+                    case PhysicsSystem::TriggerEvent::Type::Stay:  ++result.stayEvents;  break;
+                    case PhysicsSystem::TriggerEvent::Type::Exit:  ++result.exitEvents;  break;
+                    }
+                }
+            });
+
+            // Primer Update fuera de la medición: crea los cuerpos y ghosts.
+            physics.Update(scene, camera, input, kStepDt);
+            physics.FlushEvents();
+
+            double triggerTotal = 0.0;
+            auto start = std::chrono::high_resolution_clock::now();
+            for (int step = 0; step < result.steps; ++step)
+            {
+                const float t = static_cast<float>(step) * static_cast<float>(kStepDt);
+                for (size_t i = 0; i < bodies.size(); ++i)
+                {
+                    Transform* transform = scene.GetTransform(bodies[i]);
+                    transform->position.x = baseX[i] + kBodyAmplitude * std::sin(t * 2.0f + static_cast<float>(i) * 0.37f);
+                    transform->MarkDirty();
+                }
+
+                physics.Update(scene, camera, input, kStepDt);
+                physics.FlushEvents();
+
+                const double triggerMs = physics.GetLastTriggerDurationMs();
+                triggerTotal += triggerMs;
+                result.maxTriggerMs = std::max(result.maxTriggerMs, triggerMs);
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+
+            result.totalMs = std::chrono::duration<double, std::milli>(end - start).count();
+            result.avgStepMs = result.totalMs / static_cast<double>(result.steps);
+            result.avgTriggerMs = triggerTotal / static_cast<double>(result.steps);
+        }
+
+        Physics::SetActiveSystem(previousActive);
+        return result;
+    }
+
+    void PrintResult(const TriggerBenchmarkResult& result)
+    {
+        std::printf("[PhysicsBench] triggers=%d bodies=%d steps=%d total=%.2fms avgUpdate=%.4fms avgTrigger=%.4fms maxTrigger=%.4fms enter=%zu stay=%zu exit=%zu\n",
+                    result.triggers,
+                    result.bodies,
+                    result.steps,
+                    result.totalMs,
+                    result.avgStepMs,
+                    result.avgTriggerMs,
+                    result.maxTriggerMs,
+                    result.enterEvents,
+                    result.stayEvents,
+                    result.exitEvents);
+    }
+
+    const std::vector<StressSample>& RunDynamicStressBenchmark(int bodyCount, int steps)
+    {
+        bodyCount = std::max(1, bodyCount);
+        steps = std::max(1, steps);
+
+        PhysicsSystem* previousActive = Physics::GetActiveSystem();
+        btITaskScheduler* previousScheduler = btGetTaskScheduler();
+        const int previousThreads = previousScheduler ? previousScheduler->getNumThreads() : 0;
+
+        g_lastStressResults.clear();
+        g_lastStressResults.push_back(RunStressPass(bodyCount, steps, false, 1));
+
+        const int maxThreads = BulletTaskScheduler::Install(0).getMaxNumThreads();
+        for (int threads = 1; ; threads *= 2)
+        {
+            const int count = std::min(threads, maxThreads);
+            g_lastStressResults.push_back(RunStressPass(bodyCount, steps, true, count));
+            if (count >= maxThreads)
+            {
+                break;
+            }
+        }
+
+        // El scheduler de Bullet es global: se deja como estaba para el mundo de
+        // la escena, también si no había ninguno.
+        btSetTaskScheduler(previousScheduler);
+        if (previousScheduler)
+        {
+            previousScheduler->setNumThreads(previousThreads);
+        }
+        Physics::SetActiveSystem(previousActive);
+
+        for (const StressSample& sample : g_lastStressResults)
+        {
+            std::printf("[PhysicsBench] stress bodies=%d world=%s threads=%d steps=%d avgStep=%.4fms maxStep=%.4fms\n",
+                        sample.bodies,
+                        sample.multithreaded ? "mt" : "st",
+                        sample.threads,
+                        sample.steps,
+                        sample.avgStepMs,
+                        sample.maxStepMs);
+        }
+        return g_lastStressResults;
+    }
+
+    const std::vector<StressSample>& GetLastStressResults()
+    {
+        return g_lastStressResults;
+    }
+}
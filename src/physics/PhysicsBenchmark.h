@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Benchmarks sintéticos del sistema de físicas. Construyen su propia Scene y
+// su propio PhysicsSystem, así que pueden lanzarse en caliente sin tocar la
+// escena cargada.
+namespace PhysicsBenchmark
+{
+    struct TriggerBenchmarkResult
+    {
+        int    triggers = 0;
+        int    bodies = 0;
+        int    steps = 0;
+        double totalMs = 0.0;
+        double avgStepMs = 0.0;
+        double avgTriggerMs = 0.0;
+        double maxTriggerMs = 0.0;
+        size_t enterEvents = 0;
+        size_t stayEvents = 0;
+        size_t exitEvents = 0;
+    };
+
+    // Rejilla de 'triggerCount' triggers atravesada por 'bodyCount' cuerpos
+    // cinemáticos que oscilan, de modo que cada paso genera Enter/Stay/Exit.
+    TriggerBenchmarkResult RunTriggerBenchmark(int triggerCount = 1000, int bodyCount = 10000, int steps = 240);
+
+    void PrintResult(const TriggerBenchmarkResult& result);
+
+    struct StressSample
+    {
+        int    bodies = 0;
+        bool   multithreaded = false;
+        int    threads = 1;
+        int    steps = 0;
+        double avgStepMs = 0.0;
+        double maxStepMs = 0.0;
+    };
+
+    // 'bodyCount' cuerpos dinámicos cayendo en columnas sobre el suelo. Se mide
+    // primero el mundo secuencial y después el multihilo con 1, 2, 4... hilos
+    // hasta el máximo del pool. Los resultados quedan para PhysicsSystem::LogStats.
+    const std::vector<StressSample>& RunDynamicStressBenchmark(int bodyCount = 5000, int steps = 300);
+    const std::vector<StressSample>& GetLastStressResults();
+}
@@ -10,4 +10,51 @@ struct PhysicsDebugLine
     uint32_t abgr = 0xff000000u;
 };
 
-using PhysicsDebugLineBuffer = std::vector<PhysicsDebugLine>;
\ No newline at end of file
+using PhysicsDebugLineBuffer = std::vector<PhysicsDebugLine>;
+
+// Frustum de la cámara para descartar formas antes de teselarlas.
+// Planos extraídos de una matriz view*proj de bx (vector fila, v' = v * M).
+struct PhysicsDebugFrustum
+{
+    float planes[6][4]{};
+    bool  enabled = false;
+
+    void SetFromViewProj(const float m[16])
+    {
+        const float col0[4] = {m[0], m[4], m[8],  m[12]};
+        const float col1[4] = {m[1], m[5], m[9],  m[13]};
+        const float col2[4] = {m[2], m[6], m[10], m[14]};
+        const float col3[4] = {m[3], m[7], m[11], m[15]};
+
+        for (int i = 0; i < 4; ++i)
+        {
+            planes[0][i] = col3[i] + col0[i]; // izquierda
+            planes[1][i] = col3[i] - col0[i]; // derecha
+            planes[2][i] = col3[i] + col1[i]; // abajo
+            planes[3][i] = col3[i] - col1[i]; // arriba
+            planes[4][i] = col3[i] + col2[i]; // cerca (conservador también con z en [0,1])
+            planes[5][i] = col3[i] - col2[i]; // lejos
+        }
+        enabled = true;
+    }
+
+    bool IntersectsAabb(const float aabbMin[3], const float aabbMax[3]) const
+    {
+        if (!enabled)
+        {
+            return true;
+        }
+        for (const float* plane : planes)
+        {
+            // Vértice del AABB más adelantado según la normal del plano.
+            const float x = plane[0] >= 0.0f ? aabbMax[0] : aabbMin[0];
+            const float y = plane[1] >= 0.0f ? aabbMax[1] : aabbMin[1];
+            const float z = plane[2] >= 0.0f ? aabbMax[2] : aabbMin[2];
+            if (plane[0] * x + plane[1] * y + plane[2] * z + plane[3] < 0.0f)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
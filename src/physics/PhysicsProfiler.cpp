@@ -0,0 +1,186 @@
+#include "PhysicsProfiler.h"
+
+#include <LinearMath/btQuickprof.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#ifndef BT_NO_PROFILE
+namespace
+{
+    struct BulletZone
+    {
+        const char*  name;
+        PhysicsPhase phase;
+    };
+
+    // Zonas BT_PROFILE de btDiscreteDynamicsWorld / btCollisionWorld.
+    constexpr BulletZone kBulletZones[] = {
+        {"calculateOverlappingPairs", PhysicsPhase::Broadphase},
+        {"dispatchAllCollisionPairs", PhysicsPhase::Narrowphase},
+        {"solveConstraints",          PhysicsPhase::Solver},
+        {"predictUnconstraintMotion", PhysicsPhase::Integrate},
+        {"integrateTransforms",       PhysicsPhase::Integrate},
+        {"updateActions",             PhysicsPhase::Actions},
+    };
+
+    const BulletZone* FindZone(const char* name)
+    {
+        if (!name)
+        {
+            return nullptr;
+        }
+        for (const BulletZone& zone : kBulletZones)
+        {
+            if (std::strcmp(zone.name, name) == 0)
+            {
+                return &zone;
+            }
+        }
+        return nullptr;
+    }
+
+    // Las zonas reconocidas no se recorren por dentro para no contar dos veces.
+    void CollectRecursive(CProfileIterator* it, std::array<double, PhysicsProfiler::kPhaseCount>& out)
+    {
+        std::vector<const BulletZone*> zones;
+        std::vector<double> times;
+        for (it->First(); !it->Is_Done(); it->Next())
+        {
+            zones.push_back(FindZone(it->Get_Current_Name()));
+            times.push_back(static_cast<double>(it->Get_Current_Total_Time()));
+        }
+
+        for (size_t i = 0; i < zones.size(); ++i)
+        {
+            if (zones[i])
+            {
+                out[static_cast<size_t>(zones[i]->phase)] += times[i];
+                continue;
+            }
+
+            it->Enter_Child(static_cast<int>(i));
+            CollectRecursive(it, out);
+            it->Enter_Parent();
+        }
+    }
+}
+#endif
+
+const char* PhysicsProfiler::GetPhaseName(PhysicsPhase phase)
+{
+    switch (phase)
+    {
+    case PhysicsPhase::Broadphase:          return "broadphase";
+    case PhysicsPhase::Narrowphase:         return "narrowphase";
+    case PhysicsPhase::Solver:              return "solver";
+    case PhysicsPhase::Integrate:           return "integrate";
+    case PhysicsPhase::Actions:             return "actions";
+    case PhysicsPhase::CharacterController: return "character";
+    case PhysicsPhase::SyncKinematic:       return "syncKinematic";
+    case PhysicsPhase::SyncRigidBodies:     return "syncBodies";
+    case PhysicsPhase::SyncCharacters:      return "syncCharacters";
+    case PhysicsPhase::TriggerEvents:       return "triggers";
+    case PhysicsPhase::ContactEvents:       return "contacts";
+    case PhysicsPhase::DebugLines:          return "debugLines";
+    case PhysicsPhase::Step:                return "stepSimulation";
+    case PhysicsPhase::Update:              return "update";
+    default:                                return "?";
+    }
+}
+
+void PhysicsProfiler::BeginStep()
+{
+#ifndef BT_NO_PROFILE
+    CProfileManager::Reset();
+#endif
+}
+
+void PhysicsProfiler::Add(PhysicsPhase phase, double ms)
+{
+    m_current[static_cast<size_t>(phase)] += ms;
+}
+
+void PhysicsProfiler::CollectBulletTimings()
+{
+#ifndef BT_NO_PROFILE
+    CProfileIterator* it = CProfileManager::Get_Iterator();
+    if (!it)
+    {
+        return;
+    }
+    CollectRecursive(it, m_current);
+    CProfileManager::Release_Iterator(it);
+#endif
+}
+
+void PhysicsProfiler::EndStep()
+{
+    for (size_t phase = 0; phase < kPhaseCount; ++phase)
+    {
+        m_history[phase][m_head] = static_cast<float>(m_current[phase]);
+    }
+    m_head = (m_head + 1) % kWindow;
+    m_count = std::min(m_count + 1, kWindow);
+    m_current.fill(0.0);
+}
+
+PhysicsPhaseStats PhysicsProfiler::GetStats(PhysicsPhase phase) const
+{
+    PhysicsPhaseStats stats;
+    if (m_count == 0 || phase == PhysicsPhase::Count)
+    {
+        return stats;
+    }
+
+    const auto& samples = m_history[static_cast<size_t>(phase)];
+    m_scratch.assign(samples.begin(), samples.begin() + m_count);
+
+    double sum = 0.0;
+    float minValue = m_scratch.front();
+    float maxValue = m_scratch.front();
+    for (float value : m_scratch)
+    {
+        sum += value;
+        minValue = std::min(minValue, value);
+        maxValue = std::max(maxValue, value);
+    }
+
+    const size_t p95Index = std::min(m_count - 1, static_cast<size_t>(std::ceil(0.95 * static_cast<double>(m_count))) - 1);
+    std::nth_element(m_scratch.begin(), m_scratch.begin() + p95Index, m_scratch.end());
+
+    stats.minMs = minValue;
+    stats.avgMs = sum / static_cast<double>(m_count);
+    stats.p95Ms = m_scratch[p95Index];
+    stats.maxMs = maxValue;
+    stats.samples = m_count;
+    return stats;
+}
+
+void PhysicsProfiler::AppendHudLines(std::vector<std::string>& out) const
+{
+    out.emplace_back("Physics phase      avg     p95     max (ms)");
+    for (size_t i = 0; i < kPhaseCount; ++i)
+    {
+        const PhysicsPhase phase = static_cast<PhysicsPhase>(i);
+        const PhysicsPhaseStats stats = GetStats(phase);
+        char buffer[96];
+        std::snprintf(buffer, sizeof(buffer), "  %-15s %7.3f %7.3f %7.3f",
+                      GetPhaseName(phase), stats.avgMs, stats.p95Ms, stats.maxMs);
+        out.emplace_back(buffer);
+    }
+}
+
+void PhysicsProfiler::Log() const
+{
+    std::printf("[PhysicsProfile] samples=%zu\n", m_count);
+    for (size_t i = 0; i < kPhaseCount; ++i)
+    {
+        const PhysicsPhase phase = static_cast<PhysicsPhase>(i);
+        const PhysicsPhaseStats stats = GetStats(phase);
+        std::printf("[PhysicsProfile]   %-15s min=%.4fms avg=%.4fms p95=%.4fms max=%.4fms\n",
+                    GetPhaseName(phase), stats.minMs, stats.avgMs, stats.p95Ms, stats.maxMs);
+    }
+}
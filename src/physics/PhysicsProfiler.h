@@ -0,0 +1,100 @@
+#pragma once
+
+#include "../core/Profiler.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Fases de un PhysicsSystem::Update. Las cinco primeras salen del árbol de
+// CProfileManager de Bullet (quedan a cero si Bullet se compila con
+// BT_NO_PROFILE); el resto son timers propios.
+enum class PhysicsPhase : uint8_t
+{
+    Broadphase,
+    Narrowphase,
+    Solver,
+    Integrate,
+    Actions,             // updateActions de Bullet (controladores de personaje)
+    CharacterController, // HandleCharacterInput, antes del paso
+
+    SyncKinematic,
+    SyncRigidBodies,
+    SyncCharacters,
+    TriggerEvents,
+    ContactEvents,
+    DebugLines,
+    Step,
+    Update,
+    Count,
+};
+
+struct PhysicsPhaseStats
+{
+    double minMs = 0.0;
+    double avgMs = 0.0;
+    double p95Ms = 0.0;
+    double maxMs = 0.0;
+    size_t samples = 0;
+};
+
+// Histograma deslizante de las últimas kWindow llamadas a Update.
+class PhysicsProfiler
+{
+public:
+    static constexpr size_t kWindow = 240;
+    static constexpr size_t kPhaseCount = static_cast<size_t>(PhysicsPhase::Count);
+
+    static const char* GetPhaseName(PhysicsPhase phase);
+
+    void BeginStep();
+    // Fuera de BeginStep/EndStep se acumula para el paso siguiente.
+    void Add(PhysicsPhase phase, double ms);
+    // Suma al paso actual los tiempos de Bullet registrados desde BeginStep.
+    void CollectBulletTimings();
+    void EndStep();
+
+    PhysicsPhaseStats GetStats(PhysicsPhase phase) const;
+    size_t GetSampleCount() const { return m_count; }
+
+    void AppendHudLines(std::vector<std::string>& out) const;
+    void Log() const;
+
+private:
+    std::array<double, kPhaseCount>                     m_current{};
+    std::array<std::array<float, kWindow>, kPhaseCount> m_history{};
+    size_t m_head = 0;
+    size_t m_count = 0;
+
+    mutable std::vector<float> m_scratch;
+};
+
+class PhysicsProfileScope
+{
+public:
+    PhysicsProfileScope(PhysicsProfiler& profiler, PhysicsPhase phase)
+        : m_marker(PhysicsProfiler::GetPhaseName(phase))
+        , m_profiler(profiler)
+        , m_phase(phase)
+        , m_start(std::chrono::high_resolution_clock::now())
+    {
+    }
+
+    ~PhysicsProfileScope()
+    {
+        const auto end = std::chrono::high_resolution_clock::now();
+        m_profiler.Add(m_phase, std::chrono::duration<double, std::milli>(end - m_start).count());
+    }
+
+    PhysicsProfileScope(const PhysicsProfileScope&) = delete;
+    PhysicsProfileScope& operator=(const PhysicsProfileScope&) = delete;
+
+private:
+    Profiler::Scope  m_marker; // también aparece en las capturas del frame profiler
+    PhysicsProfiler& m_profiler;
+    PhysicsPhase     m_phase;
+    std::chrono::high_resolution_clock::time_point m_start;
+};
@@ -4,12 +4,17 @@
 #include "BulletDebugDrawer.h"
 #include "PhysicsDebugDraw.h"
 #include "PhysicsAPI.h"
+#include "PhysicsBenchmark.h"
+#include "BulletTaskScheduler.h"
 #include "../ecs/Scene.h"
 #include "../ecs/Transform.h"
 #include "../input/InputSystem.h"
 #include "../camera/Camera.h"
 
 #include <BulletCollision/CollisionDispatch/btGhostObject.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
 #include <BulletDynamics/Character/btKinematicCharacterController.h>
 #include <btBulletDynamicsCommon.h>
 #include <LinearMath/btDefaultMotionState.h>
@@ -17,6 +22,7 @@
 #include <nlohmann/json.hpp>
 #include <bx/math.h>
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <cmath>
@@ -24,8 +30,8 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <iterator>
 #include <vector>
-#include <unordered_set>
 
 using json = nlohmann::json;
 
@@ -37,11 +43,14 @@ namespace
     constexpr uint32_t kDefaultCharacterLayer = 1u << 1;
     constexpr uint32_t kDefaultTriggerLayer = 1u << 2;
 
-    btQuaternion ToBtQuaternion(const float3& euler)
+    btQuaternion ToBtQuaternion(const quat& q)
     {
-        btQuaternion q;
-        q.setEulerZYX(euler.y, euler.x, euler.z);
-        return q;
+        return btQuaternion(q.x, q.y, q.z, q.w);
+    }
+
+    quat ToQuat(const btQuaternion& q)
+    {
+        return quat{static_cast<float>(q.x()), static_cast<float>(q.y()), static_cast<float>(q.z()), static_cast<float>(q.w())};
     }
 
     btVector3 ToBtVector(const float3& v)
@@ -59,7 +68,7 @@ namespace
         btTransform bt;
         bt.setIdentity();
         bt.setOrigin(btVector3(transform.position.x, transform.position.y, transform.position.z));
-        bt.setRotation(ToBtQuaternion(transform.rotationEuler));
+        bt.setRotation(ToBtQuaternion(transform.rotation));
         return bt;
     }
 }
@@ -70,33 +79,12 @@ PhysicsSystem::PhysicsSystem()
 
 PhysicsSystem::~PhysicsSystem()
 {
-    if (m_world)
-    {
-        ClearTriggers();
-        ClearRigidBodies();
+    ShutdownWorld();
 
-        for (auto& [entity, runtime] : m_characterRuntime)
-        {
-            if (runtime.controller)
-            {
-                m_world->removeAction(runtime.controller.get());
-            }
-            if (runtime.ghost)
-            {
-                UnregisterCollisionObject(runtime.ghost.get());
-                m_world->removeCollisionObject(runtime.ghost.get());
-            }
-        }
-        m_characterRuntime.clear();
-
-        if (m_groundBody)
-        {
-            m_world->removeRigidBody(m_groundBody.get());
-        }
+    if (Physics::GetActiveSystem() == this)
+    {
+        Physics::SetActiveSystem(nullptr);
     }
-
-    ClearObjectLookup();
-    Physics::SetActiveSystem(nullptr);
 }
 
 void PhysicsSystem::SetConfigPath(std::filesystem::path path)
@@ -107,9 +95,27 @@ void PhysicsSystem::SetConfigPath(std::filesystem::path path)
 
 void PhysicsSystem::Initialize()
 {
+    // La config se lee antes de crear el mundo: el modo multihilo decide qué mundo se construye.
+    if (!m_configPath.empty() && !m_hasLastWriteTime)
+    {
+        std::error_code ec;
+        auto currentTime = std::filesystem::last_write_time(m_configPath, ec);
+        if (!ec)
+        {
+            m_lastWriteTime = currentTime;
+            m_hasLastWriteTime = true;
+            m_config = LoadConfigFromDisk();
+        }
+    }
     EnsureWorld();
 }
 
+void PhysicsSystem::SetThreading(bool multithreaded, int threadCount)
+{
+    m_config.multithreaded = multithreaded;
+    m_config.threads = threadCount;
+}
+
 void PhysicsSystem::EnsureWorld()
 {
     if (m_world)
@@ -123,9 +129,25 @@ void PhysicsSystem::InitializeWorld()
 {
     m_broadphase = std::make_unique<btDbvtBroadphase>();
     m_collisionConfig = std::make_unique<btDefaultCollisionConfiguration>();
-    m_dispatcher = std::make_unique<btCollisionDispatcher>(m_collisionConfig.get());
-    m_solver = std::make_unique<btSequentialImpulseConstraintSolver>();
-    m_world = std::make_unique<btDiscreteDynamicsWorld>(m_dispatcher.get(), m_broadphase.get(), m_solver.get(), m_collisionConfig.get());
+
+    if (m_config.multithreaded)
+    {
+        // El scheduler debe estar instalado antes de crear el pool de solvers.
+        BulletTaskScheduler& scheduler = BulletTaskScheduler::Install(m_config.threads);
+        m_dispatcher = std::make_unique<btCollisionDispatcherMt>(m_collisionConfig.get());
+        m_solverPool = std::make_unique<btConstraintSolverPoolMt>(scheduler.getMaxNumThreads());
+        m_solver = std::make_unique<btSequentialImpulseConstraintSolverMt>();
+        m_world = std::make_unique<btDiscreteDynamicsWorldMt>(m_dispatcher.get(), m_broadphase.get(), m_solverPool.get(), m_solver.get(), m_collisionConfig.get());
+        m_worldMultithreaded = true;
+        std::printf("[Physics] Multithreaded world (threads=%d)\n", scheduler.getNumThreads());
+    }
+    else
+    {
+        m_dispatcher = std::make_unique<btCollisionDispatcher>(m_collisionConfig.get());
+        m_solver = std::make_unique<btSequentialImpulseConstraintSolver>();
+        m_world = std::make_unique<btDiscreteDynamicsWorld>(m_dispatcher.get(), m_broadphase.get(), m_solver.get(), m_collisionConfig.get());
+        m_worldMultithreaded = false;
+    }
 
     m_world->setGravity(btVector3(0.0f, m_config.gravity, 0.0f));
 
@@ -146,6 +168,49 @@ void PhysicsSystem::InitializeWorld()
     Physics::SetActiveSystem(this);
 }
 
+void PhysicsSystem::ShutdownWorld()
+{
+    if (!m_world)
+    {
+        return;
+    }
+
+    ClearTriggers();
+    ClearRigidBodies();
+
+    for (auto& [entity, runtime] : m_characterRuntime)
+    {
+        if (runtime.controller)
+        {
+            m_world->removeAction(runtime.controller.get());
+        }
+        if (runtime.ghost)
+        {
+            UnregisterCollisionObject(runtime.ghost.get());
+            m_world->removeCollisionObject(runtime.ghost.get());
+        }
+    }
+    m_characterRuntime.clear();
+
+    if (m_groundBody)
+    {
+        m_world->removeRigidBody(m_groundBody.get());
+    }
+    m_groundBody.reset();
+    m_groundMotionState.reset();
+    m_groundShape.reset();
+
+    m_contactPairs.clear();
+
+    m_world.reset();
+    m_solver.reset();
+    m_solverPool.reset();
+    m_dispatcher.reset();
+    m_ghostPairCallback.reset();
+    m_collisionConfig.reset();
+    m_broadphase.reset();
+}
+
 void PhysicsSystem::EnsureGround()
 {
     if (m_groundBody)
@@ -172,7 +237,17 @@ void PhysicsSystem::OnSceneReloaded(Scene& scene)
     ClearCharacters(scene);
     ClearRigidBodies();
     ClearTriggers();
-    ClearObjectLookup();
+
+    if (m_world && m_worldMultithreaded != m_config.multithreaded)
+    {
+        ShutdownWorld();
+        InitializeWorld();
+    }
+
+    // Los eventos pendientes hablan de entidades de la escena anterior.
+    m_contactPairs.clear();
+    m_pendingTriggerEvents.clear();
+    m_pendingCollisionEvents.clear();
 
     std::vector<EntityId> toErase;
     for (auto& [entity, character] : scene.GetPhysicsCharacters())
@@ -195,22 +270,37 @@ void PhysicsSystem::OnSceneReloaded(Scene& scene)
         scene.RemovePhysicsCharacter(id);
     }
 
+    EnsurePlayerCharacter(scene);
+    m_forceCharacterRebuild = true;
+    m_fullSyncPending = true;
+}
+
+void PhysicsSystem::OnSceneEdited(Scene& scene)
+{
+    // Los cuerpos y triggers que cambian llegan con dirty y los que
+    // desaparecen se detectan en Update; aquí sólo falta el personaje si
+    // 'cj' es una entidad nueva.
+    EnsurePlayerCharacter(scene);
+}
+
+void PhysicsSystem::EnsurePlayerCharacter(Scene& scene)
+{
     const EntityId cj = scene.FindEntityByLogicalId("cj");
-    if (cj != kInvalidEntity)
+    if (cj == kInvalidEntity || scene.GetPhysicsCharacter(cj))
     {
-        PhysicsCharacter* character = scene.AddPhysicsCharacter(cj);
-        if (character)
-        {
-            character->entity = cj;
-            character->walkSpeed = m_config.walkSpeed;
-            character->jumpImpulse = m_config.jumpImpulse;
-            character->dirty = true;
-            character->ghost = nullptr;
-            character->controller = nullptr;
-        }
+        return;
     }
 
-    m_forceCharacterRebuild = true;
+    PhysicsCharacter* character = scene.AddPhysicsCharacter(cj);
+    if (character)
+    {
+        character->entity = cj;
+        character->walkSpeed = m_config.walkSpeed;
+        character->jumpImpulse = m_config.jumpImpulse;
+        character->dirty = true;
+        character->ghost = nullptr;
+        character->controller = nullptr;
+    }
 }
 
 bool PhysicsSystem::ReloadConfigIfNeeded(Scene& scene)
@@ -267,6 +357,10 @@ PhysicsSystem::Config PhysicsSystem::LoadConfigFromDisk() const
     cfg.maxSlopeDeg = data.value("maxSlopeDeg", cfg.maxSlopeDeg);
     cfg.walkSpeed = data.value("walkSpeed", cfg.walkSpeed);
     cfg.jumpImpulse = data.value("jumpImpulse", cfg.jumpImpulse);
+    cfg.collisionEvents = data.value("collisionEvents", cfg.collisionEvents);
+    cfg.coalesceStayEvents = data.value("coalesceStayEvents", cfg.coalesceStayEvents);
+    cfg.multithreaded = data.value("multithreaded", cfg.multithreaded);
+    cfg.threads = data.value("threads", cfg.threads);
 
     if (auto capsuleIt = data.find("capsule"); capsuleIt != data.end() && capsuleIt->is_object())
     {
@@ -291,8 +385,20 @@ void PhysicsSystem::ApplyConfig(Scene& scene, const Config& newConfig)
         || std::fabs(newConfig.stepHeight - m_config.stepHeight) > 1e-4f
         || std::fabs(newConfig.maxSlopeDeg - m_config.maxSlopeDeg) > 1e-4f;
 
+    const bool threadsChanged = newConfig.threads != m_config.threads;
+
     m_config = newConfig;
 
+    if (m_worldMultithreaded != m_config.multithreaded)
+    {
+        std::printf("[Physics] multithreaded=%s se aplicará al recargar la escena (F5)\n",
+                    m_config.multithreaded ? "true" : "false");
+    }
+    else if (m_worldMultithreaded && threadsChanged)
+    {
+        BulletTaskScheduler::Install(m_config.threads);
+    }
+
     if (m_world)
     {
         m_world->setGravity(btVector3(0.0f, m_config.gravity, 0.0f));
@@ -610,6 +716,7 @@ void PhysicsSystem::RemoveTrigger(Scene& scene, EntityId entity)
 
 void PhysicsSystem::ClearRigidBodies()
 {
+    m_fullSyncPending = true;
     if (!m_world)
     {
         m_rigidBodyRuntime.clear();
@@ -629,6 +736,7 @@ void PhysicsSystem::ClearRigidBodies()
 
 void PhysicsSystem::ClearTriggers()
 {
+    m_fullSyncPending = true;
     if (!m_world)
     {
         m_triggerRuntime.clear();
@@ -646,41 +754,41 @@ void PhysicsSystem::ClearTriggers()
     m_triggerRuntime.clear();
 }
 
-void PhysicsSystem::ClearObjectLookup()
-{
-    m_objectLookup.clear();
-}
-
-void PhysicsSystem::RegisterCollisionObject(EntityId entity, const btCollisionObject* object)
+// El EntityId viaja en el user index del propio btCollisionObject, así que
+// resolver un objeto de Bullet a entidad no requiere ningún mapa auxiliar.
+// Bullet inicializa el user index a -1. El id se guarda con sus 32 bits (con
+// generación alta sale negativo); -1 no es un id porque Scene nunca usa el
+// último índice.
+void PhysicsSystem::RegisterCollisionObject(EntityId entity, btCollisionObject* object)
 {
     if (!object)
     {
         return;
     }
-    m_objectLookup[object] = entity;
+    object->setUserIndex(static_cast<int>(entity));
 }
 
-void PhysicsSystem::UnregisterCollisionObject(const btCollisionObject* object)
+void PhysicsSystem::UnregisterCollisionObject(btCollisionObject* object)
 {
     if (!object)
     {
         return;
     }
-    m_objectLookup.erase(object);
+    object->setUserIndex(-1);
 }
 
-EntityId PhysicsSystem::FindEntityByCollisionObject(const btCollisionObject* object) const
+EntityId PhysicsSystem::FindEntityByCollisionObject(const btCollisionObject* object)
 {
     if (!object)
     {
         return kInvalidEntity;
     }
-    auto it = m_objectLookup.find(object);
-    if (it == m_objectLookup.end())
+    const int index = object->getUserIndex();
+    if (index == -1)
     {
         return kInvalidEntity;
     }
-    return it->second;
+    return static_cast<EntityId>(index);
 }
 
 std::unique_ptr<btCollisionShape> PhysicsSystem::CreateShape(ColliderShape shape, const float3& size) const
@@ -742,7 +850,7 @@ void PhysicsSystem::EnsureCharacter(Scene& scene, EntityId entity, PhysicsCharac
         btTransform startTransform;
         startTransform.setIdentity();
         startTransform.setOrigin(btVector3(transform->position.x, transform->position.y, transform->position.z));
-        startTransform.setRotation(ToBtQuaternion(transform->rotationEuler));
+        startTransform.setRotation(ToBtQuaternion(transform->rotation));
         ghost->setWorldTransform(startTransform);
         ghost->setCollisionShape(runtime.shape.get());
         ghost->setCollisionFlags(btCollisionObject::CF_CHARACTER_OBJECT);
@@ -794,10 +902,22 @@ void PhysicsSystem::HandleCharacterInput(Scene& scene, const Camera& camera, con
         return;
     }
 
-    const float moveForward = input.HasAxis("MoveForward") ? input.GetAxis("MoveForward") : 0.0f;
-    const float moveRight = input.HasAxis("MoveRight") ? input.GetAxis("MoveRight") : 0.0f;
-    const auto  jump = input.GetAction("Jump");
-    const auto  sprint = input.GetAction("Sprint");
+    CharacterInputIds& ids = m_characterInputIds;
+    if (ids.source != &input || ids.layoutVersion != input.GetLayoutVersion())
+    {
+        ids.source = &input;
+        ids.layoutVersion = input.GetLayoutVersion();
+        ids.moveForward = input.FindAxis("MoveForward");
+        ids.moveRight = input.FindAxis("MoveRight");
+        ids.jump = input.FindAction("Jump");
+        ids.sprint = input.FindAction("Sprint");
+    }
+
+    // Un eje sin binding vale 0
+    const float moveForward = input.GetAxis(ids.moveForward);
+    const float moveRight = input.GetAxis(ids.moveRight);
+    const auto  jump = input.GetAction(ids.jump);
+    const auto  sprint = input.GetAction(ids.sprint);
 
     const float yaw = camera.GetYaw();
     const float forwardX = std::cos(yaw);
@@ -854,24 +974,17 @@ void PhysicsSystem::StepSimulation(double dt)
 
     const btScalar fixedStep = btScalar(std::max(m_config.fixedStep, kMinStep));
 
-    if (m_debugDrawer)
-    {
-        m_debugDrawer->BeginFrame();
-    }
-
+    PROFILE_SCOPE("Physics::stepSimulation");
     auto start = std::chrono::high_resolution_clock::now();
-    m_lastStepSubsteps = m_world->stepSimulation(static_cast<btScalar>(dt), 4, fixedStep);
+    // maxSubSteps = 0: un único paso de 'dt' sin el acumulador interno de Bullet;
+    // el paso fijo lo lleva Application y la interpolación ApplyRenderInterpolation.
+    m_lastStepSubsteps = m_world->stepSimulation(static_cast<btScalar>(dt > 0.0 ? dt : fixedStep), 0);
     auto end = std::chrono::high_resolution_clock::now();
 
     m_lastStepDurationMs = std::chrono::duration<double, std::milli>(end - start).count();
     m_lastStepDt = dt;
-
-    if (m_debugDrawEnabled && m_debugDrawer)
-    {
-        m_world->debugDrawWorld();
-        CollectDebugLines();
-        //std::printf("[PhysicsDebug] lines=%zu\n", m_debugDrawer->GetLines().size());
-    }
+    m_profiler.Add(PhysicsPhase::Step, m_lastStepDurationMs);
+    m_profiler.CollectBulletTimings();
 }
 
 void PhysicsSystem::SyncCharactersFromPhysics(Scene& scene)
@@ -898,16 +1011,11 @@ void PhysicsSystem::SyncCharactersFromPhysics(Scene& scene)
         const btQuaternion rotation = worldTransform.getRotation();
 
         // ✅ Aplicar offset visual para que el modelo pequeño esté centrado en el cápsula
-        transform->position.x = static_cast<float>(origin.x());
-        transform->position.y = static_cast<float>(origin.y()) + runtime.visualOffsetY;
-        transform->position.z = static_cast<float>(origin.z());
-
-        btScalar yaw, pitch, roll;
-        btMatrix3x3(rotation).getEulerZYX(yaw, pitch, roll);
-        transform->rotationEuler.x = static_cast<float>(pitch);
-        transform->rotationEuler.y = static_cast<float>(yaw);
-        transform->rotationEuler.z = static_cast<float>(roll);
-        transform->MarkDirty();
+        const float3 position{
+            static_cast<float>(origin.x()),
+            static_cast<float>(origin.y()) + runtime.visualOffsetY,
+            static_cast<float>(origin.z())};
+        PushPose(runtime.pose, *transform, position, ToQuat(rotation));
 
         character->dirty = false;
     }
@@ -938,14 +1046,90 @@ void PhysicsSystem::SyncRigidBodiesFromPhysics(Scene& scene)
         const btVector3 origin = worldTransform.getOrigin();
         const btQuaternion rotation = worldTransform.getRotation();
 
-        transform->position = ToFloat3(origin);
+        PushPose(runtime.pose, *transform, ToFloat3(origin), ToQuat(rotation));
+    }
+}
+
+void PhysicsSystem::PushPose(PoseHistory& pose, Transform& transform, const float3& position, const quat& rotation)
+{
+    if (pose.valid)
+    {
+        pose.previousPosition = pose.currentPosition;
+        pose.previousRotation = pose.currentRotation;
+    }
+
+    pose.currentPosition = position;
+    pose.currentRotation = rotation;
+
+    // Tras un teletransporte (o el primer paso) no hay nada entre lo que interpolar.
+    if (!pose.valid)
+    {
+        pose.previousPosition = pose.currentPosition;
+        pose.previousRotation = pose.currentRotation;
+        pose.valid = true;
+    }
+
+    WritePose(pose, transform, position, rotation);
+}
+
+void PhysicsSystem::WritePose(PoseHistory& pose, Transform& transform, const float3& position, const quat& rotation)
+{
+    transform.position = position;
+    transform.rotation = rotation;
+    transform.MarkDirty();
+
+    pose.writtenPosition = transform.position;
+    pose.writtenRotation = transform.rotation;
+}
 
-        btScalar yaw, pitch, roll;
-        btMatrix3x3(rotation).getEulerZYX(yaw, pitch, roll);
-        transform->rotationEuler.x = static_cast<float>(pitch);
-        transform->rotationEuler.y = static_cast<float>(yaw);
-        transform->rotationEuler.z = static_cast<float>(roll);
-        transform->MarkDirty();
+bool PhysicsSystem::IsMovedExternally(const PoseHistory& pose, const Transform& transform)
+{
+    if (!pose.valid)
+    {
+        return true;
+    }
+    // Comparación exacta: si nadie más tocó el Transform, contiene justo lo que escribimos.
+    return transform.position.x != pose.writtenPosition.x
+        || transform.position.y != pose.writtenPosition.y
+        || transform.position.z != pose.writtenPosition.z
+        || !math::Equal(transform.rotation, pose.writtenRotation);
+}
+
+void PhysicsSystem::ApplyRenderInterpolation(Scene& scene, float alpha)
+{
+    alpha = std::clamp(alpha, 0.0f, 1.0f);
+
+    auto interpolate = [&](PoseHistory& pose, Transform& transform)
+    {
+        if (!pose.valid || IsMovedExternally(pose, transform))
+        {
+            return;
+        }
+
+        // Nlerp en lugar de slerp: entre dos pasos fijos la diferencia no se ve
+        // y se ahorra acos/sin por cuerpo y frame.
+        const float3 position = math::Add(pose.previousPosition, math::Scale(math::Sub(pose.currentPosition, pose.previousPosition), alpha));
+        WritePose(pose, transform, position, math::Nlerp(pose.previousRotation, pose.currentRotation, alpha));
+    };
+
+    for (auto& [entity, runtime] : m_rigidBodyRuntime)
+    {
+        if (runtime.type != RigidBodyType::Dynamic)
+        {
+            continue;
+        }
+        if (Transform* transform = scene.GetTransform(entity))
+        {
+            interpolate(runtime.pose, *transform);
+        }
+    }
+
+    for (auto& [entity, runtime] : m_characterRuntime)
+    {
+        if (Transform* transform = scene.GetTransform(entity))
+        {
+            interpolate(runtime.pose, *transform);
+        }
     }
 }
 
@@ -966,7 +1150,10 @@ void PhysicsSystem::SyncKinematicBodiesToPhysics(Scene& scene)
             continue;
         }
 
-        if (isDynamic && !body->dirty && !transform->dirty)
+        // Un cuerpo dinámico sólo se teletransporta si alguien que no es la
+        // física movió su Transform; nuestras propias escrituras también lo ensucian.
+        const bool movedExternally = transform->dirty && IsMovedExternally(runtime.pose, *transform);
+        if (isDynamic && !body->dirty && !movedExternally)
         {
             continue;
         }
@@ -978,10 +1165,11 @@ void PhysicsSystem::SyncKinematicBodiesToPhysics(Scene& scene)
             runtime.body->getMotionState()->setWorldTransform(bt);
         }
 
-        if (isDynamic && (body->dirty || transform->dirty))
+        if (isDynamic)
         {
             runtime.body->setLinearVelocity(btVector3(0.0f, 0.0f, 0.0f));
             runtime.body->setAngularVelocity(btVector3(0.0f, 0.0f, 0.0f));
+            runtime.pose.valid = false;
         }
 
         body->dirty = false;
@@ -1016,48 +1204,78 @@ void PhysicsSystem::SyncTriggersToPhysics(Scene& scene)
 
 void PhysicsSystem::ProcessTriggerEvents(Scene& scene)
 {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    std::vector<EntityId>& current = m_triggerScratch;
+    std::vector<TriggerOverlap>& next = m_triggerOverlapScratch;
+
     for (auto& [entity, runtime] : m_triggerRuntime)
     {
-        TriggerVolume* trigger = scene.GetTriggerVolume(entity);
-        if (!trigger || !runtime.ghost || !runtime.active)
+        if (!runtime.ghost || !runtime.active)
         {
             continue;
         }
 
-        std::unordered_set<EntityId> current;
         const int overlapCount = runtime.ghost->getNumOverlappingObjects();
+        if (overlapCount == 0 && runtime.overlaps.empty())
+        {
+            continue;
+        }
+
+        TriggerVolume* trigger = scene.GetTriggerVolume(entity);
+        if (!trigger)
+        {
+            continue;
+        }
+
+        current.clear();
         for (int i = 0; i < overlapCount; ++i)
         {
-            const btCollisionObject* object = runtime.ghost->getOverlappingObject(i);
-            EntityId other = FindEntityByCollisionObject(object);
+            const EntityId other = FindEntityByCollisionObject(runtime.ghost->getOverlappingObject(i));
             if (other == kInvalidEntity || other == entity)
             {
                 continue;
             }
-            current.insert(other);
+            current.push_back(other);
         }
-
-        for (EntityId other : current)
+        std::sort(current.begin(), current.end());
+        current.erase(std::unique(current.begin(), current.end()), current.end());
+
+        // Merge de dos listas ordenadas: lo que sólo está en 'current' entra,
+        // lo común permanece y lo que sólo está en 'overlaps' sale.
+        const std::vector<TriggerOverlap>& previous = runtime.overlaps;
+        next.clear();
+        size_t a = 0;
+        size_t b = 0;
+        while (a < current.size() || b < previous.size())
         {
-            if (runtime.overlaps.find(other) == runtime.overlaps.end())
+            if (b == previous.size() || (a < current.size() && current[a] < previous[b].other))
             {
-                m_eventBus.Publish(TriggerEvent{TriggerEvent::Type::Enter, entity, other});
+                m_pendingTriggerEvents.push_back(TriggerEvent{TriggerEvent::Type::Enter, entity, current[a]});
+                next.push_back(TriggerOverlap{current[a], false});
+                ++a;
             }
-            else
+            else if (a == current.size() || previous[b].other < current[a])
             {
-                m_eventBus.Publish(TriggerEvent{TriggerEvent::Type::Stay, entity, other});
+                m_pendingTriggerEvents.push_back(TriggerEvent{TriggerEvent::Type::Exit, entity, previous[b].other});
+                ++b;
             }
-        }
-
-        for (EntityId previous : runtime.overlaps)
-        {
-            if (current.find(previous) == current.end())
+            else
             {
-                m_eventBus.Publish(TriggerEvent{TriggerEvent::Type::Exit, entity, previous});
+                // Con coalesceStayEvents cada par emite un solo Stay por flush,
+                // aunque haya empezado a solaparse en un substep posterior.
+                if (!m_config.coalesceStayEvents || !previous[b].stayEmitted)
+                {
+                    m_pendingTriggerEvents.push_back(TriggerEvent{TriggerEvent::Type::Stay, entity, current[a]});
+                }
+                next.push_back(TriggerOverlap{current[a], true});
+                ++a;
+                ++b;
             }
         }
 
-        runtime.overlaps = std::move(current);
+        // Intercambiar conserva la capacidad de ambos buffers entre frames.
+        runtime.overlaps.swap(next);
 
         if (runtime.oneShot && !runtime.overlaps.empty())
         {
@@ -1071,6 +1289,185 @@ void PhysicsSystem::ProcessTriggerEvents(Scene& scene)
             runtime.overlaps.clear();
         }
     }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    m_lastTriggerDurationMs = std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void PhysicsSystem::ProcessContactEvents()
+{
+    if (!m_config.collisionEvents || !m_dispatcher)
+    {
+        m_contactPairs.clear();
+        return;
+    }
+
+    m_contactScratch.clear();
+    const int manifoldCount = m_dispatcher->getNumManifolds();
+    for (int i = 0; i < manifoldCount; ++i)
+    {
+        const btPersistentManifold* manifold = m_dispatcher->getManifoldByIndexInternal(i);
+        const int contactCount = manifold->getNumContacts();
+        if (contactCount == 0)
+        {
+            continue;
+        }
+
+        // Sólo rigid bodies: los ghosts de triggers y personajes ya tienen sus propios eventos.
+        const btCollisionObject* objectA = manifold->getBody0();
+        const btCollisionObject* objectB = manifold->getBody1();
+        if (!btRigidBody::upcast(objectA) || !btRigidBody::upcast(objectB))
+        {
+            continue;
+        }
+
+        EntityId a = FindEntityByCollisionObject(objectA);
+        EntityId b = FindEntityByCollisionObject(objectB);
+        if (a == kInvalidEntity && b == kInvalidEntity)
+        {
+            continue;
+        }
+
+        const bool swapped = a == kInvalidEntity || (b != kInvalidEntity && b < a);
+        if (swapped)
+        {
+            std::swap(a, b);
+        }
+
+        int deepest = 0;
+        float impulse = 0.0f;
+        for (int c = 0; c < contactCount; ++c)
+        {
+            const btManifoldPoint& point = manifold->getContactPoint(c);
+            impulse += point.getAppliedImpulse();
+            if (point.getDistance() < manifold->getContactPoint(deepest).getDistance())
+            {
+                deepest = c;
+            }
+        }
+
+        // m_normalWorldOnB apunta de B hacia A (body0).
+        const btManifoldPoint& point = manifold->getContactPoint(deepest);
+        const btVector3 normal = swapped ? -point.m_normalWorldOnB : point.m_normalWorldOnB;
+
+        ContactSample sample;
+        sample.key = (static_cast<uint64_t>(a) << 32) | static_cast<uint64_t>(b);
+        sample.a = a;
+        sample.b = b;
+        sample.point = ToFloat3(point.getPositionWorldOnB());
+        sample.normal = ToFloat3(normal);
+        sample.impulse = impulse;
+        sample.depth = point.getDistance();
+        sample.contactCount = static_cast<uint32_t>(contactCount);
+        m_contactScratch.push_back(sample);
+    }
+
+    std::sort(m_contactScratch.begin(), m_contactScratch.end(), [](const ContactSample& lhs, const ContactSample& rhs)
+    {
+        return lhs.key < rhs.key;
+    });
+
+    // Un par puede tener varios manifolds (shapes compuestos): se fusionan en
+    // uno sumando impulso y contactos y quedándose con el punto más profundo.
+    size_t merged = 0;
+    for (size_t i = 0; i < m_contactScratch.size(); ++i)
+    {
+        const ContactSample& sample = m_contactScratch[i];
+        if (merged > 0 && m_contactScratch[merged - 1].key == sample.key)
+        {
+            ContactSample& target = m_contactScratch[merged - 1];
+            target.impulse += sample.impulse;
+            target.contactCount += sample.contactCount;
+            if (sample.depth < target.depth)
+            {
+                target.point = sample.point;
+                target.normal = sample.normal;
+                target.depth = sample.depth;
+            }
+            continue;
+        }
+        m_contactScratch[merged++] = sample;
+    }
+    m_contactScratch.resize(merged);
+
+    auto makeEvent = [](CollisionEvent::Type type, const ContactSample& sample)
+    {
+        CollisionEvent evt;
+        evt.type = type;
+        evt.a = sample.a;
+        evt.b = sample.b;
+        evt.point = sample.point;
+        evt.normal = sample.normal;
+        evt.impulse = sample.impulse;
+        evt.contactCount = sample.contactCount;
+        return evt;
+    };
+
+    std::vector<ContactPair>& next = m_contactPairScratch;
+    next.clear();
+    size_t a = 0;
+    size_t b = 0;
+    while (a < m_contactScratch.size() || b < m_contactPairs.size())
+    {
+        if (b == m_contactPairs.size() || (a < m_contactScratch.size() && m_contactScratch[a].key < m_contactPairs[b].key))
+        {
+            m_pendingCollisionEvents.push_back(makeEvent(CollisionEvent::Type::Enter, m_contactScratch[a]));
+            next.push_back(ContactPair{m_contactScratch[a].key, false});
+            ++a;
+        }
+        else if (a == m_contactScratch.size() || m_contactPairs[b].key < m_contactScratch[a].key)
+        {
+            CollisionEvent evt;
+            evt.type = CollisionEvent::Type::Exit;
+            evt.a = static_cast<EntityId>(m_contactPairs[b].key >> 32);
+            evt.b = static_cast<EntityId>(m_contactPairs[b].key & 0xffffffffu);
+            m_pendingCollisionEvents.push_back(evt);
+            ++b;
+        }
+        else
+        {
+            if (!m_config.coalesceStayEvents || !m_contactPairs[b].stayEmitted)
+            {
+                m_pendingCollisionEvents.push_back(makeEvent(CollisionEvent::Type::Stay, m_contactScratch[a]));
+            }
+            next.push_back(ContactPair{m_contactScratch[a].key, true});
+            ++a;
+            ++b;
+        }
+    }
+
+    m_contactPairs.swap(next);
+}
+
+void PhysicsSystem::FlushEvents()
+{
+    if (!m_pendingTriggerEvents.empty())
+    {
+        m_eventBus.Publish(TriggerEventBatch{m_pendingTriggerEvents.data(), m_pendingTriggerEvents.size()});
+    }
+    if (!m_pendingCollisionEvents.empty())
+    {
+        m_eventBus.Publish(CollisionEventBatch{m_pendingCollisionEvents.data(), m_pendingCollisionEvents.size()});
+    }
+
+    m_pendingTriggerEvents.clear();
+    m_pendingCollisionEvents.clear();
+
+    // Con coalesceStayEvents, el siguiente flush vuelve a llevar un Stay por par.
+    if (m_config.coalesceStayEvents)
+    {
+        for (auto& [entity, runtime] : m_triggerRuntime)
+        {
+            for (TriggerOverlap& overlap : runtime.overlaps)
+            {
+                overlap.stayEmitted = false;
+            }
+        }
+        for (ContactPair& pair : m_contactPairs)
+        {
+            pair.stayEmitted = false;
+        }
+    }
 }
 
 bool PhysicsSystem::Raycast(const float3& origin,
@@ -1145,7 +1542,7 @@ std::vector<PhysicsRaycastHit> PhysicsSystem::RaycastAll(const float3& origin,
     return hits;
 }
 
-void PhysicsSystem::CollectDebugLines()
+void PhysicsSystem::CollectDebugLines(const PhysicsDebugFrustum& frustum)
 {
     if (!m_world || !m_debugDrawer)
     {
@@ -1165,6 +1562,18 @@ void PhysicsSystem::CollectDebugLines()
             continue;
         }
 
+        // Descarta con el AABB del broadphase antes de generar ninguna línea.
+        if (const btBroadphaseProxy* proxy = object->getBroadphaseHandle())
+        {
+            const float aabbMin[3] = {proxy->m_aabbMin.x(), proxy->m_aabbMin.y(), proxy->m_aabbMin.z()};
+            const float aabbMax[3] = {proxy->m_aabbMax.x(), proxy->m_aabbMax.y(), proxy->m_aabbMax.z()};
+            if (!frustum.IntersectsAabb(aabbMin, aabbMax))
+            {
+                ++m_debugObjectsCulled;
+                continue;
+            }
+        }
+
         uint32_t color = object->isStaticObject() ? kStaticColor : kDynamicColor;
         if (object->getCollisionFlags() & btCollisionObject::CF_NO_CONTACT_RESPONSE)
         {
@@ -1194,6 +1603,35 @@ void PhysicsSystem::SetDebugOverlayEnabled(bool enabled)
     std::printf("[PhysicsDebug] overlay %s\n", enabled ? "ON" : "OFF");
 }
 
+const PhysicsDebugLineBuffer& PhysicsSystem::BuildDebugLines(const float viewProj[16])
+{
+    if (!m_debugDrawEnabled || !m_debugDrawer || !m_world)
+    {
+        m_lastDebugLinesMs = 0.0;
+        return GetDebugLines();
+    }
+
+    PROFILE_SCOPE("Physics::BuildDebugLines");
+    auto start = std::chrono::high_resolution_clock::now();
+
+    PhysicsDebugFrustum frustum;
+    if (viewProj)
+    {
+        frustum.SetFromViewProj(viewProj);
+    }
+
+    m_debugDrawer->BeginFrame();
+    m_debugObjectsCulled = 0;
+    m_world->debugDrawWorld();
+    CollectDebugLines(frustum);
+
+    auto end = std::chrono::high_resolution_clock::now();
+    m_lastDebugLinesMs = std::chrono::duration<double, std::milli>(end - start).count();
+    // Una vez por frame renderizado, fuera de Update: cuenta en el paso siguiente.
+    m_profiler.Add(PhysicsPhase::DebugLines, m_lastDebugLinesMs);
+    return m_debugDrawer->GetLines();
+}
+
 const PhysicsDebugLineBuffer& PhysicsSystem::GetDebugLines() const
 {
     if (m_debugDrawEnabled && m_debugDrawer)
@@ -1205,19 +1643,58 @@ const PhysicsDebugLineBuffer& PhysicsSystem::GetDebugLines() const
     return m_emptyDebugLines;
 }
 
-void PhysicsSystem::Update(Scene& scene, const Camera& camera, const InputSystem& input, double dt)
+bool PhysicsSystem::CollectSceneChanges(const Scene& scene)
 {
-    EnsureWorld();
-    if (!m_world)
+    m_changedBodies.clear();
+    m_changedTriggers.clear();
+    m_removedBodies.clear();
+    m_removedTriggers.clear();
+    m_removedCharacters.clear();
+
+    auto collect = [&](ComponentType type, std::vector<EntityId>* changed, std::vector<EntityId>* removed)
     {
-        return;
+        const uint64_t since = m_changeCursors[static_cast<size_t>(type)];
+        return scene.GetChanges(type).ForEachSince(since, [&](const ComponentChangeLog::Entry& entry)
+        {
+            if (entry.change == ComponentChange::Removed)
+            {
+                if (removed)
+                {
+                    removed->push_back(entry.entity);
+                }
+            }
+            else if (changed)
+            {
+                changed->push_back(entry.entity);
+            }
+        });
+    };
+
+    // Un Transform nuevo puede completar un cuerpo o trigger que esperaba por él
+    bool ok = collect(ComponentType::Transform, &m_changedBodies, nullptr);
+    if (ok)
+    {
+        m_changedTriggers = m_changedBodies;
     }
+    ok = ok && collect(ComponentType::Collider, &m_changedBodies, &m_removedBodies);
+    ok = ok && collect(ComponentType::RigidBody, &m_changedBodies, &m_removedBodies);
+    ok = ok && collect(ComponentType::TriggerVolume, &m_changedTriggers, &m_removedTriggers);
+    ok = ok && collect(ComponentType::PhysicsCharacter, nullptr, &m_removedCharacters);
+    return ok;
+}
 
-    if (m_forceCharacterRebuild)
+void PhysicsSystem::MarkSceneChangesConsumed(const Scene& scene)
+{
+    for (size_t i = 0; i < m_changeCursors.size(); ++i)
     {
-        ClearCharacters(scene);
-        m_forceCharacterRebuild = false;
+        m_changeCursors[i] = scene.GetChanges(static_cast<ComponentType>(i)).GetVersion();
     }
+    m_fullSyncPending = false;
+}
+
+void PhysicsSystem::FullSceneSync(Scene& scene)
+{
+    PROFILE_SCOPE("Physics::FullSceneSync");
 
     std::vector<EntityId> bodiesToRemove;
     for (const auto& [entity, runtime] : m_rigidBodyRuntime)
@@ -1245,44 +1722,147 @@ void PhysicsSystem::Update(Scene& scene, const Camera& camera, const InputSystem
         RemoveTrigger(scene, id);
     }
 
+    std::vector<EntityId> charactersToRemove;
+    for (const auto& [entity, runtime] : m_characterRuntime)
+    {
+        if (!scene.IsAlive(entity) || !scene.GetPhysicsCharacter(entity))
+        {
+            charactersToRemove.push_back(entity);
+        }
+    }
+    for (EntityId id : charactersToRemove)
+    {
+        RemoveCharacter(scene, id);
+    }
+
     for (auto& [entity, body] : scene.GetRigidBodies())
     {
-        if (!scene.IsAlive(entity))
+        if (Collider* collider = scene.GetCollider(entity))
         {
-            continue;
+            EnsureRigidBody(scene, entity, *collider, body);
         }
+    }
+
+    for (auto& [entity, trigger] : scene.GetTriggerVolumes())
+    {
+        EnsureTrigger(scene, entity, trigger);
+    }
+}
+
+#ifndef NDEBUG
+void PhysicsSystem::CheckMissedSceneChanges(Scene& scene)
+{
+    for (auto& [entity, body] : scene.GetRigidBodies())
+    {
         Collider* collider = scene.GetCollider(entity);
-        if (!collider)
+        if (!collider || !scene.GetTransform(entity))
         {
             continue;
         }
-        EnsureRigidBody(scene, entity, *collider, body);
+        if (collider->dirty || body.dirty || m_rigidBodyRuntime.count(entity) == 0)
+        {
+            std::printf("[Physics] Cambio de cuerpo sin registrar en la entidad %u (usa Scene::EditCollider/EditRigidBody)\n", entity);
+            EnsureRigidBody(scene, entity, *collider, body);
+        }
     }
 
     for (auto& [entity, trigger] : scene.GetTriggerVolumes())
     {
-        if (!scene.IsAlive(entity))
+        if (!scene.GetTransform(entity))
         {
             continue;
         }
-        EnsureTrigger(scene, entity, trigger);
+        if (trigger.dirty || m_triggerRuntime.count(entity) == 0)
+        {
+            std::printf("[Physics] Cambio de trigger sin registrar en la entidad %u (usa Scene::EditTriggerVolume)\n", entity);
+            EnsureTrigger(scene, entity, trigger);
+        }
     }
+}
+#endif
 
-    auto& characters = scene.GetPhysicsCharacters();
+void PhysicsSystem::IncrementalSceneSync(Scene& scene)
+{
+    // Primero las bajas: si el componente se ha vuelto a añadir en el mismo
+    // paso sigue ahí y el runtime se reconstruye abajo por su flag dirty.
+    for (EntityId entity : m_removedBodies)
+    {
+        if (m_rigidBodyRuntime.count(entity) > 0
+            && (!scene.IsAlive(entity) || !scene.GetRigidBody(entity) || !scene.GetCollider(entity)))
+        {
+            RemoveRigidBody(scene, entity);
+        }
+    }
+    for (EntityId entity : m_removedTriggers)
+    {
+        if (m_triggerRuntime.count(entity) > 0 && (!scene.IsAlive(entity) || !scene.GetTriggerVolume(entity)))
+        {
+            RemoveTrigger(scene, entity);
+        }
+    }
+    for (EntityId entity : m_removedCharacters)
+    {
+        if (m_characterRuntime.count(entity) > 0 && (!scene.IsAlive(entity) || !scene.GetPhysicsCharacter(entity)))
+        {
+            RemoveCharacter(scene, entity);
+        }
+    }
 
-    std::vector<EntityId> toRemove;
-    for (const auto& [entity, runtime] : m_characterRuntime)
+    // Un mismo id puede venir varias veces; Ensure* no hace nada si ya está al día
+    for (EntityId entity : m_changedBodies)
+    {
+        RigidBody* body = scene.GetRigidBody(entity);
+        Collider* collider = scene.GetCollider(entity);
+        if (body && collider)
+        {
+            EnsureRigidBody(scene, entity, *collider, *body);
+        }
+    }
+    for (EntityId entity : m_changedTriggers)
     {
-        if (!scene.IsAlive(entity) || characters.find(entity) == characters.end())
+        if (TriggerVolume* trigger = scene.GetTriggerVolume(entity))
         {
-            toRemove.push_back(entity);
+            EnsureTrigger(scene, entity, *trigger);
         }
     }
-    for (EntityId id : toRemove)
+}
+
+void PhysicsSystem::Update(Scene& scene, const Camera& camera, const InputSystem& input, double dt)
+{
+    EnsureWorld();
+    if (!m_world)
     {
-        RemoveCharacter(scene, id);
+        return;
     }
 
+    PROFILE_SCOPE("Physics::Update");
+    const auto updateStart = std::chrono::high_resolution_clock::now();
+    m_profiler.BeginStep();
+
+    if (m_forceCharacterRebuild)
+    {
+        ClearCharacters(scene);
+        m_forceCharacterRebuild = false;
+    }
+
+    // Altas, bajas y cambios de cuerpos/triggers desde el paso anterior. Con
+    // ids generacionales un runtime de una entidad destruida ya no está vivo
+    // aunque su slot se haya reutilizado.
+    if (m_fullSyncPending || !CollectSceneChanges(scene))
+    {
+        FullSceneSync(scene);
+    }
+    else
+    {
+        IncrementalSceneSync(scene);
+#ifndef NDEBUG
+        CheckMissedSceneChanges(scene);
+#endif
+    }
+    MarkSceneChangesConsumed(scene);
+
+    auto& characters = scene.GetPhysicsCharacters();
+
     for (auto& [entity, character] : characters)
     {
         if (!scene.IsAlive(entity))
@@ -1299,12 +1879,14 @@ void PhysicsSystem::Update(Scene& scene, const Camera& camera, const InputSystem
         }
 
         CharacterRuntime& runtime = runtimeIt->second;
-        if (character.dirty || transform->dirty)
+        if (character.dirty || (transform->dirty && IsMovedExternally(runtime.pose, *transform)))
         {
+            runtime.pose.valid = false;
+
             btTransform worldTransform;
             worldTransform.setIdentity();
             worldTransform.setOrigin(btVector3(transform->position.x, transform->position.y, transform->position.z));
-            worldTransform.setRotation(ToBtQuaternion(transform->rotationEuler));
+            worldTransform.setRotation(ToBtQuaternion(transform->rotation));
 
             if (runtime.ghost)
             {
@@ -1318,25 +1900,64 @@ void PhysicsSystem::Update(Scene& scene, const Camera& camera, const InputSystem
         }
     }
 
-    SyncKinematicBodiesToPhysics(scene);
-    SyncTriggersToPhysics(scene);
-    HandleCharacterInput(scene, camera, input, dt);
+    {
+        PhysicsProfileScope scope(m_profiler, PhysicsPhase::SyncKinematic);
+        SyncKinematicBodiesToPhysics(scene);
+        SyncTriggersToPhysics(scene);
+    }
+    {
+        PhysicsProfileScope scope(m_profiler, PhysicsPhase::CharacterController);
+        HandleCharacterInput(scene, camera, input, dt);
+    }
     StepSimulation(dt);
-    SyncRigidBodiesFromPhysics(scene);
-    SyncCharactersFromPhysics(scene);
-    ProcessTriggerEvents(scene);
+    {
+        PhysicsProfileScope scope(m_profiler, PhysicsPhase::SyncRigidBodies);
+        SyncRigidBodiesFromPhysics(scene);
+    }
+    {
+        PhysicsProfileScope scope(m_profiler, PhysicsPhase::SyncCharacters);
+        SyncCharactersFromPhysics(scene);
+    }
+    {
+        PhysicsProfileScope scope(m_profiler, PhysicsPhase::TriggerEvents);
+        ProcessTriggerEvents(scene);
+    }
+    {
+        PhysicsProfileScope scope(m_profiler, PhysicsPhase::ContactEvents);
+        ProcessContactEvents();
+    }
+
+    const auto updateEnd = std::chrono::high_resolution_clock::now();
+    m_profiler.Add(PhysicsPhase::Update, std::chrono::duration<double, std::milli>(updateEnd - updateStart).count());
+    m_profiler.EndStep();
 }
 
 void PhysicsSystem::LogStats() const
 {
     const int bodies = m_world ? m_world->getNumCollisionObjects() : 0;
     const size_t characters = m_characterRuntime.size();
-    std::printf("[Physics] bodies=%d characters=%zu stepTime=%.4fms substeps=%d fixedStep=%.4f actualDt=%.4f\n",
+    std::printf("[Physics] bodies=%d characters=%zu triggers=%zu stepTime=%.4fms triggerTime=%.4fms substeps=%d fixedStep=%.4f actualDt=%.4f\n",
                 bodies,
                 characters,
+                m_triggerRuntime.size(),
                 m_lastStepDurationMs,
+                m_lastTriggerDurationMs,
                 m_lastStepSubsteps,
                 m_config.fixedStep,
                 m_lastStepDt);
+
+    const int threads = m_worldMultithreaded && btGetTaskScheduler() ? btGetTaskScheduler()->getNumThreads() : 1;
+    std::printf("[Physics] world=%s threads=%d\n", m_worldMultithreaded ? "mt" : "st", threads);
+    m_profiler.Log();
+
+    for (const PhysicsBenchmark::StressSample& sample : PhysicsBenchmark::GetLastStressResults())
+    {
+        std::printf("[Physics]   stress bodies=%d world=%s threads=%d avgStep=%.4fms maxStep=%.4fms\n",
+                    sample.bodies,
+                    sample.multithreaded ? "mt" : "st",
+                    sample.threads,
+                    sample.avgStepMs,
+                    sample.maxStepMs);
+    }
 }
 
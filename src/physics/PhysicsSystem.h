@@ -2,14 +2,19 @@
 
 #include "PhysicsCharacter.h"
 #include "PhysicsDebugDraw.h"
+#include "PhysicsProfiler.h"
 
 #include "../core/EventBus.h"
+#include "../ecs/ComponentChangeLog.h"
 #include "../ecs/PhysicsComponents.h"
+#include "../input/InputId.h"
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <memory>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 class Scene;
@@ -21,6 +26,7 @@ class btDbvtBroadphase;
 class btDefaultCollisionConfiguration;
 class btCollisionDispatcher;
 class btSequentialImpulseConstraintSolver;
+class btConstraintSolverPoolMt;
 class btDiscreteDynamicsWorld;
 class btBroadphaseInterface;
 class btGhostPairCallback;
@@ -32,6 +38,7 @@ class btKinematicCharacterController;
 class BulletDebugDrawer;
 class btMotionState;
 class btCollisionObject;
+class btQuaternion;
 struct PhysicsRaycastHit;
 
 class PhysicsSystem
@@ -42,9 +49,22 @@ public:
 
     void SetConfigPath(std::filesystem::path path);
     void Initialize();
+    // Debe llamarse antes de Initialize(); en caliente se aplica al recargar escena.
+    void SetThreading(bool multithreaded, int threadCount);
+    bool IsMultithreaded() const { return m_worldMultithreaded; }
     void OnSceneReloaded(Scene& scene);
+    // Tras una recarga incremental (ApplySceneDiff): conserva los runtimes de
+    // lo que no ha cambiado.
+    void OnSceneEdited(Scene& scene);
+    // El modo multihilo de physics.json sólo se aplica con OnSceneReloaded.
+    bool NeedsWorldRebuild() const { return m_world && m_worldMultithreaded != m_config.multithreaded; }
     bool ReloadConfigIfNeeded(Scene& scene);
+    const std::filesystem::path& GetConfigPath() const { return m_configPath; }
+    // Avanza exactamente un paso de 'dt'. El bucle de paso fijo vive en Application.
     void Update(Scene& scene, const Camera& camera, const InputSystem& input, double dt);
+    // Escribe en los Transform la pose interpolada entre los dos últimos pasos
+    // (alpha = acumulador / paso fijo) para cuerpos dinámicos y personajes.
+    void ApplyRenderInterpolation(Scene& scene, float alpha);
     void LogStats() const;
 
     struct TriggerEvent
@@ -61,8 +81,48 @@ public:
         EntityId other   = kInvalidEntity;
     };
 
+    // Contacto entre dos rigid bodies. 'b' es kInvalidEntity cuando el otro
+    // objeto es el suelo del mundo. La normal apunta hacia 'a'.
+    struct CollisionEvent
+    {
+        enum class Type
+        {
+            Enter,
+            Stay,
+            Exit,
+        };
+
+        Type     type = Type::Enter;
+        EntityId a = kInvalidEntity;
+        EntityId b = kInvalidEntity;
+        float3   point{0.0f, 0.0f, 0.0f};
+        float3   normal{0.0f, 1.0f, 0.0f};
+        float    impulse = 0.0f;
+        uint32_t contactCount = 0; // puntos de contacto sumando todos los manifolds del par
+    };
+
+    // Lotes que FlushEvents() publica en el EventBus. Los punteros sólo son
+    // válidos mientras dura la llamada al suscriptor.
+    struct TriggerEventBatch
+    {
+        const TriggerEvent* events = nullptr;
+        size_t              count  = 0;
+    };
+
+    struct CollisionEventBatch
+    {
+        const CollisionEvent* events = nullptr;
+        size_t                count  = 0;
+    };
+
     EventBus& GetEventBus() { return m_eventBus; }
 
+    // Los eventos se acumulan durante los Update() y se entregan de una vez
+    // en FlushEvents(), normalmente una vez por frame tras el paso fijo.
+    const std::vector<TriggerEvent>&   GetPendingTriggerEvents() const { return m_pendingTriggerEvents; }
+    const std::vector<CollisionEvent>& GetPendingCollisionEvents() const { return m_pendingCollisionEvents; }
+    void FlushEvents();
+
     bool Raycast(const float3& origin,
                  const float3& direction,
                  float maxDistance,
@@ -75,11 +135,18 @@ public:
                                                      uint32_t layerMask) const;
 
     double GetFixedStep() const { return m_config.fixedStep; }
+    double GetLastStepDurationMs() const { return m_lastStepDurationMs; }
+    double GetLastTriggerDurationMs() const { return m_lastTriggerDurationMs; }
+    const PhysicsProfiler& GetProfiler() const { return m_profiler; }
 
     void ToggleDebugOverlay();
     void SetDebugOverlayEnabled(bool enabled);
     bool IsDebugOverlayEnabled() const { return m_debugDrawEnabled; }
     const PhysicsDebugLineBuffer& GetDebugLines() const;
+    // Regenera las líneas del overlay descartando lo que queda fuera del frustum.
+    // viewProj = view * proj (convención bx); nullptr desactiva el culling.
+    const PhysicsDebugLineBuffer& BuildDebugLines(const float viewProj[16]);
+    size_t GetDebugObjectsCulled() const { return m_debugObjectsCulled; }
 
 private:
     struct Config
@@ -92,6 +159,43 @@ private:
         float capsuleRadius = 0.35f;
         float walkSpeed = 3.5f;
         float jumpImpulse = 5.0f;
+        bool  collisionEvents = true;
+        bool  coalesceStayEvents = false;
+        bool  multithreaded = false;
+        int   threads = 0; // 0 = todos los hilos del pool
+    };
+
+    struct ContactSample
+    {
+        uint64_t key = 0;
+        EntityId a = kInvalidEntity;
+        EntityId b = kInvalidEntity;
+        float3   point{0.0f, 0.0f, 0.0f};
+        float3   normal{0.0f, 1.0f, 0.0f};
+        float    impulse = 0.0f;
+        float    depth = 0.0f; // distancia del punto más profundo (negativa si penetra)
+        uint32_t contactCount = 0;
+    };
+
+    // Par en contacto del paso anterior. 'stayEmitted' indica que ya salió su
+    // Stay desde el último FlushEvents (sólo cuenta con coalesceStayEvents).
+    struct ContactPair
+    {
+        uint64_t key = 0;
+        bool     stayEmitted = false;
+    };
+
+    // Poses de los dos últimos pasos y lo último que se escribió en el Transform,
+    // para distinguir nuestras escrituras de un movimiento hecho por gameplay.
+    struct PoseHistory
+    {
+        float3 previousPosition{0.0f, 0.0f, 0.0f};
+        float3 currentPosition{0.0f, 0.0f, 0.0f};
+        quat   previousRotation{};
+        quat   currentRotation{};
+        float3 writtenPosition{0.0f, 0.0f, 0.0f};
+        quat   writtenRotation{};
+        bool   valid = false;
     };
 
     struct CharacterRuntime
@@ -100,14 +204,17 @@ private:
         std::unique_ptr<btPairCachingGhostObject> ghost;
         std::unique_ptr<btKinematicCharacterController> controller;
         float visualOffsetY = 0.0f;
+        PoseHistory pose;
     };
 
     void EnsureWorld();
     void InitializeWorld();
+    void ShutdownWorld();
     void EnsureGround();
     void ApplyConfig(Scene& scene, const Config& newConfig);
     Config LoadConfigFromDisk() const;
     void ClearCharacters(Scene& scene);
+    void EnsurePlayerCharacter(Scene& scene);
     void EnsureCharacter(Scene& scene, EntityId entity, PhysicsCharacter& character);
     void RemoveCharacter(Scene& scene, EntityId entity);
     void EnsureRigidBody(Scene& scene, EntityId entity, Collider& collider, RigidBody& body);
@@ -121,13 +228,27 @@ private:
     void SyncKinematicBodiesToPhysics(Scene& scene);
     void SyncTriggersToPhysics(Scene& scene);
     void ProcessTriggerEvents(Scene& scene);
-    void CollectDebugLines();
+    void ProcessContactEvents();
+    void CollectDebugLines(const PhysicsDebugFrustum& frustum);
     void ClearRigidBodies();
     void ClearTriggers();
-    void ClearObjectLookup();
-    void RegisterCollisionObject(EntityId entity, const btCollisionObject* object);
-    void UnregisterCollisionObject(const btCollisionObject* object);
-    EntityId FindEntityByCollisionObject(const btCollisionObject* object) const;
+    // Sincronización escena -> runtimes: completa (recorre todo) o sólo con
+    // los cambios registrados en Scene desde el paso anterior.
+    bool CollectSceneChanges(const Scene& scene);
+    void MarkSceneChangesConsumed(const Scene& scene);
+    void FullSceneSync(Scene& scene);
+    void IncrementalSceneSync(Scene& scene);
+#ifndef NDEBUG
+    // Repasa lo que haría FullSceneSync y corrige (avisando) los cambios que
+    // el registro de Scene no vio: escrituras por Get* sin Edit*/MarkModified.
+    void CheckMissedSceneChanges(Scene& scene);
+#endif
+    static void PushPose(PoseHistory& pose, Transform& transform, const float3& position, const quat& rotation);
+    static void WritePose(PoseHistory& pose, Transform& transform, const float3& position, const quat& rotation);
+    static bool IsMovedExternally(const PoseHistory& pose, const Transform& transform);
+    static void RegisterCollisionObject(EntityId entity, btCollisionObject* object);
+    static void UnregisterCollisionObject(btCollisionObject* object);
+    static EntityId FindEntityByCollisionObject(const btCollisionObject* object);
     std::unique_ptr<btCollisionShape> CreateShape(ColliderShape shape, const float3& size) const;
 
 private:
@@ -141,14 +262,28 @@ private:
     std::unique_ptr<btDefaultCollisionConfiguration>  m_collisionConfig;
     std::unique_ptr<btCollisionDispatcher>            m_dispatcher;
     std::unique_ptr<btSequentialImpulseConstraintSolver> m_solver;
+    std::unique_ptr<btConstraintSolverPoolMt>         m_solverPool;
     std::unique_ptr<btDiscreteDynamicsWorld>          m_world;
     std::unique_ptr<btGhostPairCallback>              m_ghostPairCallback;
+    bool                                              m_worldMultithreaded = false;
 
     std::unique_ptr<btCollisionShape>   m_groundShape;
     std::unique_ptr<btDefaultMotionState> m_groundMotionState;
     std::unique_ptr<btRigidBody>        m_groundBody;
 
     std::unordered_map<EntityId, CharacterRuntime> m_characterRuntime;
+
+    // Handles de entrada del personaje; se re-resuelven si cambia el layout de InputSystem.
+    struct CharacterInputIds
+    {
+        const InputSystem* source = nullptr;
+        uint32_t           layoutVersion = 0;
+        InputId            moveForward;
+        InputId            moveRight;
+        InputId            jump;
+        InputId            sprint;
+    } m_characterInputIds;
+
     struct RigidBodyRuntime
     {
         std::unique_ptr<btCollisionShape> shape;
@@ -157,13 +292,20 @@ private:
         RigidBodyType                     type = RigidBodyType::Static;
         uint32_t                          layer = 0u;
         uint32_t                          mask  = 0xffffffffu;
+        PoseHistory                       pose;
+    };
+
+    struct TriggerOverlap
+    {
+        EntityId other = kInvalidEntity;
+        bool     stayEmitted = false; // Stay ya emitido desde el último FlushEvents
     };
 
     struct TriggerRuntime
     {
         std::unique_ptr<btCollisionShape>        shape;
         std::unique_ptr<btPairCachingGhostObject> ghost;
-        std::unordered_set<EntityId>             overlaps;
+        std::vector<TriggerOverlap>              overlaps; // ordenado por 'other', sin duplicados
         uint32_t                                 layer = 0u;
         uint32_t                                 mask  = 0xffffffffu;
         bool                                     oneShot = false;
@@ -172,17 +314,38 @@ private:
 
     std::unordered_map<EntityId, RigidBodyRuntime> m_rigidBodyRuntime;
     std::unordered_map<EntityId, TriggerRuntime>   m_triggerRuntime;
-    std::unordered_map<const btCollisionObject*, EntityId> m_objectLookup;
+    std::vector<EntityId>                          m_triggerScratch;
+    std::vector<TriggerOverlap>                    m_triggerOverlapScratch;
+
+    std::vector<ContactPair>   m_contactPairs; // ordenado, clave (a << 32) | b
+    std::vector<ContactPair>   m_contactPairScratch;
+    std::vector<ContactSample> m_contactScratch;
+
+    std::vector<TriggerEvent>   m_pendingTriggerEvents;
+    std::vector<CollisionEvent> m_pendingCollisionEvents;
 
     double m_lastStepDurationMs = 0.0;
+    double m_lastTriggerDurationMs = 0.0;
     double m_lastStepDt = 0.0;
     int    m_lastStepSubsteps = 0;
+    PhysicsProfiler m_profiler;
 
     bool m_forceCharacterRebuild = false;
+    // Versión leída de cada Scene::GetChanges; m_fullSyncPending obliga a
+    // recorrer la escena (carga nueva, mundo reconstruido)
+    std::array<uint64_t, static_cast<size_t>(ComponentType::Count)> m_changeCursors{};
+    bool                  m_fullSyncPending = true;
+    std::vector<EntityId> m_changedBodies;
+    std::vector<EntityId> m_changedTriggers;
+    std::vector<EntityId> m_removedBodies;
+    std::vector<EntityId> m_removedTriggers;
+    std::vector<EntityId> m_removedCharacters;
 
     std::unique_ptr<BulletDebugDrawer> m_debugDrawer;
     mutable PhysicsDebugLineBuffer     m_emptyDebugLines;
     bool                               m_debugDrawEnabled = false;
+    size_t                             m_debugObjectsCulled = 0;
+    double                             m_lastDebugLinesMs = 0.0;
 
     EventBus m_eventBus;
 };
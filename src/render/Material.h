@@ -1,5 +1,6 @@
 #pragma once
 #include <bgfx/bgfx.h>
+#include "../resource/ResourceHandle.h"
 
 struct Material {
     // Albedo / UV
@@ -7,6 +8,9 @@ struct Material {
     float uvScale[4]  = {1, 1, 0, 0};   // tiling simple
     bgfx::TextureHandle albedo = BGFX_INVALID_HANDLE;
     bool ownsTexture = false;           // si true, destroy() liberará la textura
+    // Textura del ResourceManager; si es válida manda sobre 'albedo' y sigue
+    // a la textura al recargarla en caliente.
+    resource::TextureHandle albedoTexture{};
 
     // Especular (lo que falta)
     // specParams.x = shininess (p.ej. 32, 64, 128)
@@ -28,6 +32,7 @@ struct Material {
         specColor[3] = 0.0f;
 
         albedo = BGFX_INVALID_HANDLE;
+        albedoTexture = {};
         ownsTexture = false;
     }
 
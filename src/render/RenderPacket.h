@@ -0,0 +1,57 @@
+#pragma once
+
+#include <bgfx/bgfx.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "../physics/PhysicsDebugDraw.h"
+
+// Material ya resuelto para el frame: textura final (con el fallback del
+// gestor aplicado) y los ajustes globales de especular incluidos.
+struct RenderMaterial
+{
+    bgfx::TextureHandle albedo = BGFX_INVALID_HANDLE;
+    float baseTint[4]   = {1.0f, 1.0f, 1.0f, 1.0f};
+    float uvScale[4]    = {1.0f, 1.0f, 0.0f, 0.0f};
+    float specParams[4] = {32.0f, 0.35f, 0.0f, 0.0f};
+    float specColor[4]  = {1.0f, 1.0f, 1.0f, 0.0f};
+};
+
+// Un draw: submesh de un mesh con su material y la matriz mundo de la entidad.
+struct RenderDrawItem
+{
+    bgfx::VertexBufferHandle vbh = BGFX_INVALID_HANDLE;
+    bgfx::IndexBufferHandle  ibh = BGFX_INVALID_HANDLE;
+    uint32_t startIndex = 0;
+    uint32_t indexCount = 0;
+    uint32_t material = 0; // índice en RenderPacket::materials
+    float    world[16]{};
+};
+
+// Todo lo que necesita el envío de un frame, copiado del estado de la
+// simulación en Renderer::BeginFrame. Una vez publicado no se modifica ni
+// apunta a la escena ni al ResourceManager (sólo handles de bgfx), así que se
+// puede grabar en otro hilo mientras el principal simula el frame siguiente.
+struct RenderPacket
+{
+    uint64_t frame = 0;
+    float    view[16]{};
+    float    proj[16]{};
+    float    lightDir[4]{};
+    float    lightColor[4]{};
+    float    ambient[4]{};
+    float    cameraPos[4]{};
+
+    std::vector<RenderMaterial> materials;
+    std::vector<RenderDrawItem> draws;
+    PhysicsDebugLineBuffer      debugLines;
+
+    // Conserva la capacidad de los vectores entre frames.
+    void Clear()
+    {
+        materials.clear();
+        draws.clear();
+        debugLines.clear();
+    }
+};
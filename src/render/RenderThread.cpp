@@ -0,0 +1,74 @@
+#include "RenderThread.h"
+#include "RenderPacket.h"
+
+#include "../core/Profiler.h"
+
+#include <utility>
+
+RenderThread::RenderThread(SubmitFn submit)
+    : m_submit(std::move(submit))
+{
+    m_thread = std::thread(&RenderThread::ThreadLoop, this);
+}
+
+RenderThread::~RenderThread()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_doneCv.wait(lock, [this]() { return m_packet == nullptr; });
+        m_stop = true;
+    }
+    m_kickCv.notify_one();
+
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+void RenderThread::Kick(const RenderPacket& packet)
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_doneCv.wait(lock, [this]() { return m_packet == nullptr; });
+        m_packet = &packet;
+    }
+    m_kickCv.notify_one();
+}
+
+void RenderThread::Wait()
+{
+    PROFILE_SCOPE("RenderThread::Wait");
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_doneCv.wait(lock, [this]() { return m_packet == nullptr; });
+}
+
+void RenderThread::ThreadLoop()
+{
+    Profiler::SetThreadName("Render");
+
+    for (;;)
+    {
+        const RenderPacket* packet = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_kickCv.wait(lock, [this]() { return m_stop || m_packet != nullptr; });
+            if (m_stop)
+            {
+                return;
+            }
+            packet = m_packet;
+        }
+
+        {
+            PROFILE_SCOPE("RenderThread::Submit");
+            m_submit(*packet);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_packet = nullptr;
+        }
+        m_doneCv.notify_all();
+    }
+}
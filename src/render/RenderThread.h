@@ -0,0 +1,44 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+struct RenderPacket;
+
+// Hilo de envío del render: graba un RenderPacket en encoders de bgfx mientras
+// el hilo principal simula el frame siguiente. El hilo principal sigue siendo
+// el hilo de API de bgfx (init, recursos, vistas, bgfx::frame) y el backend
+// corre en el hilo de render propio de bgfx, así que hay tres etapas en
+// paralelo: simulación de N+1, grabación de N y GPU de N-1.
+class RenderThread
+{
+public:
+    // Se llama en el hilo de envío; abre y cierra sus propios encoders.
+    using SubmitFn = std::function<void(const RenderPacket& packet)>;
+
+    explicit RenderThread(SubmitFn submit);
+    ~RenderThread();
+
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    // Empieza a grabar 'packet'. Espera antes al Kick anterior; 'packet' no
+    // debe modificarse hasta que Wait vuelva.
+    void Kick(const RenderPacket& packet);
+    // Vuelve cuando el último paquete está grabado y sus encoders cerrados.
+    void Wait();
+
+private:
+    void ThreadLoop();
+
+private:
+    SubmitFn                m_submit;
+    std::thread             m_thread;
+    std::mutex              m_mutex;
+    std::condition_variable m_kickCv;
+    std::condition_variable m_doneCv;
+    const RenderPacket*     m_packet = nullptr; // no nulo mientras se graba
+    bool                    m_stop = false;
+};
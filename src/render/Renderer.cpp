@@ -1,7 +1,9 @@
 #include "Renderer.h"
+#include "RenderThread.h"
 #include <bgfx/platform.h>
 #include <bx/math.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <array>
 #include <cstring>
@@ -12,6 +14,9 @@
 #include <cmath>
 
 #include "../core/Time.h"
+#include "../core/Profiler.h"
+#include "../core/ThreadPool.h"
+#include "../core/FrameStats.h"
 #include "Material.h"
 #include "../asset/Mesh.h"
 #include "../resource/ResourceManager.h"
@@ -104,9 +109,23 @@ static std::string detectShaderBaseDx11()
     return "shaders/dx11";
 }
 
+// SANDBOXCITY_RENDER_THREAD=0: bgfx en un solo hilo y envío en línea
+static bool renderThreadRequested()
+{
+    const char* env = std::getenv("SANDBOXCITY_RENDER_THREAD");
+    return !(env && std::string(env) == "0");
+}
+
+// Por debajo de esto un encoder más cuesta más de lo que reparte
+static constexpr size_t kMinDrawsPerEncoder = 1024;
+static constexpr unsigned kDefaultSubmitThreads = 4;
+
 static bool tryInitBackend(void* nwh, uint32_t w, uint32_t h, bgfx::RendererType::Enum type)
 {
-    bgfx::renderFrame();
+    // renderFrame antes de init deja bgfx en un solo hilo; sin esa llamada
+    // bgfx::init crea su propio hilo de render para el backend.
+    if (!renderThreadRequested())
+        bgfx::renderFrame();
 
     bgfx::Init init{};
     init.type     = type;
@@ -133,6 +152,7 @@ struct PosNormColorUvVertex {
     float    u, v;
 };
 
+Renderer::Renderer() = default;
 Renderer::~Renderer() { Shutdown(); }
 
 void Renderer::Init(void* nwh, uint32_t width, uint32_t height)
@@ -156,6 +176,26 @@ void Renderer::Init(void* nwh, uint32_t width, uint32_t height)
     if (!ok) ok = tryInitBackend(nwh, m_width, m_height, bgfx::RendererType::Noop);
     if (!ok) throw std::runtime_error("bgfx::init failed on all backends.");
 
+    InitResources();
+}
+
+void Renderer::InitHeadless(uint32_t width, uint32_t height)
+{
+    if (m_initialized) return;
+
+    m_width = width;
+    m_height = height;
+    m_headless = true;
+
+    // Sin ventana: sólo el backend Noop, que no necesita GPU ni nwh.
+    if (!tryInitBackend(nullptr, m_width, m_height, bgfx::RendererType::Noop))
+        throw std::runtime_error("bgfx::init(Noop) failed.");
+
+    InitResources();
+}
+
+void Renderer::InitResources()
+{
     m_type = bgfx::getRendererType();
 
     bgfx::setViewClear(0, BGFX_CLEAR_COLOR | BGFX_CLEAR_DEPTH, 0x88AAFFFF, 1.0f, 0);
@@ -177,46 +217,50 @@ void Renderer::Init(void* nwh, uint32_t width, uint32_t height)
         .add(bgfx::Attrib::TexCoord0,2, bgfx::AttribType::Float)
     .end();
 
+    // Líneas de debug: posición + color (16 bytes), sin iluminación
     m_debugLineLayout.begin()
         .add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float)
-        .add(bgfx::Attrib::Normal,   3, bgfx::AttribType::Float)
         .add(bgfx::Attrib::Color0,   4, bgfx::AttribType::Uint8, true)
-        .add(bgfx::Attrib::TexCoord0,2, bgfx::AttribType::Float)
     .end();
 
     CreateCubeGeometry();
     CreateGroundPlane();
 
     if (!LoadProgramDx11("vs_basic", "fs_basic")) {
-        throw std::runtime_error("No se pudo cargar el programa DX11 (vs_basic/fs_basic).");
+        if (!m_headless)
+            throw std::runtime_error("No se pudo cargar el programa DX11 (vs_basic/fs_basic).");
+        // En headless se sigue sin programa: los submit con handle inválido
+        // se descartan, pero el coste de preparar cada draw se mantiene.
+        std::printf("[Renderer] Headless sin shaders: los draws se descartan.\n");
     }
 
     {
         std::string base = detectShaderBaseDx11();
         std::filesystem::path vsPath = std::filesystem::path(base) / "vs_debugline.bin";
         std::filesystem::path fsPath = std::filesystem::path(base) / "fs_debugline.bin";
-        if (!std::filesystem::exists(vsPath) || !std::filesystem::exists(fsPath))
+        const bool found = std::filesystem::exists(vsPath) && std::filesystem::exists(fsPath);
+        if (!found && !m_headless)
         {
             throw std::runtime_error("No se encontraron shaders de debug (vs_debugline/fs_debugline).");
         }
 
-        bgfx::ShaderHandle vsh = LoadShaderFile(vsPath.string().c_str());
-        bgfx::ShaderHandle fsh = LoadShaderFile(fsPath.string().c_str());
-        if (!bgfx::isValid(vsh) || !bgfx::isValid(fsh))
+        if (found)
         {
-            throw std::runtime_error("No se pudo crear shader handle para debug lines.");
-        }
+            bgfx::ShaderHandle vsh = LoadShaderFile(vsPath.string().c_str());
+            bgfx::ShaderHandle fsh = LoadShaderFile(fsPath.string().c_str());
+            if (!bgfx::isValid(vsh) || !bgfx::isValid(fsh))
+            {
+                throw std::runtime_error("No se pudo crear shader handle para debug lines.");
+            }
 
-        m_debugLineProgram = bgfx::createProgram(vsh, fsh, true);
-        if (!bgfx::isValid(m_debugLineProgram))
-        {
-            throw std::runtime_error("No se pudo crear el programa de debug lines.");
+            m_debugLineProgram = bgfx::createProgram(vsh, fsh, true);
+            if (!bgfx::isValid(m_debugLineProgram))
+            {
+                throw std::runtime_error("No se pudo crear el programa de debug lines.");
+            }
         }
     }
 
-    const uint32_t white = 0xffffffffu;
-    m_debugWhiteTexture = bgfx::createTexture2D(1, 1, false, 1, bgfx::TextureFormat::RGBA8, 0, bgfx::copy(&white, sizeof(white)));
-
     // Uniforms
     m_uTexColor   = bgfx::createUniform("s_texColor",   bgfx::UniformType::Sampler);
     m_uLightDir   = bgfx::createUniform("u_lightDir",   bgfx::UniformType::Vec4);
@@ -238,6 +282,26 @@ void Renderer::Init(void* nwh, uint32_t width, uint32_t height)
     // Estado inicial de iluminación (editable con teclas)
     ResetLightingDefaults();
 
+#if !defined(SANDBOXCITY_KEEP_LEGACY_DRAWS) || !SANDBOXCITY_KEEP_LEGACY_DRAWS
+    // Hace falta poder pedir encoders desde otro hilo
+    if (renderThreadRequested() && bgfx::getCaps()->limits.maxEncoders > 1)
+    {
+        m_renderThread = std::make_unique<RenderThread>([this](const RenderPacket& packet)
+        {
+            SubmitPacket(packet);
+        });
+    }
+#endif
+
+    unsigned submitThreads = kDefaultSubmitThreads;
+    if (const char* env = std::getenv("SANDBOXCITY_RENDER_ENCODERS"))
+    {
+        submitThreads = static_cast<unsigned>(std::max(1, std::atoi(env)));
+    }
+    SetSubmitThreadCount(submitThreads);
+
+    std::printf("[Renderer] Hilo de render: %s | Encoders: %u\n", m_renderThread ? "ON" : "OFF", m_submitThreads);
+
     m_initialized = true;
 }
 
@@ -245,9 +309,14 @@ void Renderer::Shutdown()
 {
     if (!m_initialized) return;
 
+    // El paquete en vuelo no llega a bgfx::frame; se descarta con el contexto
+    m_renderThread.reset();
+    m_submitPool.reset();
+    m_pendingPacket = nullptr;
+    m_frameOpen = false;
+
     if (bgfx::isValid(m_prog))             bgfx::destroy(m_prog);
     if (bgfx::isValid(m_debugLineProgram)) bgfx::destroy(m_debugLineProgram);
-    if (bgfx::isValid(m_debugWhiteTexture)) bgfx::destroy(m_debugWhiteTexture);
     m_cubeMesh.destroy();
     m_planeMesh.destroy();
     if (bgfx::isValid(m_uTexColor))  bgfx::destroy(m_uTexColor);
@@ -264,12 +333,12 @@ void Renderer::Shutdown()
     if (bgfx::isValid(m_uBaseTint))  bgfx::destroy(m_uBaseTint);
     if (bgfx::isValid(m_uUvScale))   bgfx::destroy(m_uUvScale);
 
-    bgfx::renderFrame();
+    if (!renderThreadRequested())
+        bgfx::renderFrame();
     bgfx::shutdown();
 
     m_prog              = BGFX_INVALID_HANDLE;
     m_debugLineProgram  = BGFX_INVALID_HANDLE;
-    m_debugWhiteTexture = BGFX_INVALID_HANDLE;
     m_uTexColor   = BGFX_INVALID_HANDLE;
     m_uLightDir   = BGFX_INVALID_HANDLE;
     m_uLightColor = BGFX_INVALID_HANDLE;
@@ -313,6 +382,11 @@ void Renderer::SetPhysicsDebugInfo(const std::string& text)
     m_physicsDebugLine = text;
 }
 
+void Renderer::SetPhysicsProfileInfo(const std::vector<std::string>& lines)
+{
+    m_physicsProfileLines = lines;
+}
+
 // Helpers
 static inline float clampf(float v, float a, float b) {
     return v < a ? a : (v > b ? b : v);
@@ -375,15 +449,18 @@ void Renderer::AdjustShininess(float delta)
 void Renderer::ApplyMaterial(const Material& m)
 {
     bgfx::TextureHandle fallback = BGFX_INVALID_HANDLE;
+    bgfx::TextureHandle albedo = m.albedo;
     if (m_resourceManager)
     {
         if (auto checker = m_resourceManager->GetCheckerTexture())
         {
             fallback = checker->handle;
         }
+        // Sigue a la textura del gestor aunque se haya recargado
+        albedo = m_resourceManager->ResolveAlbedo(m);
     }
 
-    const bgfx::TextureHandle tex = bgfx::isValid(m.albedo) ? m.albedo : fallback;
+    const bgfx::TextureHandle tex = bgfx::isValid(albedo) ? albedo : fallback;
     if (bgfx::isValid(tex))
     {
         bgfx::setTexture(0, m_uTexColor, tex);
@@ -429,136 +506,95 @@ void Renderer::SubmitMeshLit(const Mesh& mesh, const Material& material, const f
 
 void Renderer::DrawDebugLines(const PhysicsDebugLineBuffer& lines)
 {
-    if (!m_initialized || lines.empty() || !bgfx::isValid(m_debugLineProgram))
+    if (!m_frameOpen || lines.empty() || !bgfx::isValid(m_debugLineProgram))
     {
         return;
     }
 
-    const uint32_t vertexCount = static_cast<uint32_t>(lines.size() * 2);
+    PROFILE_SCOPE("Renderer::CopyDebugLines");
+    m_packets[m_buildPacket].debugLines = lines;
+}
+
+void Renderer::SubmitDebugLines(bgfx::Encoder& encoder, const PhysicsDebugLineBuffer& lines) const
+{
+    if (lines.empty() || !bgfx::isValid(m_debugLineProgram))
+    {
+        return;
+    }
 
-    bgfx::TransientVertexBuffer tvb;
-    bgfx::allocTransientVertexBuffer(&tvb, vertexCount, m_debugLineLayout);
+    PROFILE_SCOPE("Renderer::DebugLines");
 
-    struct DebugVertex
+    struct DebugLineVertex
     {
         float    x, y, z;
-        float    nx, ny, nz;
         uint32_t abgr;
-        float    u, v;
     };
+    static_assert(sizeof(DebugLineVertex) == 16, "DebugLineVertex debe ocupar 16 bytes");
 
-    DebugVertex* vertices = reinterpret_cast<DebugVertex*>(tvb.data);
-    uint32_t index = 0;
-    for (const PhysicsDebugLine& line : lines)
-    {
-        vertices[index++] = { line.from[0], line.from[1], line.from[2], 0.0f, 1.0f, 0.0f, line.abgr, 0.0f, 0.0f };
-        vertices[index++] = { line.to[0],   line.to[1],   line.to[2],   0.0f, 1.0f, 0.0f, line.abgr, 0.0f, 0.0f };
-    }
+    // Tope por draw call; el resto se reparte en más transient buffers.
+    constexpr uint32_t kMaxLinesPerChunk = 32768;
 
     float model[16];
     bx::mtxIdentity(model);
-    bgfx::setTransform(model);
-
-    float normalMtx[16];
-    bx::mtxIdentity(normalMtx);
-
-    bgfx::setUniform(m_uLightDir,   m_lightDir4);
-    const float zeroLight[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-    const float ambientWhite[4] = {1.0f, 1.0f, 1.0f, 0.0f};
-    bgfx::setUniform(m_uLightColor, zeroLight);
-    bgfx::setUniform(m_uAmbient,    ambientWhite);
-    bgfx::setUniform(m_uCameraPos,  m_camPos4);
-    bgfx::setUniform(m_uNormalMtx,  normalMtx);
 
-    Material mat{};
-    mat.specParams[0] = 1.0f;
-    mat.specParams[1] = 0.0f;
-    mat.specColor[0] = mat.specColor[1] = mat.specColor[2] = 0.0f;
-    mat.specColor[3] = 0.0f;
-    mat.uvScale[0] = mat.uvScale[1] = 0.0f;
-    mat.uvScale[2] = mat.uvScale[3] = 0.0f;
-    if (bgfx::isValid(m_debugWhiteTexture))
-    {
-        mat.albedo = m_debugWhiteTexture;
-    }
-    ApplyMaterial(mat);
-
-    bgfx::setVertexBuffer(0, &tvb);
     const uint64_t state = BGFX_STATE_WRITE_RGB
                          | BGFX_STATE_WRITE_Z
                          | BGFX_STATE_PT_LINES
                          | BGFX_STATE_DEPTH_TEST_LESS;
-    bgfx::setState(state);
-    bgfx::submit(0, m_debugLineProgram);
-}
 
-void Renderer::BeginFrame(Scene* scene)
-{
-    if (!m_initialized) return;
-
-    if (m_width == 0 || m_height == 0) { bgfx::frame(); return; }
+    size_t first = 0;
+    while (first < lines.size())
+    {
+        const uint32_t wanted = static_cast<uint32_t>(std::min<size_t>(lines.size() - first, kMaxLinesPerChunk));
+        const uint32_t available = bgfx::getAvailTransientVertexBuffer(wanted * 2, m_debugLineLayout) / 2;
+        if (available == 0)
+        {
+            static bool warned = false;
+            if (!warned)
+            {
+                std::printf("[Renderer] Transient buffer agotado: %zu de %zu lineas de debug sin dibujar\n",
+                            lines.size() - first, lines.size());
+                warned = true;
+            }
+            break;
+        }
 
-#if defined(SANDBOXCITY_KEEP_LEGACY_DRAWS) && SANDBOXCITY_KEEP_LEGACY_DRAWS
-    (void)scene;
-#endif
+        const uint32_t count = std::min(wanted, available);
+        bgfx::TransientVertexBuffer tvb;
+        bgfx::allocTransientVertexBuffer(&tvb, count * 2, m_debugLineLayout);
 
-    if (m_pendingReset) {
-        bgfx::reset(m_width, m_height, m_resetFlags);
-        bgfx::setViewRect(0, 0, 0, (uint16_t)m_width, (uint16_t)m_height);
-        m_pendingReset = false;
-    }
+        DebugLineVertex* vertices = reinterpret_cast<DebugLineVertex*>(tvb.data);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const PhysicsDebugLine& line = lines[first + i];
+            vertices[i * 2 + 0] = { line.from[0], line.from[1], line.from[2], line.abgr };
+            vertices[i * 2 + 1] = { line.to[0],   line.to[1],   line.to[2],   line.abgr };
+        }
 
-    bgfx::setViewTransform(0, m_view, m_proj);
-    bgfx::touch(0);
+        encoder.setTransform(model);
+        encoder.setVertexBuffer(0, &tvb);
+        encoder.setState(state);
+        encoder.submit(0, m_debugLineProgram);
 
-    // Dirección de luz desde yaw/pitch
-    const float cy = std::cos(m_lightYaw);
-    const float sy = std::sin(m_lightYaw);
-    const float cp = std::cos(m_lightPitch);
-    const float sp = std::sin(m_lightPitch);
-    m_lightDir4[0] = cy * cp;
-    m_lightDir4[1] = sp;
-    m_lightDir4[2] = sy * cp;
-    m_lightDir4[3] = 0.0f;
+        first += count;
+    }
+}
 
-    m_lightColor4[0] = m_lightColor3[0];
-    m_lightColor4[1] = m_lightColor3[1];
-    m_lightColor4[2] = m_lightColor3[2];
-    m_lightColor4[3] = 0.0f;
+void Renderer::GetViewProjection(float outViewProj[16]) const
+{
+    bx::mtxMul(outViewProj, m_view, m_proj);
+}
 
-    m_ambient4[0] = m_ambient;
-    m_ambient4[1] = m_ambient;
-    m_ambient4[2] = m_ambient;
-    m_ambient4[3] = 0.0f;
+void Renderer::BeginFrame(Scene* scene)
+{
+    m_frameOpen = false;
+    if (!m_initialized) return;
 
-    m_camPos4[0] = m_camX;
-    m_camPos4[1] = m_camY;
-    m_camPos4[2] = m_camZ;
-    m_camPos4[3] = 0.0f;
+    // Minimizada: EndFrame sigue llamando a bgfx::frame, sin paquete
+    if (m_width == 0 || m_height == 0) return;
 
-    // HUD
-    bgfx::dbgTextClear();
-    bgfx::dbgTextPrintf(0, 0, 0x0F, "SandboxCity");
-    bgfx::dbgTextPrintf(0, 1, 0x0A, "Renderer: %s", GetBackendName());
-    bgfx::dbgTextPrintf(0, 2, 0x0B, "FPS: %.1f", Time::FPS());
-    bgfx::dbgTextPrintf(0, 3, 0x0E, "Camera: (%.1f, %.1f, %.1f)", m_camX, m_camY, m_camZ);
-    bgfx::dbgTextPrintf(0, 4, 0x0C, "Controls: WASD/Mouse, F1=Wireframe(%s), V=VSync(%s)",
-        m_wireframe ? "ON" : "OFF", m_vsync ? "ON" : "OFF");
-    bgfx::dbgTextPrintf(0, 5, 0x0A, "Light yaw/pitch: %.1f/%.1f deg | Ambient: %.2f | SpecI: %.2f | Shiny: %.0f",
-        bx::toDeg(m_lightYaw), bx::toDeg(m_lightPitch), m_ambient, m_specIntensity, m_shininess);
-    bgfx::dbgTextPrintf(0, 6, 0x08, "Arrow keys: rotate light | Z/X ambient -/+ | C/V spec -/+ | B/N shiny -/+ | R reset");
-    if (!m_inputDebugLine.empty())
-    {
-        bgfx::dbgTextPrintf(0, 7, 0x0F, "%s", m_inputDebugLine.c_str());
-    }
-    if (!m_orbitDebugLine.empty())
-    {
-        bgfx::dbgTextPrintf(0, 8, 0x0F, "%s", m_orbitDebugLine.c_str());
-    }
-    if (!m_physicsDebugLine.empty())
-    {
-        bgfx::dbgTextPrintf(0, 9, 0x0F, "%s", m_physicsDebugLine.c_str());
-    }
+    BuildPacket(scene, m_packets[m_buildPacket]);
+    m_frameOpen = true;
 
 #if defined(SANDBOXCITY_KEEP_LEGACY_DRAWS) && SANDBOXCITY_KEEP_LEGACY_DRAWS
     if (m_type != bgfx::RendererType::Noop && bgfx::isValid(m_prog)) {
@@ -597,18 +633,63 @@ void Renderer::BeginFrame(Scene* scene)
         }
     }
 #endif
+}
 
-#if !defined(SANDBOXCITY_KEEP_LEGACY_DRAWS) || !SANDBOXCITY_KEEP_LEGACY_DRAWS
-    size_t drawCount = 0;
+void Renderer::BuildPacket(Scene* scene, RenderPacket& packet)
+{
+    PROFILE_SCOPE("Renderer::BuildPacket");
+
+    packet.Clear();
+    m_packetMaterials.clear();
+    packet.frame = m_packetFrame++;
+    std::memcpy(packet.view, m_view, sizeof(packet.view));
+    std::memcpy(packet.proj, m_proj, sizeof(packet.proj));
+
+    // Dirección de luz desde yaw/pitch
+    const float cy = std::cos(m_lightYaw);
+    const float sy = std::sin(m_lightYaw);
+    const float cp = std::cos(m_lightPitch);
+    const float sp = std::sin(m_lightPitch);
+    m_lightDir4[0] = cy * cp;
+    m_lightDir4[1] = sp;
+    m_lightDir4[2] = sy * cp;
+    m_lightDir4[3] = 0.0f;
+
+    m_lightColor4[0] = m_lightColor3[0];
+    m_lightColor4[1] = m_lightColor3[1];
+    m_lightColor4[2] = m_lightColor3[2];
+    m_lightColor4[3] = 0.0f;
+
+    m_ambient4[0] = m_ambient;
+    m_ambient4[1] = m_ambient;
+    m_ambient4[2] = m_ambient;
+    m_ambient4[3] = 0.0f;
 
-    if (scene && m_type != bgfx::RendererType::Noop && bgfx::isValid(m_prog))
+    m_camPos4[0] = m_camX;
+    m_camPos4[1] = m_camY;
+    m_camPos4[2] = m_camZ;
+    m_camPos4[3] = 0.0f;
+
+    std::memcpy(packet.lightDir,   m_lightDir4,   sizeof(packet.lightDir));
+    std::memcpy(packet.lightColor, m_lightColor4, sizeof(packet.lightColor));
+    std::memcpy(packet.ambient,    m_ambient4,    sizeof(packet.ambient));
+    std::memcpy(packet.cameraPos,  m_camPos4,     sizeof(packet.cameraPos));
+
+#if defined(SANDBOXCITY_KEEP_LEGACY_DRAWS) && SANDBOXCITY_KEEP_LEGACY_DRAWS
+    (void)scene;
+#else
+    // En headless (Noop) se envían igualmente los draws para medir su coste.
+    if (scene && m_resourceManager && (m_headless || (m_type != bgfx::RendererType::Noop && bgfx::isValid(m_prog))))
     {
-        TransformSystem::Update(*scene);
+        {
+            PROFILE_SCOPE("TransformSystem::Update");
+            TransformSystem::Update(*scene);
+        }
 
         auto& meshRenderers = scene->GetMeshRenderers();
         for (const auto& [entity, mr] : meshRenderers)
         {
-            const Mesh* mesh = mr.mesh ? mr.mesh.get() : nullptr;
+            const Mesh* mesh = m_resourceManager->GetMesh(mr.mesh);
             if (!mesh || !mesh->valid())
             {
                 continue;
@@ -630,38 +711,23 @@ void Renderer::BeginFrame(Scene* scene)
                 }
             }
 
-            float invWorld[16];
-            float normalMtx[16];
-            bx::mtxInverse(invWorld, transform->world);
-            bx::mtxTranspose(normalMtx, invWorld);
-            std::shared_ptr<Material> fallback = m_resourceManager ? m_resourceManager->GetDefaultMaterial() : nullptr;
-            const Material* overrideMat = mr.material ? mr.material.get() : nullptr;
+            const Material* fallback = m_resourceManager->GetMaterial(m_resourceManager->GetDefaultMaterialHandle());
+            const Material* overrideMat = m_resourceManager->GetMaterial(mr.material);
 
-            const auto submitDraw = [&](const Material* material, uint32_t startIndex, uint32_t indexCount) -> bool
+            const auto addDraw = [&](const Material* material, uint32_t startIndex, uint32_t indexCount)
             {
                 if (!material || indexCount == 0)
                 {
-                    return false;
+                    return;
                 }
 
-                bgfx::setTransform(transform->world);
-                bgfx::setVertexBuffer(0, mesh->vbh);
-                bgfx::setIndexBuffer(mesh->ibh, startIndex, indexCount);
-
-                bgfx::setUniform(m_uLightDir,   m_lightDir4);
-                bgfx::setUniform(m_uLightColor, m_lightColor4);
-                bgfx::setUniform(m_uAmbient,    m_ambient4);
-                bgfx::setUniform(m_uCameraPos,  m_camPos4);
-                bgfx::setUniform(m_uNormalMtx,  normalMtx);
-
-                Material temp = *material;
-                temp.specParams[0] = m_shininess;
-                temp.specParams[1] = m_specIntensity;
-                ApplyMaterial(temp);
-
-                bgfx::setState(m_defaultState);
-                bgfx::submit(0, m_prog);
-                return true;
+                RenderDrawItem& item = packet.draws.emplace_back();
+                item.vbh = mesh->vbh;
+                item.ibh = mesh->ibh;
+                item.startIndex = startIndex;
+                item.indexCount = indexCount;
+                item.material = ResolveMaterial(*material, packet);
+                std::memcpy(item.world, transform->world, sizeof(item.world));
             };
 
             const auto& submeshes = mesh->submeshes;
@@ -669,9 +735,9 @@ void Renderer::BeginFrame(Scene* scene)
             {
                 const Material* material = nullptr;
                 auto overrideIt = mr.materialOverrides.find(submeshIndex);
-                if (overrideIt != mr.materialOverrides.end() && overrideIt->second)
+                if (overrideIt != mr.materialOverrides.end())
                 {
-                    material = overrideIt->second.get();
+                    material = m_resourceManager->GetMaterial(overrideIt->second);
                 }
 
                 if (!material)
@@ -688,9 +754,9 @@ void Renderer::BeginFrame(Scene* scene)
                     }
                 }
 
-                if (!material && fallback)
+                if (!material)
                 {
-                    material = fallback.get();
+                    material = fallback;
                 }
 
                 return material;
@@ -698,41 +764,268 @@ void Renderer::BeginFrame(Scene* scene)
 
             if (submeshes.empty())
             {
-                const Material* material = pickMaterial(0, mesh->materials.empty() ? -1 : 0);
-                if (submitDraw(material, 0, mesh->indexCount))
-                {
-                    ++drawCount;
-                }
+                addDraw(pickMaterial(0, mesh->materials.empty() ? -1 : 0), 0, mesh->indexCount);
                 continue;
             }
 
             uint32_t submeshIndex = 0;
             for (const Submesh& submesh : submeshes)
             {
-                const Material* material = pickMaterial(submeshIndex, submesh.materialIndex);
-                if (submitDraw(material, submesh.startIndex, submesh.indexCount))
-                {
-                    ++drawCount;
-                }
+                addDraw(pickMaterial(submeshIndex, submesh.materialIndex), submesh.startIndex, submesh.indexCount);
                 ++submeshIndex;
             }
         }
     }
 
-    if (drawCount > 0)
-    {
-        //::printf("[Renderer] ECS render: %zu draws\n", drawCount);
-    }
-    else
+    if (packet.draws.empty())
     {
         std::printf("[Renderer] Scene empty (no draws)\n");
     }
 #endif
 }
 
+uint32_t Renderer::ResolveMaterial(const Material& material, RenderPacket& packet)
+{
+    const auto [it, inserted] = m_packetMaterials.try_emplace(&material, static_cast<uint32_t>(packet.materials.size()));
+    if (!inserted)
+    {
+        return it->second;
+    }
+
+    // Lo mismo que ApplyMaterial, resuelto aquí porque el ResourceManager
+    // sólo se consulta desde el hilo principal
+    bgfx::TextureHandle fallback = BGFX_INVALID_HANDLE;
+    bgfx::TextureHandle albedo = material.albedo;
+    if (m_resourceManager)
+    {
+        if (auto checker = m_resourceManager->GetCheckerTexture())
+        {
+            fallback = checker->handle;
+        }
+        albedo = m_resourceManager->ResolveAlbedo(material);
+    }
+
+    RenderMaterial& resolved = packet.materials.emplace_back();
+    resolved.albedo = bgfx::isValid(albedo) ? albedo : fallback;
+    std::memcpy(resolved.baseTint,   material.baseTint,   sizeof(resolved.baseTint));
+    std::memcpy(resolved.uvScale,    material.uvScale,    sizeof(resolved.uvScale));
+    std::memcpy(resolved.specParams, material.specParams, sizeof(resolved.specParams));
+    std::memcpy(resolved.specColor,  material.specColor,  sizeof(resolved.specColor));
+    resolved.specParams[0] = m_shininess;
+    resolved.specParams[1] = m_specIntensity;
+    return it->second;
+}
+
+void Renderer::ApplyFrameState(const RenderPacket& packet)
+{
+    if (m_pendingReset) {
+        bgfx::reset(m_width, m_height, m_resetFlags);
+        bgfx::setViewRect(0, 0, 0, (uint16_t)m_width, (uint16_t)m_height);
+        m_pendingReset = false;
+    }
+
+    bgfx::setViewTransform(0, packet.view, packet.proj);
+    bgfx::touch(0);
+
+    // HUD
+    bgfx::dbgTextClear();
+    bgfx::dbgTextPrintf(0, 0, 0x0F, "SandboxCity");
+    bgfx::dbgTextPrintf(0, 1, 0x0A, "Renderer: %s%s", GetBackendName(), m_renderThread ? " (hilo de render)" : "");
+    const FrameTimeSummary frame = FrameStats::GetFrameSummary();
+    bgfx::dbgTextPrintf(0, 2, 0x0B, "FPS: %.1f | Frame avg/p50/p95/p99/max: %.2f/%.2f/%.2f/%.2f/%.2f ms | Hitches: %u",
+        FrameStats::GetAverageFps(), frame.avgMs, frame.p50Ms, frame.p95Ms, frame.p99Ms, frame.maxMs,
+        FrameStats::GetHitchCount());
+    bgfx::dbgTextPrintf(0, 3, 0x0E, "Camera: (%.1f, %.1f, %.1f) | Draws: %zu | Descartados: %zu (total %llu)",
+        packet.cameraPos[0], packet.cameraPos[1], packet.cameraPos[2], packet.draws.size(),
+        m_lastDroppedDraws, static_cast<unsigned long long>(m_totalDroppedDraws));
+    bgfx::dbgTextPrintf(0, 4, 0x0C, "Controls: WASD/Mouse, F1=Wireframe(%s), V=VSync(%s)",
+        m_wireframe ? "ON" : "OFF", m_vsync ? "ON" : "OFF");
+    bgfx::dbgTextPrintf(0, 5, 0x0A, "Light yaw/pitch: %.1f/%.1f deg | Ambient: %.2f | SpecI: %.2f | Shiny: %.0f",
+        bx::toDeg(m_lightYaw), bx::toDeg(m_lightPitch), m_ambient, m_specIntensity, m_shininess);
+    bgfx::dbgTextPrintf(0, 6, 0x08, "Arrow keys: rotate light | Z/X ambient -/+ | C/V spec -/+ | B/N shiny -/+ | R reset");
+    if (!m_inputDebugLine.empty())
+    {
+        bgfx::dbgTextPrintf(0, 7, 0x0F, "%s", m_inputDebugLine.c_str());
+    }
+    if (!m_orbitDebugLine.empty())
+    {
+        bgfx::dbgTextPrintf(0, 8, 0x0F, "%s", m_orbitDebugLine.c_str());
+    }
+    if (!m_physicsDebugLine.empty())
+    {
+        bgfx::dbgTextPrintf(0, 9, 0x0F, "%s", m_physicsDebugLine.c_str());
+    }
+    {
+        const FrameTimeSummary input   = FrameStats::GetStageSummary(FrameStage::Input);
+        const FrameTimeSummary update  = FrameStats::GetStageSummary(FrameStage::Update);
+        const FrameTimeSummary render  = FrameStats::GetStageSummary(FrameStage::Render);
+        const FrameTimeSummary present = FrameStats::GetStageSummary(FrameStage::Present);
+        bgfx::dbgTextPrintf(0, 10, 0x0B, "Stages avg/p95 ms: input %.2f/%.2f | update %.2f/%.2f | render %.2f/%.2f | present %.2f/%.2f",
+            input.avgMs, input.p95Ms, update.avgMs, update.p95Ms,
+            render.avgMs, render.p95Ms, present.avgMs, present.p95Ms);
+    }
+    for (size_t i = 0; i < m_physicsProfileLines.size(); ++i)
+    {
+        bgfx::dbgTextPrintf(0, static_cast<uint16_t>(11 + i), 0x07, "%s", m_physicsProfileLines[i].c_str());
+    }
+}
+
+void Renderer::SubmitPacket(const RenderPacket& packet) const
+{
+    m_packetDroppedDraws.store(0, std::memory_order_relaxed);
+    const size_t drawCount = packet.draws.size();
+    const size_t chunks = std::clamp<size_t>(drawCount / kMinDrawsPerEncoder, 1, m_submitThreads);
+    if (chunks > 1 && m_submitPool)
+    {
+        // Un trozo contiguo por encoder; el hilo que envía también graba uno
+        const int grain = static_cast<int>((drawCount + chunks - 1) / chunks);
+        m_submitPool->ParallelFor(0, static_cast<int>(drawCount), grain, [this, &packet](int begin, int end)
+        {
+            SubmitDraws(packet, static_cast<size_t>(begin), static_cast<size_t>(end));
+        }, static_cast<unsigned>(chunks));
+    }
+    else if (drawCount > 0)
+    {
+        SubmitDraws(packet, 0, drawCount);
+    }
+
+    if (!packet.debugLines.empty())
+    {
+        if (bgfx::Encoder* encoder = bgfx::begin(true))
+        {
+            SubmitDebugLines(*encoder, packet.debugLines);
+            bgfx::end(encoder);
+        }
+    }
+
+    // Se avisa al empezar y al acabar cada racha de frames con draws
+    // descartados, no en cada frame; el recuento sale en el HUD.
+    m_lastDroppedDraws = m_packetDroppedDraws.load(std::memory_order_relaxed);
+    m_totalDroppedDraws += m_lastDroppedDraws;
+    if (m_lastDroppedDraws > 0 && !m_droppingDraws)
+    {
+        std::printf("[Renderer] Sin encoder libre: %zu draws del frame %llu sin dibujar\n",
+                    m_lastDroppedDraws, static_cast<unsigned long long>(packet.frame));
+    }
+    else if (m_lastDroppedDraws == 0 && m_droppingDraws)
+    {
+        std::printf("[Renderer] Encoders disponibles de nuevo en el frame %llu\n",
+                    static_cast<unsigned long long>(packet.frame));
+    }
+    m_droppingDraws = m_lastDroppedDraws > 0;
+}
+
+void Renderer::SubmitDraws(const RenderPacket& packet, size_t begin, size_t end) const
+{
+    // Encoder propio aunque se llame desde el hilo de API: así cualquier hilo
+    // puede grabar cualquier trozo
+    bgfx::Encoder* encoder = bgfx::begin(true);
+    if (!encoder)
+    {
+        m_packetDroppedDraws.fetch_add(end - begin, std::memory_order_relaxed);
+        return;
+    }
+
+    PROFILE_SCOPE("Renderer::SubmitDraws");
+    for (size_t i = begin; i < end; ++i)
+    {
+        const RenderDrawItem& item = packet.draws[i];
+
+        float invWorld[16];
+        float normalMtx[16];
+        bx::mtxInverse(invWorld, item.world);
+        bx::mtxTranspose(normalMtx, invWorld);
+
+        encoder->setTransform(item.world);
+        encoder->setVertexBuffer(0, item.vbh);
+        encoder->setIndexBuffer(item.ibh, item.startIndex, item.indexCount);
+
+        encoder->setUniform(m_uLightDir,   packet.lightDir);
+        encoder->setUniform(m_uLightColor, packet.lightColor);
+        encoder->setUniform(m_uAmbient,    packet.ambient);
+        encoder->setUniform(m_uCameraPos,  packet.cameraPos);
+        encoder->setUniform(m_uNormalMtx,  normalMtx);
+
+        const RenderMaterial& material = packet.materials[item.material];
+        if (bgfx::isValid(material.albedo))
+        {
+            encoder->setTexture(0, m_uTexColor, material.albedo);
+        }
+        encoder->setUniform(m_uBaseTint,   material.baseTint);
+        encoder->setUniform(m_uUvScale,    material.uvScale);
+        encoder->setUniform(m_uSpecParams, material.specParams);
+        encoder->setUniform(m_uSpecColor,  material.specColor);
+
+        encoder->setState(m_defaultState);
+        // La profundidad de ordenación es el índice en el paquete: bgfx
+        // desempata por orden de llegada, que con varios encoders varía
+        encoder->submit(0, m_prog, static_cast<uint32_t>(i));
+    }
+    bgfx::end(encoder);
+}
+
+void Renderer::SetSubmitThreadCount(unsigned count)
+{
+    // bgfx reserva un encoder para el hilo de API
+    const unsigned maxEncoders = bgfx::getCaps()->limits.maxEncoders;
+    count = std::clamp(count, 1u, std::max(1u, maxEncoders - 1u));
+    if (count == m_submitThreads)
+    {
+        return;
+    }
+
+    WaitForSubmission();
+    m_submitThreads = count;
+    m_submitPool = count > 1 ? std::make_unique<ThreadPool>(count - 1) : nullptr;
+}
+
 void Renderer::EndFrame()
 {
-    if (m_initialized) bgfx::frame();
+    if (!m_initialized) return;
+
+    const RenderPacket* current = m_frameOpen ? &m_packets[m_buildPacket] : nullptr;
+    m_frameOpen = false;
+
+    if (!m_renderThread)
+    {
+        if (current)
+        {
+            ApplyFrameState(*current);
+            SubmitPacket(*current);
+        }
+        PROFILE_SCOPE("bgfx::frame");
+        bgfx::frame();
+        return;
+    }
+
+    // Cierra el frame anterior: sus draws ya están en un encoder cerrado y
+    // el estado de vista es el suyo
+    m_renderThread->Wait();
+    if (m_pendingPacket)
+    {
+        ApplyFrameState(*m_pendingPacket);
+    }
+    {
+        PROFILE_SCOPE("bgfx::frame");
+        bgfx::frame();
+    }
+    m_pendingPacket = nullptr;
+
+    // Este paquete se graba mientras el hilo principal simula el siguiente
+    if (current)
+    {
+        m_renderThread->Kick(*current);
+        m_pendingPacket = current;
+        m_buildPacket ^= 1;
+    }
+}
+
+void Renderer::WaitForSubmission()
+{
+    if (m_renderThread)
+    {
+        m_renderThread->Wait();
+    }
 }
 
 void Renderer::SetView(const float view[16]) { std::memcpy(m_view, view, sizeof(m_view)); }
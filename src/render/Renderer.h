@@ -1,42 +1,77 @@
 #pragma once
 #include <bgfx/bgfx.h>
+#include <array>
+#include <atomic>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include "../asset/Mesh.h"
 #include "../physics/PhysicsDebugDraw.h"
 #include "Material.h"
+#include "RenderPacket.h"
 
 class Scene;
+class RenderThread;
+class ThreadPool;
 namespace resource { class ResourceManager; }
 
 class Renderer
 {
 public:
-    Renderer() = default;
+    Renderer();
     ~Renderer();
 
     Renderer(const Renderer&) = delete;
     Renderer& operator=(const Renderer&) = delete;
 
     void Init(void* nwh, uint32_t width, uint32_t height);
+    // Sin ventana y con bgfx::RendererType::Noop; los shaders son opcionales.
+    void InitHeadless(uint32_t width, uint32_t height);
+    bool IsHeadless() const { return m_headless; }
     void Shutdown();
 
     void OnResize(uint32_t width, uint32_t height);
 
+    // BeginFrame copia la escena en el RenderPacket del frame; EndFrame lo
+    // envía. Con hilo de render, EndFrame cierra el frame anterior (espera a
+    // que esté grabado y llama a bgfx::frame) y publica el actual, que se
+    // graba mientras se simula el siguiente: la imagen va un frame por detrás.
+    // SANDBOXCITY_RENDER_THREAD=0 desactiva el hilo (y el multihilo de bgfx).
     void BeginFrame(Scene* scene = nullptr);
     void EndFrame();
+    bool IsRenderThreaded() const { return m_renderThread != nullptr; }
+    // Espera a que el hilo de render suelte el paquete en curso. Llamar antes
+    // de destruir recursos de bgfx que un paquete pueda usar.
+    void WaitForSubmission();
+
+    // Graba el paquete sin llamar a bgfx::frame, repartiendo los draws en
+    // trozos contiguos, cada uno en su propio bgfx::Encoder. El orden final no
+    // depende del reparto. Lo usa EndFrame; público para los benchmarks.
+    void SubmitPacket(const RenderPacket& packet) const;
+    // Encoders en paralelo (incluido el hilo que envía); se limita al máximo
+    // de bgfx. Llamar tras Init; SANDBOXCITY_RENDER_ENCODERS fija el valor inicial.
+    void SetSubmitThreadCount(unsigned count);
+    unsigned GetSubmitThreadCount() const { return m_submitThreads; }
+    // Draws descartados por falta de encoder libre: en el último paquete
+    // grabado y desde el arranque.
+    size_t   GetLastDroppedDraws() const { return m_lastDroppedDraws; }
+    uint64_t GetTotalDroppedDraws() const { return m_totalDroppedDraws; }
 
     void SetView(const float view[16]);
     void SetProjection(float fovYDeg, float aspect, float znear, float zfar);
+    void GetViewProjection(float outViewProj[16]) const;
 
     void SetCameraDebugInfo(float x, float y, float z);
     void SetInputDebugInfo(const std::string& text);
     void SetCameraOrbitDebugInfo(const std::string& text);
     void SetPhysicsDebugInfo(const std::string& text);
+    void SetPhysicsProfileInfo(const std::vector<std::string>& lines);
 
     const char* GetBackendName() const;
 
     void SetResourceManager(resource::ResourceManager* manager);
+    resource::ResourceManager* GetResourceManager() const { return m_resourceManager; }
 
     // Debug toggles
     void ToggleWireframe();
@@ -55,9 +90,21 @@ public:
     float GetSpecIntensity() const { return m_specIntensity; }
 
     void SubmitMeshLit(const Mesh& mesh, const Material& material, const float model[16]);
+    // Se copian al paquete del frame; llamar entre BeginFrame y EndFrame.
     void DrawDebugLines(const PhysicsDebugLineBuffer& lines);
 
 private:
+    void InitResources();
+
+    // Paquete del frame: se rellena en el hilo principal y se envía con
+    // SubmitPacket, en el hilo de render o en línea.
+    void BuildPacket(Scene* scene, RenderPacket& packet);
+    uint32_t ResolveMaterial(const Material& material, RenderPacket& packet);
+    // Estado por vista y HUD; sólo desde el hilo de API de bgfx, antes de bgfx::frame.
+    void ApplyFrameState(const RenderPacket& packet);
+    void SubmitDraws(const RenderPacket& packet, size_t begin, size_t end) const;
+    void SubmitDebugLines(bgfx::Encoder& encoder, const PhysicsDebugLineBuffer& lines) const;
+
     // Shaders / programas
     bgfx::ShaderHandle LoadShaderFile(const char* path);
     bool LoadProgramDx11(const char* vsName, const char* fsName);
@@ -79,6 +126,8 @@ private:
     bool        m_initialized = false;
     bool        m_wireframe   = false;
     bool        m_vsync       = true;
+    bool        m_headless    = false;
+    bool        m_frameOpen   = false; // BeginFrame ha rellenado el paquete actual
 
     bgfx::RendererType::Enum m_type = bgfx::RendererType::Count;
 
@@ -88,13 +137,13 @@ private:
     std::string m_inputDebugLine;
     std::string m_orbitDebugLine;
     std::string m_physicsDebugLine;
+    std::vector<std::string> m_physicsProfileLines;
 
     // Layout/Program
     bgfx::VertexLayout m_layout{};
     bgfx::ProgramHandle m_prog = BGFX_INVALID_HANDLE;
     bgfx::VertexLayout m_debugLineLayout{};
     bgfx::ProgramHandle m_debugLineProgram = BGFX_INVALID_HANDLE;
-    bgfx::TextureHandle m_debugWhiteTexture = BGFX_INVALID_HANDLE;
 
     // Recursos: cubo
     Mesh m_cubeMesh;
@@ -131,4 +180,20 @@ private:
                             | BGFX_STATE_DEPTH_TEST_LESS;
 
     resource::ResourceManager* m_resourceManager = nullptr;
+
+    // Doble buffer: uno se rellena mientras el hilo de render graba el otro
+    std::array<RenderPacket, 2>   m_packets;
+    uint32_t                      m_buildPacket = 0;
+    const RenderPacket*           m_pendingPacket = nullptr; // grabado o en grabación, sin bgfx::frame
+    uint64_t                      m_packetFrame = 0;
+    std::unordered_map<const Material*, uint32_t> m_packetMaterials; // material -> índice en el paquete
+    std::unique_ptr<RenderThread> m_renderThread;
+    // Workers para los encoders 2..N; nulo con un solo encoder
+    std::unique_ptr<ThreadPool>   m_submitPool;
+    unsigned                      m_submitThreads = 1;
+    // SubmitPacket es const y graba desde varios hilos
+    mutable std::atomic<size_t>   m_packetDroppedDraws{0};
+    mutable size_t                m_lastDroppedDraws = 0;
+    mutable uint64_t              m_totalDroppedDraws = 0;
+    mutable bool                  m_droppingDraws = false; // para avisar una vez por racha
 };
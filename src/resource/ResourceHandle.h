@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace resource
+{
+// Handle con generación a un recurso del ResourceManager. Recargar un asset
+// sustituye el objeto del slot sin cambiar el handle, así que todos los que lo
+// guardan ven la versión nueva. Al liberar el slot sube la generación y los
+// handles antiguos dejan de resolver (devuelven nullptr) en lugar de apuntar
+// a otro recurso.
+template<typename Tag>
+struct ResourceHandle
+{
+    static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+    uint32_t index = kInvalidIndex;
+    uint32_t generation = 0;
+
+    bool IsValid() const { return index != kInvalidIndex; }
+    friend bool operator==(const ResourceHandle&, const ResourceHandle&) = default;
+};
+
+struct MeshHandleTag;
+struct MaterialHandleTag;
+struct TextureHandleTag;
+
+using MeshHandle     = ResourceHandle<MeshHandleTag>;
+using MaterialHandle = ResourceHandle<MaterialHandleTag>;
+using TextureHandle  = ResourceHandle<TextureHandleTag>;
+
+// Slots de objetos compartidos con lista libre. Resolver es un acceso a vector
+// más una comparación de generación.
+template<typename T, typename Handle>
+class HandlePool
+{
+public:
+    Handle Add(std::shared_ptr<T> object)
+    {
+        uint32_t index = 0;
+        if (!m_free.empty())
+        {
+            index = m_free.back();
+            m_free.pop_back();
+        }
+        else
+        {
+            index = static_cast<uint32_t>(m_slots.size());
+            m_slots.emplace_back();
+        }
+        m_slots[index].object = std::move(object);
+        m_slots[index].used = true;
+        return Handle{index, m_slots[index].generation};
+    }
+
+    // Cambia el objeto de un handle vivo; el handle sigue siendo el mismo.
+    bool Replace(Handle handle, std::shared_ptr<T> object)
+    {
+        if (!IsAlive(handle))
+        {
+            return false;
+        }
+        m_slots[handle.index].object = std::move(object);
+        return true;
+    }
+
+    void Remove(Handle handle)
+    {
+        if (!IsAlive(handle))
+        {
+            return;
+        }
+        Slot& slot = m_slots[handle.index];
+        slot.object.reset();
+        slot.used = false;
+        ++slot.generation;
+        m_free.push_back(handle.index);
+    }
+
+    // Libera todos los slots; los handles existentes quedan caducados.
+    void Clear()
+    {
+        m_free.clear();
+        for (uint32_t i = 0; i < m_slots.size(); ++i)
+        {
+            if (m_slots[i].used)
+            {
+                m_slots[i].object.reset();
+                m_slots[i].used = false;
+                ++m_slots[i].generation;
+            }
+            m_free.push_back(i);
+        }
+    }
+
+    bool IsAlive(Handle handle) const
+    {
+        return handle.index < m_slots.size() && m_slots[handle.index].used && m_slots[handle.index].generation == handle.generation;
+    }
+
+    T* Get(Handle handle) const
+    {
+        return IsAlive(handle) ? m_slots[handle.index].object.get() : nullptr;
+    }
+
+    const std::shared_ptr<T>& GetShared(Handle handle) const
+    {
+        static const std::shared_ptr<T> s_null;
+        return IsAlive(handle) ? m_slots[handle.index].object : s_null;
+    }
+
+    template<typename Fn>
+    void ForEach(Fn&& fn) const
+    {
+        for (const Slot& slot : m_slots)
+        {
+            if (slot.used && slot.object)
+            {
+                fn(*slot.object);
+            }
+        }
+    }
+
+    size_t GetAliveCount() const { return m_slots.size() - m_free.size(); }
+
+private:
+    struct Slot
+    {
+        std::shared_ptr<T> object;
+        uint32_t           generation = 1; // 0 sólo en handles por defecto
+        bool               used = false;
+    };
+
+    std::vector<Slot>     m_slots;
+    std::vector<uint32_t> m_free;
+};
+}
@@ -164,18 +164,22 @@ void ResourceManager::Shutdown()
     m_meshCache.clear();
     m_materialCache.clear();
     m_textureCache.clear();
-    m_defaultMaterial.reset();
+    m_meshes.Clear();
+    m_materials.Clear();
+    m_textures.Clear();
+    m_defaultMaterial = MaterialHandle{};
+    m_checkerHandle = TextureHandle{};
     m_checkerTexture.reset();
     m_initialized = false;
 }
 
-std::shared_ptr<TextureResource> ResourceManager::LoadTexture(const std::string& relativePath)
+TextureHandle ResourceManager::LoadTexture(const std::string& relativePath)
 {
     EnsureDefaultResources();
     const std::string normalized = NormalizePath(relativePath);
     if (normalized.empty())
     {
-        return m_checkerTexture;
+        return m_checkerHandle;
     }
 
     auto it = m_textureCache.find(normalized);
@@ -190,30 +194,29 @@ std::shared_ptr<TextureResource> ResourceManager::LoadTexture(const std::string&
     {
         std::printf("[TEX] No existe: %s\n", absolute.c_str());
         LogCacheMiss(CacheType::Texture, normalized);
-        if (m_checkerTexture)
-        {
-            m_textureCache[normalized] = m_checkerTexture;
-        }
-        return m_checkerTexture;
+        // Slot propio con el checker: si el fichero aparece, Reload lo sustituye
+        const TextureHandle handle = m_textures.Add(m_checkerTexture);
+        m_textureCache[normalized] = handle;
+        return handle;
     }
 
     return LoadTextureInternal(normalized, absolute);
 }
 
-std::shared_ptr<Material> ResourceManager::LoadMaterial(const std::string& relativePath)
+MaterialHandle ResourceManager::LoadMaterial(const std::string& relativePath)
 {
     EnsureDefaultResources();
     const std::string normalized = NormalizePath(relativePath);
     if (normalized.empty())
     {
-        return GetDefaultMaterial();
+        return m_defaultMaterial;
     }
 
     auto it = m_materialCache.find(normalized);
     if (it != m_materialCache.end())
     {
         LogCacheHit(CacheType::Material, normalized);
-        return it->second->material;
+        return it->second;
     }
 
     const std::string absolute = BuildAbsolutePath(normalized);
@@ -221,20 +224,35 @@ std::shared_ptr<Material> ResourceManager::LoadMaterial(const std::string& relat
     {
         std::printf("[MTL] No existe: %s\n", absolute.c_str());
         LogCacheMiss(CacheType::Material, normalized);
-        return GetDefaultMaterial();
+        return m_defaultMaterial;
+    }
+
+    auto entry = ReadMaterialFile(normalized, absolute);
+    if (!entry)
+    {
+        LogCacheMiss(CacheType::Material, normalized);
+        return m_defaultMaterial;
     }
 
+    const MaterialHandle handle = m_materials.Add(entry);
+    m_materialCache[normalized] = handle;
+    LogCacheMiss(CacheType::Material, normalized);
+    return handle;
+}
+
+std::shared_ptr<MaterialEntry> ResourceManager::ReadMaterialFile(const std::string& normalized, const std::string& absolute)
+{
     std::ifstream file(absolute);
     if (!file)
     {
         std::printf("[MTL] No se pudo abrir: %s\n", absolute.c_str());
-        LogCacheMiss(CacheType::Material, normalized);
-        return GetDefaultMaterial();
+        return nullptr;
     }
 
     Material materialData;
     materialData.reset();
     materialData.albedo = m_checkerTexture ? m_checkerTexture->handle : bgfx::TextureHandle{bgfx::kInvalidHandle};
+    materialData.albedoTexture = m_checkerHandle;
     materialData.ownsTexture = false;
 
     std::string mapKd;
@@ -258,43 +276,49 @@ std::shared_ptr<Material> ResourceManager::LoadMaterial(const std::string& relat
         }
     }
 
-    std::shared_ptr<TextureResource> textureRef = m_checkerTexture;
     if (!mapKd.empty())
     {
         std::filesystem::path texAbs = std::filesystem::path(absolute).parent_path() / mapKd;
         std::error_code ec;
         std::filesystem::path texRel = std::filesystem::relative(texAbs, m_assetsRoot, ec);
         std::string normalizedTex = NormalizePath(ec ? texAbs.string() : texRel.generic_string());
-        textureRef = LoadTextureInternal(normalizedTex, texAbs.lexically_normal().string());
-        if (textureRef)
-        {
-            materialData.albedo = textureRef->handle;
-        }
-        else
-        {
-            textureRef = m_checkerTexture;
-            materialData.albedo = m_checkerTexture ? m_checkerTexture->handle : bgfx::TextureHandle{bgfx::kInvalidHandle};
-        }
+        const TextureHandle texture = LoadTextureInternal(normalizedTex, texAbs.lexically_normal().string());
+        materialData.albedoTexture = texture;
+        materialData.albedo = ResolveAlbedo(materialData);
     }
 
-    auto matPtr = CreateMaterialFromData(materialData, normalized);
     auto entry = std::make_shared<MaterialEntry>();
-    entry->material = matPtr;
-    entry->albedoTexture = textureRef;
+    entry->material = CreateMaterialFromData(materialData, normalized);
     entry->approxBytes = sizeof(Material);
     entry->source = normalized;
-    m_materialCache[normalized] = entry;
-    LogCacheMiss(CacheType::Material, normalized);
-    return entry->material;
+    return entry;
 }
 
-std::shared_ptr<MeshEntry> ResourceManager::LoadMesh(const std::string& relativePath)
+MaterialHandle ResourceManager::CreateMaterial(const std::string& key, const Material& data)
+{
+    EnsureDefaultResources();
+    auto entry = std::make_shared<MaterialEntry>();
+    entry->material = CreateMaterialFromData(data, key);
+    entry->approxBytes = sizeof(Material);
+    entry->source = key;
+
+    auto it = m_materialCache.find(key);
+    if (it != m_materialCache.end() && m_materials.Replace(it->second, entry))
+    {
+        return it->second;
+    }
+    const MaterialHandle handle = m_materials.Add(entry);
+    m_materialCache[key] = handle;
+    return handle;
+}
+
+MeshHandle ResourceManager::LoadMesh(const std::string& relativePath)
 {
     EnsureDefaultResources();
     const std::string normalized = NormalizePath(relativePath);
     if (normalized.empty())
     {
-        return nullptr;
+        return MeshHandle{};
     }
 
     auto it = m_meshCache.find(normalized);
@@ -309,18 +333,44 @@ std::shared_ptr<MeshEntry> ResourceManager::LoadMesh(const std::string& relative
     {
         std::printf("[MESH] No existe: %s\n", absolute.c_str());
         LogCacheMiss(CacheType::Mesh, normalized);
-        return nullptr;
+        return MeshHandle{};
     }
 
+    auto entry = ReadMesh(normalized, absolute);
+    LogCacheMiss(CacheType::Mesh, normalized);
+    if (!entry)
+    {
+        return MeshHandle{};
+    }
+
+    const MeshHandle handle = m_meshes.Add(entry);
+    m_meshCache[normalized] = handle;
+    return handle;
+}
+
+std::shared_ptr<MeshEntry> ResourceManager::ReadMesh(const std::string& normalized, const std::string& absolute)
+{
     MeshLoadResult result;
     const bgfx::TextureHandle fallback = m_checkerTexture ? m_checkerTexture->handle : bgfx::TextureHandle{bgfx::kInvalidHandle};
-    auto textureLoader = [this](const std::string& absPath) -> bgfx::TextureHandle {
+    // El cargador de OBJ sólo conoce handles de bgfx; se anota de qué textura
+    // del gestor sale cada uno para que los materiales sigan sus recargas.
+    std::unordered_map<uint16_t, TextureHandle> textureByBgfx;
+    auto textureLoader = [this, &textureByBgfx](const std::string& absPath) -> bgfx::TextureHandle {
         std::filesystem::path abs(absPath);
         std::error_code ec;
         std::filesystem::path rel = std::filesystem::relative(abs, m_assetsRoot, ec);
         std::string normalizedRel = NormalizePath(ec ? abs.generic_string() : rel.generic_string());
-        auto tex = LoadTextureInternal(normalizedRel, abs.lexically_normal().string());
-        return tex ? tex->handle : (m_checkerTexture ? m_checkerTexture->handle : bgfx::TextureHandle{bgfx::kInvalidHandle});
+        const TextureHandle handle = LoadTextureInternal(normalizedRel, abs.lexically_normal().string());
+        const TextureResource* tex = m_textures.Get(handle);
+        if (!tex || !bgfx::isValid(tex->handle))
+        {
+            return m_checkerTexture ? m_checkerTexture->handle : bgfx::TextureHandle{bgfx::kInvalidHandle};
+        }
+        if (tex != m_checkerTexture.get())
+        {
+            textureByBgfx[tex->handle.idx] = handle;
+        }
+        return tex->handle;
     };
 
     std::string log;
@@ -330,7 +380,6 @@ std::shared_ptr<MeshEntry> ResourceManager::LoadMesh(const std::string& relative
         {
             std::printf("[MESH] %s\n", log.c_str());
         }
-        LogCacheMiss(CacheType::Mesh, normalized);
         return nullptr;
     }
 
@@ -344,59 +393,62 @@ std::shared_ptr<MeshEntry> ResourceManager::LoadMesh(const std::string& relative
     entry->materials.reserve(result.materials.size());
     for (const Material& mtl : result.materials)
     {
-        entry->materials.push_back(CreateMaterialFromData(mtl, normalized));
+        auto material = CreateMaterialFromData(mtl, normalized);
+        if (auto texIt = textureByBgfx.find(mtl.albedo.idx); texIt != textureByBgfx.end())
+        {
+            material->albedoTexture = texIt->second;
+        }
+        entry->materials.push_back(std::move(material));
     }
     meshPtr->materials = entry->materials;
-
-    m_meshCache[normalized] = entry;
-    LogCacheMiss(CacheType::Mesh, normalized);
     return entry;
 }
 
-std::shared_ptr<Material> ResourceManager::GetDefaultMaterial() const
+Material* ResourceManager::GetMaterial(MaterialHandle handle) const
+{
+    const MaterialEntry* entry = m_materials.Get(handle);
+    return entry ? entry->material.get() : nullptr;
+}
+
+Mesh* ResourceManager::GetMesh(MeshHandle handle) const
+{
+    const MeshEntry* entry = m_meshes.Get(handle);
+    return entry ? entry->mesh.get() : nullptr;
+}
+
+bgfx::TextureHandle ResourceManager::ResolveAlbedo(const Material& material) const
 {
-    if (!m_defaultMaterial)
+    if (!material.albedoTexture.IsValid())
     {
-        return nullptr;
+        return material.albedo;
+    }
+    if (const TextureResource* tex = m_textures.Get(material.albedoTexture))
+    {
+        return tex->handle;
     }
-    return m_defaultMaterial->material;
+    // Handle caducado: 'albedo' puede ser una textura ya destruida
+    return m_checkerTexture ? m_checkerTexture->handle : bgfx::TextureHandle{bgfx::kInvalidHandle};
+}
+
+std::shared_ptr<Material> ResourceManager::GetDefaultMaterial() const
+{
+    const MaterialEntry* entry = m_materials.Get(m_defaultMaterial);
+    return entry ? entry->material : nullptr;
 }
 
 void ResourceManager::PrintStats() const
 {
     size_t texMem = 0;
-    for (const auto& [_, tex] : m_textureCache)
-    {
-        if (tex)
-        {
-            texMem += tex->approxBytes;
-        }
-    }
+    m_textures.ForEach([&texMem](const TextureResource& tex) { texMem += tex.approxBytes; });
     size_t matMem = 0;
-    for (const auto& [_, mat] : m_materialCache)
-    {
-        if (mat)
-        {
-            matMem += mat->approxBytes;
-        }
-    }
+    m_materials.ForEach([&matMem](const MaterialEntry& mat) { matMem += mat.approxBytes; });
     size_t meshMem = 0;
-    for (const auto& [_, mesh] : m_meshCache)
-    {
-        if (mesh)
-        {
-            meshMem += mesh->approxBytes;
-        }
-    }
-
     size_t meshMaterialCount = 0;
-    for (const auto& [_, mesh] : m_meshCache)
+    m_meshes.ForEach([&](const MeshEntry& mesh)
     {
-        if (mesh)
-        {
-            meshMaterialCount += mesh->materials.size();
-        }
-    }
+        meshMem += mesh.approxBytes;
+        meshMaterialCount += mesh.materials.size();
+    });
 
     std::printf("[RES] ===== Resource Stats =====\n");
     std::printf("[RES] Textures: %zu | Approx GPU bytes: %zu | HITs: %zu | MISS: %zu\n",
@@ -419,28 +471,74 @@ bool ResourceManager::Reload(const std::string& relativePath)
     std::filesystem::path path(normalized);
     std::string ext = path.extension().string();
     std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c){ return std::tolower(c); });
+    const std::string absolute = BuildAbsolutePath(normalized);
 
     if (ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".tga" || ext == ".bmp" || ext == ".dds")
     {
-        m_textureCache.erase(normalized);
-        LoadTexture(normalized);
+        auto it = m_textureCache.find(normalized);
+        if (it == m_textureCache.end())
+        {
+            LoadTexture(normalized);
+            return true;
+        }
+        auto tex = ReadTexture(normalized, absolute);
+        if (!tex)
+        {
+            std::printf("[TEX] Recarga fallida, se conserva la versión anterior: %s\n", normalized.c_str());
+            return false;
+        }
+        m_textures.Replace(it->second, tex);
+        if (it->second == m_checkerHandle)
+        {
+            m_checkerTexture = tex;
+        }
         return true;
     }
     if (ext == ".mtl")
     {
-        m_materialCache.erase(normalized);
-        LoadMaterial(normalized);
+        auto it = m_materialCache.find(normalized);
+        if (it == m_materialCache.end())
+        {
+            LoadMaterial(normalized);
+            return true;
+        }
+        auto entry = ReadMaterialFile(normalized, absolute);
+        if (!entry)
+        {
+            std::printf("[MTL] Recarga fallida, se conserva la versión anterior: %s\n", normalized.c_str());
+            return false;
+        }
+        m_materials.Replace(it->second, entry);
         return true;
     }
     if (ext == ".obj")
     {
-        m_meshCache.erase(normalized);
-        LoadMesh(normalized);
+        auto it = m_meshCache.find(normalized);
+        if (it == m_meshCache.end())
+        {
+            LoadMesh(normalized);
+            return true;
+        }
+        auto entry = ReadMesh(normalized, absolute);
+        if (!entry)
+        {
+            std::printf("[MESH] Recarga fallida, se conserva la versión anterior: %s\n", normalized.c_str());
+            return false;
+        }
+        m_meshes.Replace(it->second, entry);
         return true;
     }
     return false;
 }
 
+bool ResourceManager::IsLoaded(const std::string& relativePath) const
+{
+    const std::string normalized = NormalizePath(relativePath);
+    return m_textureCache.count(normalized) > 0
+        || m_materialCache.count(normalized) > 0
+        || m_meshCache.count(normalized) > 0;
+}
+
 std::string ResourceManager::NormalizePath(const std::string& relativePath) const
 {
     if (relativePath.empty())
@@ -473,13 +571,13 @@ std::string ResourceManager::BuildAbsolutePath(const std::string& normalizedRela
     return full.string();
 }
 
-std::shared_ptr<TextureResource> ResourceManager::LoadTextureInternal(const std::string& normalizedRelative,
-                                                                      const std::string& absolutePath,
-                                                                      bool logHitMiss)
+TextureHandle ResourceManager::LoadTextureInternal(const std::string& normalizedRelative,
+                                                   const std::string& absolutePath,
+                                                   bool logHitMiss)
 {
     if (normalizedRelative.empty())
     {
-        return m_checkerTexture;
+        return m_checkerHandle;
     }
 
     auto it = m_textureCache.find(normalizedRelative);
@@ -492,18 +590,24 @@ std::shared_ptr<TextureResource> ResourceManager::LoadTextureInternal(const std:
         return it->second;
     }
 
+    // Si falla se guarda el checker en su slot; un Reload posterior lo cambia
+    auto tex = ReadTexture(normalizedRelative, absolutePath);
+    const TextureHandle handle = m_textures.Add(tex ? tex : m_checkerTexture);
+    m_textureCache[normalizedRelative] = handle;
+    if (logHitMiss)
+    {
+        LogCacheMiss(CacheType::Texture, normalizedRelative);
+    }
+    return handle;
+}
+
+std::shared_ptr<TextureResource> ResourceManager::ReadTexture(const std::string& normalizedRelative,
+                                                              const std::string& absolutePath) const
+{
     TextureLoadResult data = LoadTextureFromFile(absolutePath);
     if (!bgfx::isValid(data.handle))
     {
-        if (logHitMiss)
-        {
-            LogCacheMiss(CacheType::Texture, normalizedRelative);
-        }
-        if (m_checkerTexture)
-        {
-            m_textureCache[normalizedRelative] = m_checkerTexture;
-        }
-        return m_checkerTexture;
+        return nullptr;
     }
 
     auto tex = std::make_shared<TextureResource>();
@@ -512,11 +616,6 @@ std::shared_ptr<TextureResource> ResourceManager::LoadTextureInternal(const std:
     tex->height = data.height;
     tex->approxBytes = data.approxBytes;
     tex->source = normalizedRelative;
-    m_textureCache[normalizedRelative] = tex;
-    if (logHitMiss)
-    {
-        LogCacheMiss(CacheType::Texture, normalizedRelative);
-    }
     return tex;
 }
 
@@ -554,6 +653,7 @@ std::shared_ptr<Material> ResourceManager::CreateDefaultMaterial()
     mat.baseTint[0] = mat.baseTint[1] = mat.baseTint[2] = 1.0f;
     mat.baseTint[3] = 1.0f;
     mat.albedo = m_checkerTexture ? m_checkerTexture->handle : bgfx::TextureHandle{bgfx::kInvalidHandle};
+    mat.albedoTexture = m_checkerHandle;
     mat.ownsTexture = false;
     mat.specParams[0] = 32.0f;
     mat.specParams[1] = 0.35f;
@@ -566,33 +666,37 @@ void ResourceManager::EnsureDefaultResources()
     {
         m_checkerTexture = CreateProceduralChecker();
     }
+    if (!m_checkerHandle.IsValid())
+    {
+        m_checkerHandle = m_textures.Add(m_checkerTexture);
+    }
 
+    // textures/checker.png sustituye al procedural si existe; comparte slot
+    // con él para que recargarlo actualice todos los fallbacks.
     const std::string checkerRel = NormalizePath("textures/checker.png");
     if (m_textureCache.find(checkerRel) == m_textureCache.end())
     {
-        m_textureCache[checkerRel] = m_checkerTexture;
-    }
+        m_textureCache[checkerRel] = m_checkerHandle;
 
-    std::filesystem::path checkerAbs(BuildAbsolutePath(checkerRel));
-    if (std::filesystem::exists(checkerAbs))
-    {
-        auto tex = LoadTextureInternal(checkerRel, checkerAbs.string(), false);
-        if (tex)
+        std::filesystem::path checkerAbs(BuildAbsolutePath(checkerRel));
+        if (std::filesystem::exists(checkerAbs))
         {
-            m_checkerTexture = tex;
+            if (auto tex = ReadTexture(checkerRel, checkerAbs.string()))
+            {
+                m_checkerTexture = tex;
+                m_textures.Replace(m_checkerHandle, tex);
+            }
         }
     }
 
-    if (!m_defaultMaterial)
+    if (!m_defaultMaterial.IsValid())
     {
-        auto matPtr = CreateDefaultMaterial();
         auto entry = std::make_shared<MaterialEntry>();
-        entry->material = matPtr;
-        entry->albedoTexture = m_checkerTexture;
+        entry->material = CreateDefaultMaterial();
         entry->approxBytes = sizeof(Material);
         entry->source = "default";
-        m_defaultMaterial = entry;
-        m_materialCache["__default__"] = entry;
+        m_defaultMaterial = m_materials.Add(entry);
+        m_materialCache["__default__"] = m_defaultMaterial;
     }
 }
 
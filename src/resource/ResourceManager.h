@@ -10,6 +10,7 @@
 
 #include "../asset/Mesh.h"
 #include "../render/Material.h"
+#include "ResourceHandle.h"
 
 namespace resource
 {
@@ -27,7 +28,6 @@ struct TextureResource
 struct MaterialEntry
 {
     std::shared_ptr<Material> material;
-    std::shared_ptr<TextureResource> albedoTexture;
     size_t approxBytes = 0;
     std::string source;
 };
@@ -40,6 +40,11 @@ struct MeshEntry
     std::string source;
 };
 
+// Cachés por ruta relativa a assets. Los Load* devuelven handles estables:
+// Reload() sustituye el recurso dentro de su slot y todos los handles pasan a
+// ver la versión nueva sin recargar la escena. Una ruta que no existe recibe
+// igualmente un handle (con el recurso por defecto) para que aparezca al
+// crear el fichero.
 class ResourceManager
 {
 public:
@@ -49,29 +54,49 @@ public:
     bool Initialize();
     void Shutdown();
 
-    std::shared_ptr<TextureResource> LoadTexture(const std::string& relativePath);
-    std::shared_ptr<Material> LoadMaterial(const std::string& relativePath);
-    std::shared_ptr<MeshEntry> LoadMesh(const std::string& relativePath);
+    TextureHandle LoadTexture(const std::string& relativePath);
+    MaterialHandle LoadMaterial(const std::string& relativePath);
+    MeshHandle LoadMesh(const std::string& relativePath);
+    // Material creado en código o por la escena. Volver a crearlo con la misma
+    // clave lo actualiza en su slot.
+    MaterialHandle CreateMaterial(const std::string& key, const Material& data);
+
+    // nullptr si el handle no es válido o ha caducado.
+    const TextureResource* GetTexture(TextureHandle handle) const { return m_textures.Get(handle); }
+    Material* GetMaterial(MaterialHandle handle) const;
+    Mesh* GetMesh(MeshHandle handle) const;
+    const MeshEntry* GetMeshEntry(MeshHandle handle) const { return m_meshes.Get(handle); }
+    // Handle de bgfx actual de 'material': su textura del gestor si la tiene
+    // y si no 'albedo'.
+    bgfx::TextureHandle ResolveAlbedo(const Material& material) const;
 
     std::shared_ptr<TextureResource> GetCheckerTexture() const { return m_checkerTexture; }
+    TextureHandle GetCheckerTextureHandle() const { return m_checkerHandle; }
     std::shared_ptr<Material> GetDefaultMaterial() const;
+    MaterialHandle GetDefaultMaterialHandle() const { return m_defaultMaterial; }
 
     void PrintStats() const;
+    // Vuelve a leer el asset y lo cambia en su slot. Si la nueva versión no se
+    // puede cargar se conserva la anterior.
     bool Reload(const std::string& relativePath);
+    // Acepta rutas relativas a assets o absolutas dentro de assets.
+    bool IsLoaded(const std::string& relativePath) const;
 
     const std::string& GetAssetsRoot() const { return m_assetsRoot; }
 
     enum class CacheType { Texture, Material, Mesh };
 
 private:
-    struct MeshCacheEntry;
-
     std::string NormalizePath(const std::string& relativePath) const;
     std::string BuildAbsolutePath(const std::string& normalizedRelative) const;
 
-    std::shared_ptr<TextureResource> LoadTextureInternal(const std::string& normalizedRelative,
-                                                         const std::string& absolutePath,
-                                                         bool logHitMiss = true);
+    TextureHandle LoadTextureInternal(const std::string& normalizedRelative,
+                                      const std::string& absolutePath,
+                                      bool logHitMiss = true);
+    std::shared_ptr<TextureResource> ReadTexture(const std::string& normalizedRelative,
+                                                 const std::string& absolutePath) const;
+    std::shared_ptr<MaterialEntry> ReadMaterialFile(const std::string& normalized, const std::string& absolute);
+    std::shared_ptr<MeshEntry> ReadMesh(const std::string& normalized, const std::string& absolute);
     std::shared_ptr<TextureResource> CreateProceduralChecker();
     std::shared_ptr<Material> CreateMaterialFromData(const Material& src,
                                                      const std::string& sourcePath);
@@ -87,12 +112,17 @@ private:
     bgfx::VertexLayout m_layout{};
     uint32_t m_vertexStride = 0;
 
-    std::unordered_map<std::string, std::shared_ptr<TextureResource>> m_textureCache;
-    std::unordered_map<std::string, std::shared_ptr<MaterialEntry>>  m_materialCache;
-    std::unordered_map<std::string, std::shared_ptr<MeshEntry>>       m_meshCache;
+    HandlePool<TextureResource, TextureHandle> m_textures;
+    HandlePool<MaterialEntry, MaterialHandle>  m_materials;
+    HandlePool<MeshEntry, MeshHandle>          m_meshes;
+
+    std::unordered_map<std::string, TextureHandle>  m_textureCache;
+    std::unordered_map<std::string, MaterialHandle> m_materialCache;
+    std::unordered_map<std::string, MeshHandle>     m_meshCache;
 
     std::shared_ptr<TextureResource> m_checkerTexture;
-    std::shared_ptr<MaterialEntry>   m_defaultMaterial;
+    TextureHandle                    m_checkerHandle;
+    MaterialHandle                   m_defaultMaterial;
 
     mutable size_t m_textureHits = 0;
     mutable size_t m_textureMiss = 0;
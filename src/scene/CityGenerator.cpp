@@ -0,0 +1,336 @@
+#include "CityGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+
+namespace
+{
+    // plane.obj mide 400x400 m; la escala lo lleva al tamaño pedido.
+    constexpr float kPlaneMeshSize = 400.0f;
+    // Misma escala que el personaje de demo.json.
+    constexpr float kPedestrianScale = 0.05f;
+    constexpr float kLampRadius = 0.15f;
+    constexpr float kLampHeight = 5.0f;
+    constexpr float kCrateHalfExtent = 0.5f;
+
+    constexpr uint32_t kLayerStatic = 1u;
+    constexpr uint32_t kLayerDynamic = 2u;
+    constexpr uint32_t kLayerTrigger = 4u;
+
+    // Escritura en streaming: con 1M de entidades montar el DOM de nlohmann
+    // costaría varios GB, así que cada entidad se emite como una línea.
+    class SceneWriter
+    {
+    public:
+        explicit SceneWriter(std::FILE* file)
+            : m_file(file)
+        {
+        }
+
+        void Raw(const char* text)
+        {
+            std::fputs(text, m_file);
+        }
+
+        void BeginEntity(const std::string& id, const std::string* parent)
+        {
+            std::fprintf(m_file, "%s\n    {\"id\": \"%s\"", m_entityCount == 0 ? "" : ",", id.c_str());
+            if (parent)
+            {
+                std::fprintf(m_file, ", \"parent\": \"%s\"", parent->c_str());
+            }
+            ++m_entityCount;
+        }
+
+        void Transform(float px, float py, float pz, float yawDeg, float sx, float sy, float sz)
+        {
+            std::fprintf(m_file,
+                         ", \"transform\": {\"position\": [%.3f, %.3f, %.3f], \"rotationEulerDeg\": [0, %.2f, 0], \"scale\": [%.4f, %.4f, %.4f]}",
+                         px, py, pz, yawDeg, sx, sy, sz);
+        }
+
+        void MeshRenderer(const char* mesh, const char* material)
+        {
+            if (material)
+            {
+                std::fprintf(m_file, ", \"meshRenderer\": {\"mesh\": \"%s\", \"materialOverrides\": {\"0\": \"%s\"}}", mesh, material);
+            }
+            else
+            {
+                std::fprintf(m_file, ", \"meshRenderer\": {\"mesh\": \"%s\"}", mesh);
+            }
+        }
+
+        void BoxCollider(float hx, float hy, float hz)
+        {
+            std::fprintf(m_file, ", \"collider\": {\"shape\": \"box\", \"size\": [%.3f, %.3f, %.3f]}", hx, hy, hz);
+        }
+
+        void CapsuleCollider(float radius, float height)
+        {
+            std::fprintf(m_file, ", \"collider\": {\"shape\": \"capsule\", \"radius\": %.3f, \"height\": %.3f}", radius, height);
+        }
+
+        void StaticBody()
+        {
+            std::fprintf(m_file, ", \"rigidBody\": {\"type\": \"static\", \"layer\": %u}", kLayerStatic);
+        }
+
+        void DynamicBody(float mass)
+        {
+            std::fprintf(m_file, ", \"rigidBody\": {\"type\": \"dynamic\", \"mass\": %.2f, \"layer\": %u}", mass, kLayerDynamic);
+        }
+
+        void Trigger(float hx, float hy, float hz)
+        {
+            std::fprintf(m_file,
+                         ", \"trigger\": {\"shape\": \"box\", \"size\": [%.3f, %.3f, %.3f], \"layer\": %u, \"mask\": %u}",
+                         hx, hy, hz, kLayerTrigger, kLayerDynamic);
+        }
+
+        void EndEntity()
+        {
+            std::fputc('}', m_file);
+        }
+
+        size_t GetEntityCount() const { return m_entityCount; }
+
+    private:
+        std::FILE* m_file = nullptr;
+        size_t     m_entityCount = 0;
+    };
+
+    const char* kResourcesJson =
+        "{\n"
+        "  \"resources\": {\n"
+        "    \"textures\": {\n"
+        "      \"ground_checker\": \"models/checker.png\",\n"
+        "      \"facade\": \"textures/checker_y.png\",\n"
+        "      \"roof\": \"textures/checker_z.png\",\n"
+        "      \"wood\": \"textures/madera.png\"\n"
+        "    },\n"
+        "    \"materials\": {\n"
+        "      \"mat_ground\": {\"albedoTex\": \"ground_checker\", \"baseTint\": [0.6, 0.6, 0.6, 1.0], \"uv\": [4.0, 4.0]},\n"
+        "      \"mat_facade\": {\"albedoTex\": \"facade\", \"baseTint\": [1.0, 1.0, 1.0, 1.0], \"uv\": [2.0, 2.0]},\n"
+        "      \"mat_roof\": {\"albedoTex\": \"roof\", \"baseTint\": [0.8, 0.8, 0.8, 1.0], \"uv\": [1.0, 1.0]},\n"
+        "      \"mat_crate\": {\"albedoTex\": \"wood\", \"baseTint\": [1.0, 1.0, 1.0, 1.0], \"uv\": [1.0, 1.0]},\n"
+        "      \"mat_lamp\": {\"baseTint\": [0.3, 0.3, 0.35, 1.0], \"uv\": [1.0, 1.0]}\n"
+        "    },\n"
+        "    \"meshes\": {\n"
+        "      \"tile\": {\"obj\": \"models/plane.obj\", \"mtl\": \"models/plane.mtl\"},\n"
+        "      \"pedestrian\": {\"obj\": \"models/demo.obj\", \"mtl\": \"models/cj.mtl\"}\n"
+        "    }\n"
+        "  },\n"
+        "  \"entities\": [";
+}
+
+size_t CountCityEntitiesPerBlock(const CityGeneratorSettings& settings)
+{
+    const size_t lots = static_cast<size_t>(std::max(0, settings.buildingsPerSide) * std::max(0, settings.buildingsPerSide));
+    const size_t floors = static_cast<size_t>(std::max(0, settings.floorsPerBuilding));
+    const size_t triggers = settings.physics ? static_cast<size_t>(std::max(0, settings.triggersPerBlock)) : 0;
+    // raíz + suelo + edificios con sus plantas + props + triggers
+    return 2 + lots * (1 + floors) + static_cast<size_t>(std::max(0, settings.propsPerBlock)) + triggers;
+}
+
+bool GenerateCityScene(const std::string& path,
+                       const CityGeneratorSettings& settings,
+                       CityGeneratorStats* stats,
+                       std::string* err)
+{
+    const size_t perBlock = CountCityEntitiesPerBlock(settings);
+
+    size_t blocks = 0;
+    int gridX = std::max(1, settings.blocksX);
+    int gridZ = std::max(1, settings.blocksZ);
+    if (settings.targetEntities > 0)
+    {
+        blocks = std::max<size_t>(1, (settings.targetEntities + perBlock - 1) / perBlock);
+        gridX = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(blocks)))));
+        gridZ = static_cast<int>((blocks + static_cast<size_t>(gridX) - 1) / static_cast<size_t>(gridX));
+    }
+    else
+    {
+        blocks = static_cast<size_t>(gridX) * static_cast<size_t>(gridZ);
+    }
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file)
+    {
+        if (err)
+        {
+            *err = "No se pudo abrir para escritura: " + path;
+        }
+        return false;
+    }
+
+    CityGeneratorStats result;
+    result.blocks = blocks;
+    result.gridX = gridX;
+    result.gridZ = gridZ;
+
+    std::mt19937 rng(settings.seed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    const float pitch = settings.blockSize + settings.streetWidth;
+    const int lotsPerSide = std::max(0, settings.buildingsPerSide);
+    const float lotSize = lotsPerSide > 0 ? settings.blockSize / static_cast<float>(lotsPerSide) : settings.blockSize;
+    const float halfBlock = settings.blockSize * 0.5f;
+
+    SceneWriter writer(file);
+    writer.Raw(kResourcesJson);
+
+    std::string blockId;
+    std::string buildingId;
+    std::string id;
+    for (size_t b = 0; b < blocks; ++b)
+    {
+        const int bx = static_cast<int>(b % static_cast<size_t>(gridX));
+        const int bz = static_cast<int>(b / static_cast<size_t>(gridX));
+        const float cx = static_cast<float>(bx) * pitch;
+        const float cz = static_cast<float>(bz) * pitch;
+
+        blockId = "b" + std::to_string(bx) + "_" + std::to_string(bz);
+        writer.BeginEntity(blockId, nullptr);
+        writer.Transform(0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f);
+        writer.EndEntity();
+
+        const float groundScale = settings.blockSize / kPlaneMeshSize;
+        writer.BeginEntity(blockId + "_g", &blockId);
+        writer.Transform(cx, 0.0f, cz, 0.0f, groundScale, 1.0f, groundScale);
+        writer.MeshRenderer("tile", "mat_ground");
+        writer.EndEntity();
+        ++result.meshRenderers;
+
+        // Edificios en una rejilla de parcelas; la altura de planta varía un poco
+        // para que no todas las manzanas sean idénticas.
+        for (int lot = 0; lot < lotsPerSide * lotsPerSide; ++lot)
+        {
+            const float lx = cx - halfBlock + (static_cast<float>(lot % lotsPerSide) + 0.5f) * lotSize;
+            const float lz = cz - halfBlock + (static_cast<float>(lot / lotsPerSide) + 0.5f) * lotSize;
+            const float footprint = lotSize * (0.55f + 0.3f * unit(rng));
+            const float floorHeight = settings.floorHeight * (0.85f + 0.3f * unit(rng));
+            const float height = floorHeight * static_cast<float>(std::max(1, settings.floorsPerBuilding));
+
+            buildingId = blockId + "_h" + std::to_string(lot);
+            writer.BeginEntity(buildingId, &blockId);
+            writer.Transform(lx, height * 0.5f, lz, 0.0f, 1.0f, 1.0f, 1.0f);
+            if (settings.physics)
+            {
+                writer.BoxCollider(footprint * 0.5f, height * 0.5f, footprint * 0.5f);
+                writer.StaticBody();
+                ++result.staticBodies;
+            }
+            writer.EndEntity();
+            ++result.buildings;
+
+            // Las plantas son hijas del edificio: offset local en Y respecto al
+            // centro del collider.
+            const float floorScale = footprint / kPlaneMeshSize;
+            for (int f = 0; f < settings.floorsPerBuilding; ++f)
+            {
+                const bool roof = f + 1 == settings.floorsPerBuilding;
+                id = buildingId + "_f" + std::to_string(f);
+                writer.BeginEntity(id, &buildingId);
+                writer.Transform(0.0f, static_cast<float>(f + 1) * floorHeight - height * 0.5f, 0.0f, 0.0f, floorScale, 1.0f, floorScale);
+                writer.MeshRenderer("tile", roof ? "mat_roof" : "mat_facade");
+                writer.EndEntity();
+                ++result.meshRenderers;
+            }
+        }
+
+        // Props repartidos por la acera perimetral de la manzana.
+        for (int p = 0; p < settings.propsPerBlock; ++p)
+        {
+            const float t = unit(rng) * 4.0f;
+            const int side = std::min(3, static_cast<int>(t));
+            const float along = (t - static_cast<float>(side)) * settings.blockSize - halfBlock;
+            const float edge = halfBlock + settings.streetWidth * 0.2f;
+            float px = cx;
+            float pz = cz;
+            switch (side)
+            {
+            case 0: px += along; pz -= edge; break;
+            case 1: px += edge;  pz += along; break;
+            case 2: px -= along; pz += edge; break;
+            default: px -= edge; pz -= along; break;
+            }
+            const float yaw = unit(rng) * 360.0f;
+
+            id = blockId + "_p" + std::to_string(p);
+            writer.BeginEntity(id, &blockId);
+            if (settings.physics && unit(rng) < settings.dynamicPropFraction)
+            {
+                const float crateScale = (kCrateHalfExtent * 2.0f) / kPlaneMeshSize;
+                writer.Transform(px, kCrateHalfExtent + 0.05f, pz, yaw, crateScale, 1.0f, crateScale);
+                writer.MeshRenderer("tile", "mat_crate");
+                writer.BoxCollider(kCrateHalfExtent, kCrateHalfExtent, kCrateHalfExtent);
+                writer.DynamicBody(10.0f);
+                ++result.dynamicBodies;
+            }
+            else if (p % 3 == 0)
+            {
+                const float lampScale = (kLampRadius * 2.0f) / kPlaneMeshSize;
+                writer.Transform(px, kLampHeight * 0.5f, pz, 0.0f, lampScale, 1.0f, lampScale);
+                writer.MeshRenderer("tile", "mat_lamp");
+                if (settings.physics)
+                {
+                    writer.CapsuleCollider(kLampRadius, kLampHeight);
+                    writer.StaticBody();
+                    ++result.staticBodies;
+                }
+            }
+            else
+            {
+                writer.Transform(px, 0.0f, pz, yaw, kPedestrianScale, kPedestrianScale, kPedestrianScale);
+                writer.MeshRenderer("pedestrian", nullptr);
+            }
+            writer.EndEntity();
+            ++result.meshRenderers;
+        }
+
+        // Triggers en los cruces: el primero en la esquina (+x, +z) y el resto
+        // repartidos por la calle del lado +x.
+        if (settings.physics)
+        {
+            const float half = settings.streetWidth * 0.5f;
+            for (int t = 0; t < settings.triggersPerBlock; ++t)
+            {
+                const float offset = settings.triggersPerBlock > 1
+                    ? static_cast<float>(t) / static_cast<float>(settings.triggersPerBlock) * settings.blockSize
+                    : 0.0f;
+                id = blockId + "_z" + std::to_string(t);
+                writer.BeginEntity(id, &blockId);
+                writer.Transform(cx + halfBlock + half, 2.0f, cz + halfBlock + half - offset, 0.0f, 1.0f, 1.0f, 1.0f);
+                writer.Trigger(half, 2.0f, half);
+                writer.EndEntity();
+                ++result.triggers;
+            }
+        }
+    }
+
+    writer.Raw("\n  ]\n}\n");
+    result.entities = writer.GetEntityCount();
+
+    const bool ok = std::ferror(file) == 0;
+    const long size = std::ftell(file);
+    std::fclose(file);
+    if (!ok)
+    {
+        if (err)
+        {
+            *err = "Error de escritura en " + path;
+        }
+        return false;
+    }
+
+    result.fileBytes = size > 0 ? static_cast<size_t>(size) : 0;
+    if (stats)
+    {
+        *stats = result;
+    }
+    return true;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Generador procedural de ciudades en el formato de LoadSceneFromJson.
+// Se usa desde la herramienta SandboxCityGen y desde SandboxCityBench como
+// carga de trabajo estándar (carga, memoria, culling, físicas).
+//
+// Cada manzana es una raíz en el origen con:
+//   - una losa de suelo,
+//   - N edificios (Collider + RigidBody estático) con M plantas hijas,
+//   - props: farolas estáticas, cajas dinámicas y peatones sin física,
+//   - un trigger en el cruce.
+// Bullet toma Transform::position como pose de mundo, así que todo lo que
+// lleva físicas cuelga de la raíz de la manzana (identidad) y no de otro nodo.
+struct CityGeneratorSettings
+{
+    // Si > 0 se calcula la rejilla para acercarse a ese número de entidades
+    // y se ignoran blocksX/blocksZ.
+    size_t   targetEntities = 0;
+    int      blocksX = 8;
+    int      blocksZ = 8;
+    float    blockSize = 40.0f;   // lado de la manzana (m)
+    float    streetWidth = 12.0f; // separación entre manzanas (m)
+    int      buildingsPerSide = 2; // edificios por manzana = buildingsPerSide^2
+    int      floorsPerBuilding = 4;
+    float    floorHeight = 3.5f;
+    int      propsPerBlock = 12;
+    float    dynamicPropFraction = 0.25f; // fracción de props que son cajas dinámicas
+    int      triggersPerBlock = 1;
+    bool     physics = true;       // false = sin Collider/RigidBody/trigger
+    uint32_t seed = 1337u;
+};
+
+struct CityGeneratorStats
+{
+    size_t entities = 0;
+    size_t blocks = 0; // manzanas colocadas; puede ser menor que gridX * gridZ
+    size_t buildings = 0;
+    size_t meshRenderers = 0;
+    size_t staticBodies = 0;
+    size_t dynamicBodies = 0;
+    size_t triggers = 0;
+    size_t fileBytes = 0;
+    int    gridX = 0;
+    int    gridZ = 0;
+};
+
+// Entidades que aporta cada manzana con estos ajustes.
+size_t CountCityEntitiesPerBlock(const CityGeneratorSettings& settings);
+
+bool GenerateCityScene(const std::string& path,
+                       const CityGeneratorSettings& settings,
+                       CityGeneratorStats* stats = nullptr,
+                       std::string* err = nullptr);
@@ -0,0 +1,270 @@
+#include "SceneDiff.h"
+
+#include "../ecs/Scene.h"
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+using KeyByEntity = std::unordered_map<EntityId, std::string>;
+
+bool IsAutoKey(const std::string& key)
+{
+    return key.rfind("__entity_", 0) == 0;
+}
+
+// Un id lógico por entidad: mejor uno explícito (name/id) que "__entity_N",
+// y entre varios el menor para que la elección sea estable.
+KeyByEntity BuildKeyByEntity(const Scene& scene)
+{
+    KeyByEntity keys;
+    for (const auto& [key, entity] : scene.GetLogicalLookup())
+    {
+        auto [it, inserted] = keys.emplace(entity, key);
+        if (inserted)
+        {
+            continue;
+        }
+        const bool candidateAuto = IsAutoKey(key);
+        const bool currentAuto = IsAutoKey(it->second);
+        if (candidateAuto != currentAuto ? !candidateAuto : key < it->second)
+        {
+            it->second = key;
+        }
+    }
+    return keys;
+}
+
+std::string ParentKey(const Scene& scene, EntityId entity, const KeyByEntity& keys)
+{
+    const EntityId parent = scene.GetParent(entity);
+    auto it = keys.find(parent);
+    return it != keys.end() ? it->second : std::string{};
+}
+
+bool Same(const float3& a, const float3& b)
+{
+    return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+// Sólo los campos que vienen del JSON; matrices y flags dirty no cuentan.
+bool SameAuthored(const Transform& a, const Transform& b)
+{
+    return Same(a.position, b.position) && math::Equal(a.rotation, b.rotation) && Same(a.scale, b.scale);
+}
+
+bool SameAuthored(const MeshRenderer& a, const MeshRenderer& b)
+{
+    return a.mesh == b.mesh && a.material == b.material && a.materialOverrides == b.materialOverrides;
+}
+
+bool SameAuthored(const Collider& a, const Collider& b)
+{
+    return a.shape == b.shape && Same(a.size, b.size);
+}
+
+bool SameAuthored(const RigidBody& a, const RigidBody& b)
+{
+    return a.type == b.type && a.mass == b.mass && a.friction == b.friction && a.restitution == b.restitution
+        && a.layer == b.layer && a.mask == b.mask;
+}
+
+bool SameAuthored(const TriggerVolume& a, const TriggerVolume& b)
+{
+    return a.shape == b.shape && Same(a.size, b.size) && a.layer == b.layer && a.mask == b.mask
+        && a.oneShot == b.oneShot && a.active == b.active;
+}
+
+void MarkChanged(Scene& live, EntityId entity, Transform& transform)
+{
+    transform.MarkDirty();
+    live.MarkHierarchyDirty(entity);
+}
+
+void MarkChanged(Scene&, EntityId, MeshRenderer&)
+{
+}
+
+template<typename T>
+void MarkChanged(Scene&, EntityId, T& component)
+{
+    // Collider/RigidBody/TriggerVolume: las físicas reconstruyen el runtime
+    component.dirty = true;
+}
+
+template<typename T>
+struct ComponentAccess
+{
+    const T* (Scene::*get)(EntityId) const;
+    T*       (Scene::*add)(EntityId);
+    void     (Scene::*remove)(EntityId);
+};
+
+// Devuelve true si el componente ha cambiado en el JSON y se ha aplicado.
+template<typename T>
+bool SyncComponent(const ComponentAccess<T>& access,
+                   const Scene& previous, EntityId previousId,
+                   const Scene& next, EntityId nextId,
+                   Scene& live, EntityId liveId)
+{
+    const T* before = previousId != kInvalidEntity ? (previous.*access.get)(previousId) : nullptr;
+    const T* after = (next.*access.get)(nextId);
+    if (!before && !after)
+    {
+        return false;
+    }
+    if (before && after && SameAuthored(*before, *after))
+    {
+        return false;
+    }
+
+    if (!after)
+    {
+        (live.*access.remove)(liveId);
+        return true;
+    }
+    if (T* component = (live.*access.add)(liveId))
+    {
+        *component = *after;
+        MarkChanged(live, liveId, *component);
+    }
+    return true;
+}
+
+const ComponentAccess<Transform>     kTransformAccess{&Scene::GetTransform, &Scene::AddTransform, &Scene::RemoveTransform};
+const ComponentAccess<MeshRenderer>  kMeshRendererAccess{&Scene::GetMeshRenderer, &Scene::AddMeshRenderer, &Scene::RemoveMeshRenderer};
+const ComponentAccess<Collider>      kColliderAccess{&Scene::GetCollider, &Scene::AddCollider, &Scene::RemoveCollider};
+const ComponentAccess<RigidBody>     kRigidBodyAccess{&Scene::GetRigidBody, &Scene::AddRigidBody, &Scene::RemoveRigidBody};
+const ComponentAccess<TriggerVolume> kTriggerAccess{&Scene::GetTriggerVolume, &Scene::AddTriggerVolume, &Scene::RemoveTriggerVolume};
+
+struct EntityMatch
+{
+    EntityId           nextId = kInvalidEntity;
+    EntityId           previousId = kInvalidEntity; // inválido si es nueva
+    EntityId           liveId = kInvalidEntity;
+    const std::string* key = nullptr;
+    bool               added = false;
+    bool               changed = false;
+};
+}
+
+SceneDiffStats ApplySceneDiff(const Scene& previous, const Scene& next, Scene& live)
+{
+    SceneDiffStats stats;
+    const KeyByEntity previousKeys = BuildKeyByEntity(previous);
+    const KeyByEntity nextKeys = BuildKeyByEntity(next);
+
+    // En orden de carga (ids crecientes) para que las altas sean deterministas
+    std::vector<EntityMatch> matches;
+    matches.reserve(nextKeys.size());
+    for (const auto& [nextId, key] : nextKeys)
+    {
+        EntityMatch match;
+        match.nextId = nextId;
+        match.key = &key;
+        matches.push_back(match);
+    }
+    std::sort(matches.begin(), matches.end(), [](const EntityMatch& a, const EntityMatch& b) { return a.nextId < b.nextId; });
+
+    std::unordered_map<EntityId, EntityId> liveByNext;
+    std::unordered_set<EntityId> keptLive;
+    liveByNext.reserve(matches.size());
+    keptLive.reserve(matches.size());
+
+    // 1) Altas y componentes
+    for (EntityMatch& match : matches)
+    {
+        match.previousId = previous.FindEntityByLogicalId(*match.key);
+        match.liveId = live.FindEntityByLogicalId(*match.key);
+        if (match.liveId == kInvalidEntity || !live.IsAlive(match.liveId) || keptLive.count(match.liveId) > 0)
+        {
+            match.liveId = live.CreateEntity();
+            match.previousId = kInvalidEntity;
+            match.added = true;
+        }
+        liveByNext[match.nextId] = match.liveId;
+        keptLive.insert(match.liveId);
+
+        bool changed = false;
+        changed |= SyncComponent(kTransformAccess, previous, match.previousId, next, match.nextId, live, match.liveId);
+        changed |= SyncComponent(kMeshRendererAccess, previous, match.previousId, next, match.nextId, live, match.liveId);
+        changed |= SyncComponent(kColliderAccess, previous, match.previousId, next, match.nextId, live, match.liveId);
+        changed |= SyncComponent(kRigidBodyAccess, previous, match.previousId, next, match.nextId, live, match.liveId);
+        changed |= SyncComponent(kTriggerAccess, previous, match.previousId, next, match.nextId, live, match.liveId);
+        match.changed = changed;
+    }
+
+    // 2) Jerarquía, cuando ya existen todas las entidades
+    for (EntityMatch& match : matches)
+    {
+        const std::string nextParent = ParentKey(next, match.nextId, nextKeys);
+        const std::string previousParent = match.added ? std::string{} : ParentKey(previous, match.previousId, previousKeys);
+        if (!match.added && nextParent == previousParent)
+        {
+            continue;
+        }
+
+        EntityId liveParent = kInvalidEntity;
+        if (auto it = liveByNext.find(next.GetParent(match.nextId)); it != liveByNext.end())
+        {
+            liveParent = it->second;
+        }
+        live.SetParent(match.liveId, liveParent);
+        match.changed = true;
+    }
+
+    for (const EntityMatch& match : matches)
+    {
+        if (match.added)
+        {
+            ++stats.added;
+        }
+        else if (match.changed)
+        {
+            ++stats.changed;
+        }
+        else
+        {
+            ++stats.unchanged;
+        }
+    }
+
+    // 3) Bajas: entidades de la carga anterior que ya no están en el JSON
+    for (const auto& [previousId, key] : previousKeys)
+    {
+        if (next.FindEntityByLogicalId(key) != kInvalidEntity)
+        {
+            continue;
+        }
+        const EntityId liveId = live.FindEntityByLogicalId(key);
+        if (liveId != kInvalidEntity && live.IsAlive(liveId) && keptLive.count(liveId) == 0)
+        {
+            live.DestroyEntity(liveId);
+            ++stats.removed;
+        }
+    }
+    // DestroyEntity ya borra las claves de lo destruido; quedan las que
+    // desaparecen del JSON en entidades que se conservan con otra clave
+    for (const auto& [key, previousId] : previous.GetLogicalLookup())
+    {
+        if (next.FindEntityByLogicalId(key) == kInvalidEntity)
+        {
+            live.RemoveLogicalId(key);
+        }
+    }
+
+    // Se actualizan sólo las claves del JSON: las registradas en ejecución
+    // (p. ej. el personaje del jugador) se conservan.
+    for (const auto& [key, nextId] : next.GetLogicalLookup())
+    {
+        if (auto it = liveByNext.find(nextId); it != liveByNext.end())
+        {
+            live.SetLogicalId(key, it->second);
+        }
+    }
+    return stats;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+
+class Scene;
+
+struct SceneDiffStats
+{
+    size_t added = 0;
+    size_t removed = 0;
+    size_t changed = 0;   // entidades con algún componente o padre distinto
+    size_t unchanged = 0;
+};
+
+// Recarga incremental. 'previous' y 'next' son dos cargas del JSON de la
+// escena (la anterior y la actual); lo que difiere entre ellas se aplica a
+// 'live', que es la escena en ejecución. Las entidades se emparejan por sus
+// ids lógicos (Scene::GetLogicalLookup).
+//  - Sólo se tocan los componentes que cambian en el JSON, así que la pose
+//    simulada y los runtimes de físicas de lo demás se conservan.
+//  - PhysicsCharacter no viene del JSON y no se toca salvo al destruir.
+//  - Las entidades nuevas se crean antes de destruir las eliminadas para que
+//    no reciban un id recién liberado en la misma recarga.
+SceneDiffStats ApplySceneDiff(const Scene& previous, const Scene& next, Scene& live);
@@ -27,9 +27,10 @@ struct LoadContext
 {
     Scene& scene;
     resource::ResourceManager& resources;
-    std::unordered_map<std::string, std::shared_ptr<resource::TextureResource>> textures;
-    std::unordered_map<std::string, std::shared_ptr<Material>> materials;
-    std::unordered_map<std::string, std::shared_ptr<resource::MeshEntry>> meshes;
+    std::unordered_map<std::string, resource::TextureHandle> textures;
+    std::unordered_map<std::string, resource::MaterialHandle> materials;
+    std::unordered_map<std::string, resource::MeshHandle> meshes;
+    std::string materialKeyPrefix; // clave de los materiales de la escena en el ResourceManager
     std::unordered_map<std::string, EntityId> entityLookup;
     std::vector<std::pair<EntityId, std::string>> pendingParentRefs;
     size_t autoNameCounter = 0;
@@ -312,12 +313,12 @@ static void LoadTexturesFromJson(const json& texturesJson, LoadContext& ctx)
             continue;
         }
         const std::string relPath = it.value().get<std::string>();
-        auto tex = ctx.resources.LoadTexture(relPath);
-        if (!tex)
+        resource::TextureHandle tex = ctx.resources.LoadTexture(relPath);
+        if (!ctx.resources.GetTexture(tex))
         {
             std::printf("[SceneLoader] No se pudo cargar textura '%s' (%s), usando checker.\n",
                         texId.c_str(), relPath.c_str());
-            tex = ctx.resources.GetCheckerTexture();
+            tex = ctx.resources.GetCheckerTextureHandle();
         }
         ctx.textures[texId] = tex;
     }
@@ -335,9 +336,9 @@ static void LoadMaterialsFromJson(const json& materialsJson, LoadContext& ctx)
         }
 
         const json& matJson = it.value();
-        auto material = std::make_shared<Material>();
-        material->reset();
-        material->ownsTexture = false;
+        Material material;
+        material.reset();
+        material.ownsTexture = false;
 
         if (auto tintIt = matJson.find("baseTint"); tintIt != matJson.end() && tintIt->is_array())
         {
@@ -345,7 +346,7 @@ static void LoadMaterialsFromJson(const json& materialsJson, LoadContext& ctx)
             {
                 if ((*tintIt)[i].is_number_float() || (*tintIt)[i].is_number_integer())
                 {
-                    material->baseTint[i] = (*tintIt)[i].get<float>();
+                    material.baseTint[i] = (*tintIt)[i].get<float>();
                 }
             }
         }
@@ -356,12 +357,12 @@ static void LoadMaterialsFromJson(const json& materialsJson, LoadContext& ctx)
             {
                 if ((*uvIt)[i].is_number_float() || (*uvIt)[i].is_number_integer())
                 {
-                    material->uvScale[i] = (*uvIt)[i].get<float>();
+                    material.uvScale[i] = (*uvIt)[i].get<float>();
                 }
             }
         }
 
-        std::shared_ptr<resource::TextureResource> texResource;
+        resource::TextureHandle texResource;
         if (auto texIt = matJson.find("albedoTex"); texIt != matJson.end() && texIt->is_string())
         {
             const std::string texId = texIt->get<std::string>();
@@ -377,21 +378,17 @@ static void LoadMaterialsFromJson(const json& materialsJson, LoadContext& ctx)
             }
         }
 
-        if (!texResource)
+        if (!texResource.IsValid())
         {
-            texResource = ctx.resources.GetCheckerTexture();
+            texResource = ctx.resources.GetCheckerTextureHandle();
         }
 
-        if (texResource && bgfx::isValid(texResource->handle))
-        {
-            material->albedo = texResource->handle;
-        }
-        else
-        {
-            material->albedo = bgfx::TextureHandle{bgfx::kInvalidHandle};
-        }
+        // La textura se resuelve por handle al dibujar; 'albedo' queda como
+        // copia del valor actual.
+        material.albedoTexture = texResource;
+        material.albedo = ctx.resources.ResolveAlbedo(material);
 
-        ctx.materials[matId] = material;
+        ctx.materials[matId] = ctx.resources.CreateMaterial(ctx.materialKeyPrefix + matId, material);
     }
 }
 
@@ -414,8 +411,8 @@ static void LoadMeshesFromJson(const json& meshesJson, LoadContext& ctx)
             continue;
         }
 
-        auto meshEntry = ctx.resources.LoadMesh(objPath);
-        if (!meshEntry)
+        const resource::MeshHandle meshEntry = ctx.resources.LoadMesh(objPath);
+        if (!ctx.resources.GetMesh(meshEntry))
         {
             std::printf("[SceneLoader] Fallo al cargar OBJ '%s' para malla '%s'.\n",
                         objPath.c_str(), meshId.c_str());
@@ -458,7 +455,8 @@ static void ApplyTransformFromJson(const json& transformJson, Transform& transfo
     };
 
     const float defaultPos[3] = {transform.position.x, transform.position.y, transform.position.z};
-    const float defaultRot[3] = {transform.rotationEuler.x, transform.rotationEuler.y, transform.rotationEuler.z};
+    const float3 currentRot = math::QuatToEuler(transform.rotation);
+    const float defaultRot[3] = {currentRot.x, currentRot.y, currentRot.z};
     const float defaultScale[3] = {transform.scale.x, transform.scale.y, transform.scale.z};
 
     float pos[3];
@@ -487,9 +485,7 @@ static void ApplyTransformFromJson(const json& transformJson, Transform& transfo
 
     if (hasRotation)
     {
-        transform.rotationEuler.x = rot[0];
-        transform.rotationEuler.y = rot[1];
-        transform.rotationEuler.z = rot[2];
+        transform.rotation = math::QuatFromEuler(float3{rot[0], rot[1], rot[2]});
     }
 
     float scl[3];
@@ -521,7 +517,7 @@ static void ApplyMeshRendererFromJson(const json& mrJson,
     }
 
     auto meshIt = ctx.meshes.find(meshId);
-    if (meshIt == ctx.meshes.end() || !meshIt->second || !meshIt->second->mesh)
+    if (meshIt == ctx.meshes.end() || !ctx.resources.GetMesh(meshIt->second))
     {
         std::printf("[SceneLoader] Malla '%s' no encontrada para entidad '%s'.\n",
                     meshId.c_str(), entityLabel.c_str());
@@ -534,8 +530,8 @@ static void ApplyMeshRendererFromJson(const json& mrJson,
         return;
     }
 
-    renderer->mesh = meshIt->second->mesh;
-    renderer->material = ctx.resources.GetDefaultMaterial();
+    renderer->mesh = meshIt->second;
+    renderer->material = ctx.resources.GetDefaultMaterialHandle();
     renderer->materialOverrides.clear();
 
     if (auto overridesIt = mrJson.find("materialOverrides"); overridesIt != mrJson.end() && overridesIt->is_object())
@@ -562,7 +558,7 @@ static void ApplyMeshRendererFromJson(const json& mrJson,
 
             const std::string materialId = matIt.value().get<std::string>();
             auto materialLookup = ctx.materials.find(materialId);
-            std::shared_ptr<Material> materialPtr;
+            resource::MaterialHandle materialPtr;
             if (materialLookup != ctx.materials.end())
             {
                 materialPtr = materialLookup->second;
@@ -571,10 +567,10 @@ static void ApplyMeshRendererFromJson(const json& mrJson,
             {
                 std::printf("[SceneLoader] Material '%s' no encontrado para override en entidad '%s'.\n",
                             materialId.c_str(), entityLabel.c_str());
-                materialPtr = ctx.resources.GetDefaultMaterial();
+                materialPtr = ctx.resources.GetDefaultMaterialHandle();
             }
 
-            if (materialPtr)
+            if (materialPtr.IsValid())
             {
                 renderer->materialOverrides[submeshIndex] = materialPtr;
             }
@@ -687,6 +683,7 @@ bool LoadSceneFromJson(const std::string& path,
 
     Scene newScene;
     LoadContext ctx{newScene, resources};
+    ctx.materialKeyPrefix = "scene:" + resolved.lexically_normal().generic_string() + "#";
 
     if (auto resIt = data.find("resources"); resIt != data.end() && resIt->is_object())
     {
@@ -1,4 +1,5 @@
 #include "Window.h"
+#include <cstdio>
 #include <stdexcept>
 #include <GLFW/glfw3.h>
 #include <GLFW/glfw3native.h>  // requiere GLFW_EXPOSE_NATIVE_WIN32
@@ -22,6 +23,8 @@ Window::Window(const std::string& title, int width, int height)
     glfwSetWindowUserPointer(m_window, this);
     glfwSetFramebufferSizeCallback(m_window, FramebufferSizeCallback);
     glfwSetScrollCallback(m_window, ScrollCallback);
+    glfwSetKeyCallback(m_window, KeyCallback);
+    glfwSetMouseButtonCallback(m_window, MouseButtonCallback);
 
     // Inicializa delta de ratón
     glfwGetCursorPos(m_window, &m_lastX, &m_lastY);
@@ -97,4 +100,51 @@ void Window::ScrollCallback(GLFWwindow* win, double xoffset, double yoffset) {
     }
     self->m_scrollX += xoffset;
     self->m_scrollY += yoffset;
+
+    InputEvent evt;
+    evt.type = InputEvent::Type::Scroll;
+    evt.scrollX = static_cast<float>(xoffset);
+    evt.scrollY = static_cast<float>(yoffset);
+    evt.time = glfwGetTime();
+    self->PushInputEvent(evt);
+}
+
+void Window::KeyCallback(GLFWwindow* win, int key, int, int action, int) {
+    auto* self = reinterpret_cast<Window*>(glfwGetWindowUserPointer(win));
+    // GLFW_REPEAT no cambia el estado de la tecla
+    if (!self || key == GLFW_KEY_UNKNOWN || action == GLFW_REPEAT) {
+        return;
+    }
+
+    InputEvent evt;
+    evt.type = InputEvent::Type::Key;
+    evt.down = action == GLFW_PRESS;
+    evt.code = key;
+    evt.time = glfwGetTime();
+    self->PushInputEvent(evt);
+}
+
+void Window::MouseButtonCallback(GLFWwindow* win, int button, int action, int) {
+    auto* self = reinterpret_cast<Window*>(glfwGetWindowUserPointer(win));
+    if (!self) {
+        return;
+    }
+
+    InputEvent evt;
+    evt.type = InputEvent::Type::MouseButton;
+    evt.down = action == GLFW_PRESS;
+    evt.code = button;
+    evt.time = glfwGetTime();
+    self->PushInputEvent(evt);
+}
+
+void Window::PushInputEvent(const InputEvent& evt) {
+    if (!m_inputEvents.TryPush(evt)) {
+        // Nadie consume (o va muy por detrás): se pierde el evento
+        const uint64_t dropped = m_droppedInputEvents.fetch_add(1, std::memory_order_relaxed) + 1;
+        if ((dropped & (dropped - 1)) == 0) {
+            std::printf("[Window] Cola de eventos de entrada llena, %llu eventos descartados\n",
+                        static_cast<unsigned long long>(dropped));
+        }
+    }
 }
@@ -1,7 +1,11 @@
 #pragma once
 #include <string>
+#include <atomic>
 #include <cstdint>
 
+#include "../core/SpscQueue.h"
+#include "../input/InputEvent.h"
+
 struct GLFWwindow;
 
 class Window {
@@ -26,9 +30,17 @@ public:
     void  GetScrollDelta(float& sx, float& sy) const;  // acumulado desde último frame
     bool  IsCursorLocked() const { return m_cursorLocked; }
 
+    // Eventos de teclado/ratón en orden de llegada. Los callbacks de GLFW
+    // (dentro de PollEvents) son el productor; un único consumidor los saca.
+    bool     PopInputEvent(InputEvent& out) { return m_inputEvents.TryPop(out); }
+    uint64_t GetDroppedInputEvents() const { return m_droppedInputEvents.load(std::memory_order_relaxed); }
+
 private:
     static void FramebufferSizeCallback(GLFWwindow* win, int w, int h);
     static void ScrollCallback(GLFWwindow* win, double xoffset, double yoffset);
+    static void KeyCallback(GLFWwindow* win, int key, int scancode, int action, int mods);
+    static void MouseButtonCallback(GLFWwindow* win, int button, int action, int mods);
+    void PushInputEvent(const InputEvent& evt);
 
 private:
     GLFWwindow* m_window = nullptr;
@@ -40,4 +52,7 @@ private:
     mutable double m_dx = 0.0,  m_dy = 0.0;
     mutable double m_scrollX = 0.0, m_scrollY = 0.0;
     bool m_cursorLocked = false;
+
+    SpscQueue<InputEvent, 1024> m_inputEvents;
+    std::atomic<uint64_t>       m_droppedInputEvents{0};
 };